@@ -0,0 +1,166 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares parsing with AST nodes allocated one at a time from the heap
+// against parsing with parse_options_t::use_arena set. Reports the number of
+// heap allocations made per statement in each mode, how many AST nodes the
+// arena served, and the time taken to parse and then free the parse result
+// for the grammar test corpus and for a batch of multi-row INSERTs.
+
+#include <cstdlib>
+#include <new>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+// Count every heap allocation made by the process, including the ones made
+// inside the library
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+typedef struct mode_counts {
+    size_t statements;
+    size_t heap_allocations;
+    size_t arena_allocations;
+    size_t arena_blocks;
+} mode_counts_t;
+
+// Parses each input once, counting the statements found, heap allocations
+// made and, in arena mode, AST nodes carved from the arena
+mode_counts_t count_allocations(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts) {
+    mode_counts_t counts = {0, 0, 0, 0};
+    for (const std::string& input : inputs) {
+        size_t before = num_heap_allocations;
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        counts.heap_allocations += num_heap_allocations - before;
+        counts.statements += res.statements.size();
+        if (res.arena) {
+            counts.arena_allocations += res.arena->num_allocations;
+            counts.arena_blocks += res.arena->num_blocks();
+        }
+    }
+    return counts;
+}
+
+// Times parsing each input and destroying its parse result
+double time_parse_free(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts,
+        size_t iterations) {
+    return run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            clobber_memory();
+        }
+    });
+}
+
+void report_mode(const char* name, const mode_counts_t& counts) {
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(8)
+              << double(counts.heap_allocations) / counts.statements
+              << " heap allocations/statement";
+    if (counts.arena_allocations > 0)
+        std::cout << ", " << std::setw(6)
+                  << double(counts.arena_allocations) / counts.statements
+                  << " AST nodes/statement from "
+                  << counts.arena_blocks << " blocks";
+    std::cout << std::endl;
+}
+
+// Parses the supplied inputs in both modes, checking that they find the same
+// statements, and reports allocations and parse+free latency for each
+bool compare(
+        const char* label,
+        const std::vector<std::string>& inputs,
+        size_t iterations) {
+    parse_options_t heap_opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    parse_options_t arena_opts = {SQL_DIALECT_ANSI_1992, false, false, true};
+
+    mode_counts_t heap = count_allocations(inputs, heap_opts);
+    mode_counts_t arena = count_allocations(inputs, arena_opts);
+    if (heap.statements != arena.statements) {
+        std::cerr << label << ": heap mode found " << heap.statements
+                  << " statements but arena mode found " << arena.statements
+                  << std::endl;
+        return false;
+    }
+    std::cout << label << ": " << heap.statements << " statements"
+              << std::endl;
+    report_mode("heap", heap);
+    report_mode("arena", arena);
+
+    size_t num_statements = heap.statements * iterations;
+    double heap_ns = time_parse_free(inputs, heap_opts, iterations);
+    double arena_ns = time_parse_free(inputs, arena_opts, iterations);
+    report("heap parse+free", heap_ns, num_statements, "statement");
+    report("arena parse+free", arena_ns, num_statements, "statement");
+    std::cout << "speedup: " << std::setprecision(2) << heap_ns / arena_ns
+              << "x" << std::endl << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (! compare("corpus", corpus, iterations))
+        return 1;
+
+    // Multi-row INSERTs build large trees of row value constructors and
+    // literals, which is where per-node allocation costs the most
+    std::vector<std::string> inserts;
+    for (int x = 0; x < 100; x++) {
+        std::string input = "INSERT INTO t1 (id, name, amount) VALUES ";
+        for (int row = 0; row < 20; row++) {
+            if (row > 0)
+                input += ",";
+            input += "(" + std::to_string(x * 20 + row) + ",'name " +
+                     std::to_string(row) + "'," + std::to_string(row * 3) +
+                     ".25)";
+        }
+        inserts.emplace_back(input);
+    }
+    if (! compare("inserts", inserts, iterations / 10 + 1))
+        return 1;
+    return 0;
+}
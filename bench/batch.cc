@@ -0,0 +1,104 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Replays a generated query log through sqltoast::parse_batch() with 1, 2,
+// 4 and so on up to N threads, where N defaults to the number of cores,
+// checking that the results come back in input order and reporting
+// throughput and speedup over a single thread at each thread count.
+
+#include <thread>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+// Builds a query log by repeating the corpus inputs, with a short generated
+// query after each so the log is not just the same few inputs over again
+std::vector<std::string> make_log(
+        const std::vector<std::string>& corpus,
+        size_t num_lines) {
+    std::vector<std::string> log;
+    log.reserve(num_lines);
+    for (size_t x = 0; log.size() < num_lines; x++) {
+        log.emplace_back(corpus[x % corpus.size()]);
+        if (log.size() < num_lines)
+            log.emplace_back(
+                    "SELECT id, name FROM users WHERE id = " +
+                    std::to_string(x) + " AND status <> 'deleted'");
+    }
+    return log;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t num_lines = 200000;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1)
+        num_lines = std::stoul(argv[1]);
+    if (argc > 2)
+        max_threads = std::stoul(argv[2]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    std::vector<std::string> log = make_log(corpus, num_lines);
+    std::vector<batch_input_t> inputs;
+    inputs.reserve(log.size());
+    for (const std::string& line : log)
+        inputs.push_back({line.data(), line.size()});
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, true};
+
+    // Every result must match what a plain parse() of the same input gives
+    std::vector<parse_result_t> results = parse_batch(
+            inputs.data(), inputs.size(), opts, max_threads);
+    for (size_t x = 0; x < log.size(); x++) {
+        parse_result_t expected = parse(log[x].data(), log[x].size(), opts);
+        if (results[x].code != expected.code ||
+                results[x].statements.size() != expected.statements.size()) {
+            std::cerr << "Result " << x << " is out of order or wrong for "
+                      << "input:" << std::endl << log[x] << std::endl;
+            return 1;
+        }
+    }
+    results.clear();
+    std::cout << log.size() << " log lines, results in input order"
+              << std::endl;
+
+    double single_ns = 0;
+    for (size_t threads = 1; ; threads *= 2) {
+        threads = std::min(threads, max_threads);
+        // Take the best of a few runs, since each run leaves the heap in a
+        // different state for the next
+        double ns = 0;
+        for (int run = 0; run < 3; run++) {
+            double run_ns = run_timed(1, [&]() {
+                results = parse_batch(
+                        inputs.data(), inputs.size(), opts, threads);
+                results.clear();
+            });
+            if (run == 0 || run_ns < ns)
+                ns = run_ns;
+        }
+        if (threads == 1)
+            single_ns = ns;
+        std::string name = std::to_string(threads) + " threads";
+        report(name.c_str(), ns, log.size(), "input");
+        std::cout << "  speedup: " << std::setprecision(2)
+                  << single_ns / ns << "x" << std::endl;
+        if (threads == max_threads)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_BENCH_H
+#define SQLTOAST_BENCH_H
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sqltoast_bench {
+
+// Returns the SQL input blocks from every grammar test file in the corpus
+// directory. Input lines in a test file are prefixed with '>' and consecutive
+// input lines form a single SQL input, exactly as tests/grammar/runner.py
+// reads them. Inputs following a "#! ... --deserialize" line are serialized
+// statements rather than SQL, and are skipped.
+inline std::vector<std::string> load_corpus(const char *dir = SQLTOAST_BENCH_CORPUS_DIR) {
+    std::vector<std::string> fnames;
+    std::vector<std::string> inputs;
+    DIR *d = opendir(dir);
+    if (d == nullptr) {
+        std::cerr << "Failed to open corpus directory " << dir << std::endl;
+        return inputs;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(d)) != nullptr) {
+        std::string fname(ent->d_name);
+        if (fname.size() > 5 && fname.compare(fname.size() - 5, 5, ".test") == 0)
+            fnames.emplace_back(std::string(dir) + "/" + fname);
+    }
+    closedir(d);
+    std::sort(fnames.begin(), fnames.end());
+
+    for (const std::string& fname : fnames) {
+        std::ifstream f(fname);
+        std::string line;
+        std::string input;
+        bool in_input = false;
+        bool is_sql = true;
+        while (std::getline(f, line)) {
+            if (line.compare(0, 2, "#!") == 0) {
+                is_sql = line.find("--deserialize") == std::string::npos;
+                continue;
+            }
+            if (! line.empty() && line[0] == '#')
+                continue;
+            if (! line.empty() && line[0] == '>') {
+                if (in_input)
+                    input.push_back('\n');
+                input.append(line, 1, std::string::npos);
+                in_input = true;
+                continue;
+            }
+            if (in_input) {
+                if (is_sql)
+                    inputs.emplace_back(input);
+                input.clear();
+                in_input = false;
+            }
+        }
+        if (in_input && is_sql)
+            inputs.emplace_back(input);
+    }
+    return inputs;
+}
+
+// Forces the compiler to assume all memory may have changed, so that work
+// on unchanging inputs isn't hoisted out of a benchmark's timing loop
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Runs the supplied function the supplied number of times and returns the
+// total elapsed wall time in nanoseconds
+template<typename F>
+inline double run_timed(size_t iterations, F&& func) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t x = 0; x < iterations; x++)
+        func();
+    auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    return static_cast<double>(dur.count());
+}
+
+// Prints a single result line with the time taken per item and the number of
+// items processed per second
+inline void report(const char *name, double total_ns, size_t items, const char *unit) {
+    double per_item = total_ns / items;
+    double per_sec = items / (total_ns / 1e9);
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << per_item << " ns/" << unit
+              << std::setw(14) << std::setprecision(0) << per_sec
+              << " " << unit << "s/sec" << std::endl;
+}
+
+} // namespace sqltoast_bench
+
+#endif /* SQLTOAST_BENCH_H */
@@ -0,0 +1,100 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Parses SELECT statements whose WHERE clause is a generated search condition
+// of 1,000 and 10,000 comparison predicates joined by AND, by OR, by a mix of
+// both and in parenthesized groups, reporting the time taken per predicate.
+// Parsing a search condition should be linear in the number of predicates, so
+// the time per predicate ought to stay flat going from 1k to 10k terms.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+typedef enum condition_shape {
+    SHAPE_AND,
+    SHAPE_OR,
+    SHAPE_MIXED,
+    SHAPE_GROUPED
+} condition_shape_t;
+
+const char* shape_names[] = {"AND", "OR", "mixed", "grouped"};
+
+std::string predicate(size_t x) {
+    return "c" + std::to_string(x % 16) + " = " + std::to_string(x);
+}
+
+// Returns a SELECT statement with a WHERE clause containing num_terms
+// comparison predicates. Grouped conditions enclose every four predicates in
+// parentheses, AND'ing them in pairs and OR'ing the pairs and the groups.
+std::string generate(condition_shape_t shape, size_t num_terms) {
+    std::string sql = "SELECT c0 FROM t WHERE ";
+    for (size_t x = 0; x < num_terms; x++) {
+        if (x > 0) {
+            switch (shape) {
+                case SHAPE_AND:
+                    sql += " AND ";
+                    break;
+                case SHAPE_OR:
+                    sql += " OR ";
+                    break;
+                case SHAPE_MIXED:
+                    sql += (x % 3 == 0) ? " OR " : " AND ";
+                    break;
+                case SHAPE_GROUPED:
+                    if (x % 4 == 0)
+                        sql += ") OR ";
+                    else
+                        sql += (x % 2 == 0) ? " OR " : " AND ";
+                    break;
+            }
+        }
+        if (shape == SHAPE_GROUPED && x % 4 == 0)
+            sql += "(";
+        sql += predicate(x);
+    }
+    if (shape == SHAPE_GROUPED)
+        sql += ")";
+    return sql;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 50;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    for (condition_shape_t shape : {SHAPE_AND, SHAPE_OR, SHAPE_MIXED, SHAPE_GROUPED}) {
+        for (size_t num_terms : {1000, 10000}) {
+            std::string input = generate(shape, num_terms);
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            if (res.code != PARSE_OK) {
+                std::cerr << "Failed to parse " << shape_names[shape]
+                          << " condition of " << num_terms << " terms: "
+                          << res.error << std::endl;
+                return 1;
+            }
+            // Keep the total number of predicates parsed the same for each
+            // condition size
+            size_t runs = iterations * 1000 / num_terms + 1;
+            double ns = run_timed(runs, [&]() {
+                parse_result_t res = parse(input.data(), input.size(), opts);
+                clobber_memory();
+            });
+            std::string label = std::string(shape_names[shape]) + " x" +
+                                std::to_string(num_terms);
+            report(label.c_str(), ns, runs * num_terms, "term");
+        }
+    }
+    return 0;
+}
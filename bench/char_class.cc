@@ -0,0 +1,173 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares the character class scanning done by the tokenizers in each of
+// the available implementations (scalar table lookups, SSE2 and AVX2) against
+// the original locale-dependent std::isspace()/std::isalnum()/std::isdigit()
+// loops, then times lexing a multi-kilobyte INSERT batch with each
+// implementation.
+
+#include <cctype>
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/char_class.h"
+#include "parser/lexer.h"
+
+#include "bench.h"
+
+using namespace sqltoast;
+
+namespace {
+
+parse_position_t legacy_scan_space(parse_position_t cur, const parse_position_t end) {
+    while (cur != end && std::isspace(*cur))
+        cur++;
+    return cur;
+}
+
+parse_position_t legacy_scan_digits(parse_position_t cur, const parse_position_t end) {
+    while (cur != end && std::isdigit(*cur))
+        cur++;
+    return cur;
+}
+
+parse_position_t legacy_scan_identifier(parse_position_t cur, const parse_position_t end) {
+    while (cur != end && (std::isalnum(*cur) || *cur == '.' || *cur == '_' || *cur == '*'))
+        cur++;
+    return cur;
+}
+
+// Walks the subject one run at a time, scanning each run of whitespace,
+// digits or identifier characters with the supplied functions, and returns
+// the number of runs found. Anything else is stepped over a byte at a time.
+template<typename S, typename D, typename I>
+size_t walk_runs(const parse_input_t& subject, S scan_sp, D scan_dig, I scan_ident) {
+    size_t runs = 0;
+    parse_position_t cur = subject.data();
+    const parse_position_t end = subject.data() + subject.size();
+    while (cur != end) {
+        parse_position_t next;
+        if (std::isspace(*cur))
+            next = scan_sp(cur, end);
+        else if (std::isdigit(*cur))
+            next = scan_dig(cur, end);
+        else if (std::isalpha(*cur))
+            next = scan_ident(cur, end);
+        else
+            next = cur + 1;
+        runs++;
+        cur = next;
+    }
+    return runs;
+}
+
+size_t walk_runs_current(const parse_input_t& subject) {
+    return walk_runs(subject, &scan_space, &scan_digits, &scan_identifier);
+}
+
+size_t walk_runs_legacy(const parse_input_t& subject) {
+    return walk_runs(subject, &legacy_scan_space, &legacy_scan_digits,
+            &legacy_scan_identifier);
+}
+
+size_t lex_all(parse_input_t& subject) {
+    lexer_t lex(subject.data(), subject.data() + subject.size());
+    lex.tokenize();
+    return lex.tokens.size();
+}
+
+const char *impl_name(char_scan_impl_t impl) {
+    switch (impl) {
+        case CHAR_SCAN_SCALAR:
+            return "scalar table";
+        case CHAR_SCAN_SSE2:
+            return "SSE2";
+        case CHAR_SCAN_AVX2:
+            return "AVX2";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    using namespace sqltoast_bench;
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    // A multi-row INSERT with long identifiers, wide numbers and indented,
+    // multi-line formatting, which is where the scanning loops dominate
+    std::string input(
+        "INSERT INTO customer_order_line_items_archive "
+        "(order_identifier, line_item_number, product_stock_keeping_unit,"
+        " quantity_ordered, unit_price_in_cents) VALUES\n");
+    for (int x = 0; x < 200; x++) {
+        if (x > 0)
+            input += ",\n";
+        input += "        (" + std::to_string(1000000000 + x * 7919) +
+                 ",    " + std::to_string(x) +
+                 ",    product_catalog.sku_reference_number_" + std::to_string(x) +
+                 ",    " + std::to_string(x * 13 % 97) +
+                 ",    " + std::to_string(123456789 + x) + ")";
+    }
+    parse_input_t subject(input.cbegin(), input.cend());
+
+    const char_scan_impl_t best = char_scan_impl();
+    std::vector<char_scan_impl_t> impls;
+    for (char_scan_impl_t impl : {CHAR_SCAN_SCALAR, CHAR_SCAN_SSE2, CHAR_SCAN_AVX2}) {
+        if (set_char_scan_impl(impl))
+            impls.push_back(impl);
+    }
+
+    // Every implementation must find exactly the same runs and tokens
+    size_t legacy_runs = walk_runs_legacy(subject);
+    size_t num_tokens = 0;
+    for (char_scan_impl_t impl : impls) {
+        set_char_scan_impl(impl);
+        size_t runs = walk_runs_current(subject);
+        size_t tokens = lex_all(subject);
+        if (runs != legacy_runs || (num_tokens != 0 && tokens != num_tokens)) {
+            std::cerr << "Mismatch using " << impl_name(impl) << " scanning."
+                      << std::endl;
+            return 1;
+        }
+        num_tokens = tokens;
+    }
+
+    std::cout << "subject: " << subject.size() << " bytes, " << legacy_runs
+              << " runs, " << num_tokens << " tokens (default scanning: "
+              << impl_name(best) << ")" << std::endl;
+
+    size_t found = 0;
+    size_t bytes = iterations * subject.size();
+    double ns = run_timed(iterations, [&]() {
+        clobber_memory();
+        found += walk_runs_legacy(subject);
+    });
+    report("run scanning, std::isxxx()", ns, bytes, "byte");
+    for (char_scan_impl_t impl : impls) {
+        set_char_scan_impl(impl);
+        ns = run_timed(iterations, [&]() {
+            clobber_memory();
+            found += walk_runs_current(subject);
+        });
+        std::string name = std::string("run scanning, ") + impl_name(impl);
+        report(name.c_str(), ns, bytes, "byte");
+    }
+    for (char_scan_impl_t impl : impls) {
+        set_char_scan_impl(impl);
+        ns = run_timed(iterations, [&]() {
+            found += lex_all(subject);
+        });
+        std::string name = std::string("lexing, ") + impl_name(impl);
+        report(name.c_str(), ns, bytes, "byte");
+    }
+    set_char_scan_impl(best);
+    std::cout << "(" << found << " runs and tokens found)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares classifying statements with sqltoast::classify() against parsing
+// them, over a query log made from the valid inputs of the grammar test
+// corpus repeated to around 16MB. Parsing is done with statement
+// construction disabled, which is the fastest that parse() gets. Before
+// timing anything, checks that classify() finds the same statements of the
+// same types as parse() does for every valid corpus input.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+const size_t LOG_SIZE = 16 * 1024 * 1024;
+
+// Returns the number of inputs that classify() and parse() disagree on
+size_t check_agreement(const std::vector<std::string>& inputs) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<statement_class_t> classes;
+    size_t disagree = 0;
+    for (const std::string& input : inputs) {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        classes.clear();
+        classify(input.data(), input.size(), classes);
+        bool same = (classes.size() == res.statements.size());
+        for (size_t x = 0; same && x < classes.size(); x++)
+            same = (classes[x].recognized &&
+                    classes[x].type == res.statements[x]->type);
+        if (same)
+            continue;
+        std::cerr << "classify() and parse() disagree on: " << input
+                  << std::endl;
+        disagree++;
+    }
+    return disagree;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 20;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> valid;
+    for (const std::string& input : load_corpus()) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_OK)
+            valid.emplace_back(input);
+    }
+    if (valid.empty()) {
+        std::cerr << "No valid inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_agreement(valid) > 0)
+        return 1;
+
+    // Some corpus inputs end in a simple comment, so the semicolon ending
+    // each goes on a line of its own
+    std::string log;
+    while (log.size() < LOG_SIZE) {
+        for (const std::string& input : valid) {
+            log += input;
+            log += "\n;\n";
+        }
+    }
+
+    std::vector<statement_class_t> classes;
+    size_t num_statements = classify(log.data(), log.size(), classes);
+    double classify_ns = run_timed(iterations, [&]() {
+        classes.clear();
+        classify(log.data(), log.size(), classes);
+        clobber_memory();
+    });
+
+    parse_options_t validate_opts = {SQL_DIALECT_ANSI_1992, true, false, false};
+    parser_t p(validate_opts);
+    double parse_ns = run_timed(iterations, [&]() {
+        p.parse(log.data(), log.size());
+        clobber_memory();
+    });
+
+    std::cout << num_statements << " statements, " << log.size()
+              << " bytes" << std::endl;
+    report("classify()", classify_ns, iterations * num_statements, "statement");
+    report("parse() without statements", parse_ns, iterations * num_statements,
+           "statement");
+    std::cout << std::fixed << std::setprecision(2)
+              << "classify() GB/sec: "
+              << (log.size() * iterations) / classify_ns
+              << ", parse() GB/sec: "
+              << (log.size() * iterations) / parse_ns
+              << ", speedup: " << parse_ns / classify_ns << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares tokenizing the grammar test corpus with the lexer's first
+// character dispatch table against the original approach of trying each
+// tokenizer in turn until one of them doesn't return TOKEN_NOT_FOUND.
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/comment.h"
+#include "parser/identifier.h"
+#include "parser/keyword.h"
+#include "parser/lexer.h"
+#include "parser/literal.h"
+#include "parser/special.h"
+
+#include "bench.h"
+
+using namespace sqltoast;
+
+namespace {
+
+const size_t NUM_TOKENIZERS = 5;
+const tokenize_func_t chain[5] = {
+    &token_comment,
+    &token_special,
+    &token_keyword,
+    &token_literal,
+    &token_identifier
+};
+
+void tokenize_chain_into(const parse_input_t& subject, std::vector<token_t>& tokens) {
+    const parse_position_t end = subject.data() + subject.size();
+    parse_position_t cur = subject.data();
+    while (true) {
+        cur = skip(cur, end);
+        if (cur >= end)
+            return;
+        tokenize_result_t tok_res(TOKEN_NOT_FOUND);
+        for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
+            tok_res = chain[x](cur, end);
+            if (tok_res.code != TOKEN_NOT_FOUND)
+                break;
+        }
+        if (tok_res.code != TOKEN_FOUND)
+            return;
+        tokens.push_back(tok_res.token);
+        cur = tok_res.token.lexeme.end;
+    }
+}
+
+// Tokenizes the subject the same way lexer_t::tokenize() does, including
+// allocating a new token vector, but running through the chain of
+// tokenizers for each token
+void tokenize_chain(const parse_input_t& subject, std::vector<token_t>& out) {
+    std::vector<token_t> tokens;
+    tokens.reserve(subject.size() / 4 + 1);
+    tokenize_chain_into(subject, tokens);
+    out.swap(tokens);
+}
+
+void tokenize_dispatch(parse_input_t& subject, std::vector<token_t>& tokens) {
+    lexer_t lex(subject.data(), subject.data() + subject.size());
+    lex.tokenize();
+    tokens.swap(lex.tokens);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    using namespace sqltoast_bench;
+    size_t iterations = 500;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    std::vector<parse_input_t> subjects;
+    for (const std::string& input : corpus)
+        subjects.emplace_back(input.cbegin(), input.cend());
+    if (subjects.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+
+    // Both approaches must produce exactly the same tokens
+    size_t num_tokens = 0;
+    std::vector<token_t> chain_tokens;
+    std::vector<token_t> dispatch_tokens;
+    for (parse_input_t& subject : subjects) {
+        tokenize_chain(subject, chain_tokens);
+        tokenize_dispatch(subject, dispatch_tokens);
+        bool same = chain_tokens.size() == dispatch_tokens.size();
+        for (size_t x = 0; same && x < chain_tokens.size(); x++) {
+            const token_t& a = chain_tokens[x];
+            const token_t& b = dispatch_tokens[x];
+            same = (a.symbol == b.symbol &&
+                    a.lexeme.start == b.lexeme.start &&
+                    a.lexeme.end == b.lexeme.end);
+        }
+        if (! same) {
+            std::cerr << "Mismatch between chained and dispatched tokens "
+                         "for input:" << std::endl
+                      << std::string(subject.data(), subject.size())
+                      << std::endl;
+            return 1;
+        }
+        num_tokens += chain_tokens.size();
+    }
+    std::cout << "corpus: " << subjects.size() << " inputs, "
+              << num_tokens << " tokens" << std::endl;
+
+    double chain_ns = run_timed(iterations, [&]() {
+        for (parse_input_t& subject : subjects)
+            tokenize_chain(subject, chain_tokens);
+    });
+    double dispatch_ns = run_timed(iterations, [&]() {
+        for (parse_input_t& subject : subjects)
+            tokenize_dispatch(subject, dispatch_tokens);
+    });
+
+    size_t total_tokens = iterations * num_tokens;
+    report("tokenizer chain", chain_ns, total_tokens, "token");
+    report("first character dispatch", dispatch_ns, total_tokens, "token");
+    std::cout << "speedup: " << std::setprecision(2)
+              << chain_ns / dispatch_ns << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares sqltoaster's two ways of writing out parsed statements: filling a
+// tree of nodes with printer_t::process_statements() and printing it with
+// print_map(), against writing YAML or JSON straight from the AST with the
+// streaming emitter. The statements are those of a script made from the
+// valid inputs of the grammar test corpus repeated to around 1MB, parsed
+// once. Output goes to a stream that throws it away, so only the cost of
+// producing it is measured. Reports time per statement, output throughput
+// and heap allocations per statement.
+//
+// Before timing anything, checks that the emitter's YAML is the same as the
+// tree's for every corpus input.
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+#include "emit.h"
+#include "emitter.h"
+#include "node.h"
+#include "printer.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+using namespace sqltoaster;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+const size_t SCRIPT_SIZE = 1024 * 1024;
+
+// Counts the bytes written to it and otherwise discards them
+struct null_buf : std::streambuf {
+    size_t written = 0;
+    int overflow(int c) {
+        written++;
+        return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) {
+        written += n;
+        return n;
+    }
+};
+
+// What sqltoaster's printer did for YAML before the emitter
+void print_tree(std::ostream& out, parse_result_t& res) {
+    printer_t ptr(res, out);
+    ptr.process_statements();
+    if (ptr.statement_node_count()) {
+        mapping_t statements;
+        statements.setattr("statements", ptr.statements);
+        print_map(out, statements, 0, false);
+    }
+}
+
+void print_emitted(std::ostream& out, parse_result_t& res, emit_format_t format) {
+    emitter_t em(out, format, res.input);
+    emit(em, res);
+}
+
+// Returns the number of corpus inputs the tree and the emitter write
+// different YAML for
+size_t check_agreement(const std::vector<std::string>& inputs) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    size_t disagree = 0;
+    for (const std::string& input : inputs) {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        if (res.code != PARSE_OK)
+            continue;
+        std::ostringstream tree, emitted;
+        print_tree(tree, res);
+        print_emitted(emitted, res, EMIT_FORMAT_YAML);
+        if (tree.str() == emitted.str())
+            continue;
+        std::cerr << "tree and emitter disagree on: " << input << std::endl
+                  << tree.str() << std::endl << "vs." << std::endl
+                  << emitted.str() << std::endl;
+        disagree++;
+    }
+    return disagree;
+}
+
+template<typename F>
+void run(const char* label, size_t iterations, size_t num_statements, F&& func) {
+    null_buf nb;
+    std::ostream out(&nb);
+    size_t before = num_heap_allocations;
+    double ns = run_timed(iterations, [&]() {
+        func(out);
+        clobber_memory();
+    });
+    size_t allocs = num_heap_allocations - before;
+
+    report(label, ns, iterations * num_statements, "statement");
+    std::cout << std::fixed << std::setprecision(1)
+              << "output MB/sec: " << nb.written / (ns / 1e9) / 1e6
+              << ", heap allocations/statement: "
+              << double(allocs) / (iterations * num_statements) << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 20;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_agreement(corpus) > 0)
+        return 1;
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> valid;
+    for (const std::string& input : corpus) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_OK)
+            valid.emplace_back(input);
+    }
+    std::string script;
+    while (script.size() < SCRIPT_SIZE) {
+        for (const std::string& input : valid) {
+            script += input;
+            script += "\n;\n";
+        }
+    }
+    parse_result_t res = parse(script.data(), script.size(), opts);
+    if (res.code != PARSE_OK) {
+        std::cerr << "Failed to parse script: " << res.error << std::endl;
+        return 1;
+    }
+    size_t num_statements = res.statements.size();
+    std::cout << num_statements << " statements, " << script.size()
+              << " bytes" << std::endl;
+
+    run("tree of nodes, YAML", iterations, num_statements,
+        [&](std::ostream& out) {
+            print_tree(out, res);
+        });
+    run("emitter, YAML", iterations, num_statements,
+        [&](std::ostream& out) {
+            print_emitted(out, res, EMIT_FORMAT_YAML);
+        });
+    run("emitter, JSON", iterations, num_statements,
+        [&](std::ostream& out) {
+            print_emitted(out, res, EMIT_FORMAT_JSON);
+        });
+    return 0;
+}
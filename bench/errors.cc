@@ -0,0 +1,83 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Measures how quickly invalid input is rejected. First parses the inputs of
+// the grammar test corpus that are syntax errors. Then parses generated
+// SELECT statements of 1KB, 64KB and 1MB whose syntax error comes at the
+// very end, reporting the time per byte, which ought to stay flat as the
+// input grows. Finally times writing out the human-readable error message
+// for each of those, which is only done when asked for.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+// Returns a SELECT statement of at least the supplied size that has a
+// syntax error right before its end
+std::string generate(size_t size) {
+    std::string sql = "SELECT c0";
+    for (size_t x = 1; sql.size() < size; x++)
+        sql += ", c" + std::to_string(x);
+    sql += " FROM t WHERE c0 = = 1";
+    return sql;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> invalid;
+    for (const std::string& input : load_corpus()) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_SYNTAX_ERROR)
+            invalid.emplace_back(input);
+    }
+    if (invalid.empty()) {
+        std::cerr << "No syntax errors found in corpus." << std::endl;
+        return 1;
+    }
+    double ns = run_timed(iterations * 10, [&]() {
+        for (const std::string& input : invalid) {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            clobber_memory();
+        }
+    });
+    report("corpus syntax errors", ns, iterations * 10 * invalid.size(), "input");
+    std::cout << std::endl;
+
+    for (size_t size : {1024, 64 * 1024, 1024 * 1024}) {
+        std::string input = generate(size);
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        if (res.code != PARSE_SYNTAX_ERROR) {
+            std::cerr << "Expected a syntax error for input of "
+                      << input.size() << " bytes" << std::endl;
+            return 1;
+        }
+        // Keep the total number of bytes parsed the same for each size
+        size_t runs = iterations * 64 * 1024 / input.size() + 1;
+        double parse_ns = run_timed(runs, [&]() {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            clobber_memory();
+        });
+        double message_ns = run_timed(runs, [&]() {
+            std::string message = res.error.str();
+            clobber_memory();
+        });
+        std::string label = "reject " + std::to_string(size / 1024) + "KB";
+        report(label.c_str(), parse_ns, runs * input.size(), "byte");
+        label = "message " + std::to_string(size / 1024) + "KB";
+        report(label.c_str(), message_ns, runs, "error");
+    }
+    return 0;
+}
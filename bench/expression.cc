@@ -0,0 +1,119 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Parses SELECT statements with expression-heavy selected columns and WHERE
+// clauses, reporting how many tokens each statement contains against how
+// many times the lexer had to run its tokenizers to parse it, and how many
+// AST nodes were built along the way. Anything beyond one tokenizer run per
+// token is the parser re-scanning tokens it has already seen while
+// backtracking out of a failed alternative, and the partial trees built by
+// failed alternatives show up as extra nodes.
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/arena.h"
+#include "parser/context.h"
+#include "parser/lexer.h"
+#include "parser/parse.h"
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+const char* statements[] = {
+    "SELECT a + b * 2, c || d, UPPER(e), f - 1, CURRENT_DATE, COUNT(g) "
+    "FROM t",
+    "SELECT a FROM t "
+    "WHERE a + 1 > b * 2 AND c || d = 'x' AND (e - f) < 10",
+    "SELECT (a + (b * (c - (d + 1)))) FROM t",
+    "SELECT CASE WHEN a > 1 THEN b || 'x' ELSE LOWER(c) END, "
+    "d AT TIME ZONE 'UTC', e + f DAY FROM t",
+    "SELECT SUBSTRING(a FROM 1 FOR 2) || TRIM(b), "
+    "CHAR_LENGTH(c) + POSITION('x' IN d) FROM t "
+    "WHERE CURRENT_TIMESTAMP > e",
+    "SELECT a * b, a / b, -a, +b, c COLLATE utf8 || d FROM t "
+    "WHERE a IN (1, 2, 3) OR b LIKE 'x%'",
+    "SELECT price * quantity - discount, first_name || ' ' || last_name "
+    "FROM orders WHERE price * quantity > 100 AND status <> 'void' "
+    "AND customer_id = 42",
+    "SELECT CASE WHEN a = 1 THEN 'x' ELSE 'y' END || z, "
+    "CASE b WHEN 1 THEN c ELSE d END AT LOCAL FROM t",
+    "SELECT ((((a || b) || c) || d) || e) FROM t",
+};
+
+typedef struct scan_counts {
+    size_t tokens;
+    size_t tokenize_calls;
+    size_t nodes_built;
+} scan_counts_t;
+
+// Parses the statement with tokens found on demand, returning the number of
+// distinct tokens in it, the number of times the tokenizers were run and the
+// number of AST nodes built
+scan_counts_t count_scans(const std::string& input) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, true};
+    parse_result_t res;
+    res.arena.reset(new arena_t);
+    arena_scope_t scope(res.arena.get());
+    parse_context_t ctx(
+            res, opts, input.data(), input.data() + input.size());
+    parse_statements(ctx);
+    if (res.code != PARSE_OK) {
+        std::cerr << "Failed to parse: " << input << std::endl
+                  << res.error << std::endl;
+        return {0, 0, 0};
+    }
+    lexer_t counter(input.data(), input.data() + input.size());
+    counter.tokenize();
+    return {
+        counter.tokens.size(),
+        ctx.lexer.num_tokenize_calls,
+        res.arena->num_allocations
+    };
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 20000;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> inputs(std::begin(statements), std::end(statements));
+    size_t total_tokens = 0;
+    size_t total_calls = 0;
+    size_t total_nodes = 0;
+    for (const std::string& input : inputs) {
+        scan_counts_t counts = count_scans(input);
+        if (counts.tokens == 0)
+            return 1;
+        std::cout << std::setw(4) << counts.tokens << " tokens, "
+                  << std::setw(5) << counts.tokenize_calls
+                  << " tokenizer runs, " << std::setw(5) << counts.nodes_built
+                  << " nodes: " << input.substr(0, 40) << "..." << std::endl;
+        total_tokens += counts.tokens;
+        total_calls += counts.tokenize_calls;
+        total_nodes += counts.nodes_built;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "tokenizer runs per token: "
+              << double(total_calls) / total_tokens
+              << ", nodes built per token: "
+              << double(total_nodes) / total_tokens << std::endl;
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    double ns = run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            clobber_memory();
+        }
+    });
+    report("parse", ns, inputs.size() * iterations, "statement");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Times fingerprinting the grammar test corpus with sqltoast::fingerprint()
+// and sqltoast::fingerprint_hash(), reporting time and heap allocations per
+// input, with parsing without statement construction for comparison. Before
+// timing anything, checks that both functions agree on every input and that
+// queries differing only in their literals get the same fingerprint.
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// Pairs of queries with the same shape
+const char* same_shape[][2] = {
+    {"SELECT a FROM t WHERE b = 1 AND c IN (1, 2, 3)",
+     "select a from t where b=-42.5 and c in ('x') ;"},
+    {"INSERT INTO t (a, b) VALUES (1, 'one')",
+     "insert into t(a,b) values (2, /* two */ 'two');"},
+    {"UPDATE t SET a = a - 1 WHERE b = ?",
+     "UPDATE t SET a = a - 7 WHERE b = 'x' -- bump\n"},
+};
+
+// Returns the number of inputs that fingerprint() and fingerprint_hash()
+// disagree on, plus the number of same-shape pairs that get different
+// fingerprints
+size_t check_agreement(const std::vector<std::string>& inputs) {
+    fingerprint_t fp;
+    size_t disagree = 0;
+    for (const std::string& input : inputs) {
+        uint64_t hash;
+        bool ok = fingerprint(input.data(), input.size(), fp);
+        if (fingerprint_hash(input.data(), input.size(), hash) == ok &&
+                hash == fp.hash)
+            continue;
+        std::cerr << "fingerprint() and fingerprint_hash() disagree on: "
+                  << input << std::endl;
+        disagree++;
+    }
+    for (const auto& pair : same_shape) {
+        fingerprint_t other;
+        fingerprint(pair[0], std::strlen(pair[0]), fp);
+        fingerprint(pair[1], std::strlen(pair[1]), other);
+        if (fp.normalized == other.normalized && fp.hash == other.hash)
+            continue;
+        std::cerr << "different fingerprints for queries of the same shape: "
+                  << fp.normalized << " and " << other.normalized
+                  << std::endl;
+        disagree++;
+    }
+    return disagree;
+}
+
+template<typename F>
+void run(
+        const char* label,
+        const std::vector<std::string>& inputs,
+        size_t input_bytes,
+        size_t iterations,
+        F&& func) {
+    size_t num_inputs = inputs.size() * iterations;
+    size_t before = num_heap_allocations;
+    double ns = run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            func(input);
+            clobber_memory();
+        }
+    });
+    size_t allocs = num_heap_allocations - before;
+
+    report(label, ns, num_inputs, "input");
+    std::cout << std::fixed << std::setprecision(1)
+              << "MB/sec: " << (input_bytes * iterations) / (ns / 1e9) / 1e6
+              << ", heap allocations/input: "
+              << double(allocs) / num_inputs << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_agreement(corpus) > 0)
+        return 1;
+    size_t input_bytes = 0;
+    for (const std::string& input : corpus)
+        input_bytes += input.size();
+
+    fingerprint_t fp;
+    run("fingerprint()", corpus, input_bytes, iterations,
+        [&](const std::string& input) {
+            fingerprint(input.data(), input.size(), fp);
+        });
+    uint64_t hash;
+    run("fingerprint_hash()", corpus, input_bytes, iterations,
+        [&](const std::string& input) {
+            fingerprint_hash(input.data(), input.size(), hash);
+        });
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, true, false, false};
+    parser_t p(opts);
+    run("parse() without statements", corpus, input_bytes, iterations,
+        [&](const std::string& input) {
+            p.parse(input.data(), input.size());
+        });
+    return 0;
+}
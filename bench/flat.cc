@@ -0,0 +1,114 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares parsing the grammar test corpus into the usual tree of statements
+// against parsing it into a flat AST with parse_options_t::flat set, both with
+// a reused sqltoast::parser. Then counts the column references in the flat
+// AST of the whole corpus twice: once by walking every statement with a
+// flat_visitor_t and once by scanning the node type and value arrays.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+bool is_column_reference(const flat_ast_t& ast, flat_index_t node) {
+    return ast.types[node] == FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY &&
+           ast.values[node] == VEP_TYPE_COLUMN_REFERENCE;
+}
+
+typedef struct column_counter : flat_visitor_t {
+    size_t count;
+    column_counter() : count(0)
+    {}
+    bool enter(const flat_ast_t& ast, flat_index_t node) {
+        count += is_column_reference(ast, node);
+        return true;
+    }
+} column_counter_t;
+
+double time_parse(
+        const std::vector<std::string>& inputs,
+        parse_options_t opts,
+        size_t iterations) {
+    parser_t p(opts);
+    return run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t& res = p.parse(input.data(), input.size());
+            clobber_memory();
+            (void) res;
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+
+    parse_options_t tree_opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    parse_options_t flat_opts = {
+        SQL_DIALECT_ANSI_1992, false, false, false, false, true
+    };
+    size_t num_inputs = corpus.size() * iterations;
+    double tree_ns = time_parse(corpus, tree_opts, iterations);
+    double flat_ns = time_parse(corpus, flat_opts, iterations);
+    report("tree", tree_ns, num_inputs, "input");
+    report("flat", flat_ns, num_inputs, "input");
+    std::cout << std::endl;
+
+    // Gather the flat AST of every valid input into one so that the
+    // traversals below have a decent amount of nodes to get through. Some
+    // inputs end in a comment, so the separator goes on a line of its own.
+    std::string all;
+    for (const std::string& input : corpus) {
+        if (parse(input.data(), input.size(), flat_opts).code == PARSE_OK)
+            all += input + "\n;\n";
+    }
+    parse_result_t res = parse(all.data(), all.size(), flat_opts);
+    const flat_ast_t& ast = res.flat;
+    std::cout << ast.statements.size() << " statements, " << ast.size()
+              << " nodes" << std::endl;
+
+    size_t walked = 0;
+    size_t num_walks = iterations * 10;
+    double walk_ns = run_timed(num_walks, [&]() {
+        column_counter_t counter;
+        for (flat_index_t stmt : ast.statements)
+            walk(ast, stmt, counter);
+        walked = counter.count;
+        clobber_memory();
+    });
+    size_t scanned = 0;
+    double scan_ns = run_timed(num_walks, [&]() {
+        size_t count = 0;
+        for (flat_index_t node = 0; node < ast.size(); node++)
+            count += is_column_reference(ast, node);
+        scanned = count;
+        clobber_memory();
+    });
+    if (walked != scanned) {
+        std::cerr << "walk() found " << walked << " column references but "
+                  << "the scan found " << scanned << std::endl;
+        return 1;
+    }
+    std::cout << walked << " column references" << std::endl;
+    report("walk()", walk_ns, num_walks * ast.size(), "node");
+    report("scan", scan_ns, num_walks * ast.size(), "node");
+    return 0;
+}
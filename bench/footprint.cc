@@ -0,0 +1,170 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Reports how much memory the statements parsed from a generated large
+// schema take up: a few hundred CREATE TABLE statements of wide tables with
+// defaults, constraints and foreign keys, along with INSERT statements
+// naming every column, GRANTs on column lists and SELECTs of qualified
+// columns from aliased tables. Prints the size of the AST nodes that carry names and
+// the heap bytes still held by the parse result once parsing is done, per
+// statement and per byte of input, as well as the time taken to parse.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+// Each allocation is preceded by a header recording its size, so that
+// frees can be subtracted from the bytes in use
+const size_t ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+
+size_t heap_bytes_in_use = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    char* mem = static_cast<char*>(std::malloc(size + ALLOC_HEADER_SIZE));
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t*>(mem) = size;
+    heap_bytes_in_use += size;
+    return mem + ALLOC_HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr)
+        return;
+    char* mem = static_cast<char*>(ptr) - ALLOC_HEADER_SIZE;
+    heap_bytes_in_use -= *reinterpret_cast<size_t*>(mem);
+    std::free(mem);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+const size_t NUM_TABLES = 400;
+const size_t NUM_COLUMNS = 40;
+
+std::string column_name(size_t col) {
+    return "customer_attribute_" + std::to_string(col);
+}
+
+std::string generate_schema() {
+    std::string sql;
+    for (size_t t = 0; t < NUM_TABLES; t++) {
+        std::string table = "application_table_" + std::to_string(t);
+        sql += "CREATE TABLE " + table + " (\n";
+        sql += "    id INT NOT NULL PRIMARY KEY,\n";
+        for (size_t c = 0; c < NUM_COLUMNS; c++) {
+            sql += "    " + column_name(c);
+            switch (c % 4) {
+                case 0:
+                    sql += " VARCHAR(255) DEFAULT 'unknown' NOT NULL";
+                    break;
+                case 1:
+                    sql += " DECIMAL(10, 2) DEFAULT 0";
+                    break;
+                case 2:
+                    sql += " DATE DEFAULT CURRENT_DATE";
+                    break;
+                case 3:
+                    if (t > 0)
+                        sql += " INT REFERENCES application_table_" +
+                               std::to_string(t - 1) + " (id)";
+                    else
+                        sql += " INT UNIQUE";
+                    break;
+            }
+            sql += ",\n";
+        }
+        sql += "    notes CHARACTER VARYING(1000)\n);\n";
+
+        sql += "INSERT INTO " + table + " (id";
+        for (size_t c = 0; c < NUM_COLUMNS; c++)
+            sql += ", " + column_name(c);
+        sql += ") VALUES (1";
+        for (size_t c = 0; c < NUM_COLUMNS; c++)
+            sql += ", " + std::to_string(c);
+        sql += ");\n";
+
+        sql += "GRANT SELECT, UPDATE (" + column_name(0) + ", " +
+               column_name(1) + ", " + column_name(2) + ") ON " + table +
+               " TO reporting_user;\n";
+
+        sql += "SELECT ";
+        for (size_t c = 0; c < 8; c++) {
+            if (c > 0)
+                sql += ", ";
+            sql += "a." + column_name(c);
+        }
+        sql += " FROM " + table + " a WHERE a.id = 1;\n";
+    }
+    return sql;
+}
+
+void report_size(const char* name, size_t size) {
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(6) << size << " bytes" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 10;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    report_size("lexeme_t", sizeof(lexeme_t));
+    report_size("column_definition_t", sizeof(column_definition_t));
+    report_size("constraint_t", sizeof(constraint_t));
+    report_size("foreign_key_constraint_t", sizeof(foreign_key_constraint_t));
+    report_size("default_descriptor_t", sizeof(default_descriptor_t));
+    report_size("table_t", sizeof(table_t));
+    report_size("derived_column_t", sizeof(derived_column_t));
+    report_size("value_expression_primary_t", sizeof(value_expression_primary_t));
+    report_size("insert_statement_t", sizeof(insert_statement_t));
+    std::cout << std::endl;
+
+    std::string input = generate_schema();
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    size_t before = heap_bytes_in_use;
+    size_t num_statements;
+    size_t footprint;
+    {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        if (res.code != PARSE_OK) {
+            std::cerr << "Failed to parse schema: " << res.error << std::endl;
+            return 1;
+        }
+        num_statements = res.statements.size();
+        footprint = heap_bytes_in_use - before;
+    }
+    std::cout << num_statements << " statements, " << input.size()
+              << " bytes of input" << std::endl;
+    std::cout << "parse result heap bytes: " << footprint << " ("
+              << std::fixed << std::setprecision(1)
+              << double(footprint) / num_statements << "/statement, "
+              << std::setprecision(2) << double(footprint) / input.size()
+              << "/input byte)" << std::endl << std::endl;
+
+    double ns = run_timed(iterations, [&]() {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        clobber_memory();
+    });
+    report("parse", ns, iterations * num_statements, "statement");
+    return 0;
+}
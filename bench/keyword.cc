@@ -0,0 +1,156 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares the static keyword hash table used by token_keyword() against the
+// original implementation, which kept a std::vector of std::string entries per
+// lead character, copied each entry while walking it and compared candidates
+// with a locale-aware case-insensitive search.
+
+#include <cctype>
+#include <locale>
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/keyword.h"
+#include "parser/symbol.h"
+
+#include "bench.h"
+
+using namespace sqltoast;
+
+namespace {
+
+struct legacy_kw_entry {
+    symbol_t symbol;
+    const std::string kw_str;
+    legacy_kw_entry(symbol_t sym, const std::string& kw_str) :
+        symbol(sym), kw_str(kw_str)
+    {}
+};
+typedef std::vector<legacy_kw_entry> legacy_kw_table_t;
+
+legacy_kw_table_t legacy_tables[26];
+
+void init_legacy_tables() {
+    for (int sym = SYMBOL_ACTION; sym <= SYMBOL_ZONE; sym++) {
+        const std::string name = symbol_name(sym);
+        legacy_tables[name[0] - 'A'].emplace_back(symbol_t(sym), name);
+    }
+}
+
+struct legacy_cmp_equal {
+    legacy_cmp_equal(const std::locale& loc) : loc_(loc) {}
+    bool operator()(char ch1, char ch2) {
+        return std::toupper(ch1, loc_) == std::toupper(ch2, loc_);
+    }
+private:
+    const std::locale& loc_;
+};
+
+int legacy_ci_find_substr(const std::string& str1, const std::string& str2,
+        const std::locale& loc = std::locale()) {
+    auto it = std::search(str1.begin(), str1.end(), str2.begin(), str2.end(),
+            legacy_cmp_equal(loc));
+    if (it != str1.end()) return it - str1.begin();
+    return -1;
+}
+
+symbol_t legacy_token_keyword(parse_position_t cursor, const parse_position_t end) {
+    if (! std::isalpha(*cursor))
+        return SYMBOL_NONE;
+    legacy_kw_table_t* jump_tbl = &legacy_tables[std::tolower(*cursor) - 'a'];
+    parse_position_t start = cursor;
+    while (cursor != end && (std::isalnum(*cursor) || *cursor == '_'))
+        cursor++;
+
+    const std::string lexeme(start, cursor);
+    const size_t lexeme_len = cursor - start;
+    for (auto entry : *jump_tbl) {
+        if (lexeme_len != entry.kw_str.size())
+            continue;
+        if (legacy_ci_find_substr(lexeme, entry.kw_str) == 0)
+            return entry.symbol;
+    }
+    return SYMBOL_NONE;
+}
+
+symbol_t new_token_keyword(parse_position_t cursor, const parse_position_t end) {
+    tokenize_result_t res = token_keyword(cursor, end);
+    if (res.code != TOKEN_FOUND)
+        return SYMBOL_NONE;
+    return res.token.symbol;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    using namespace sqltoast_bench;
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    init_legacy_tables();
+
+    // Break the corpus into the words that the keyword tokenizer would be
+    // handed, which is every run of characters starting with a latin letter.
+    // Every word is separated by a single space in the subject buffer.
+    std::vector<std::string> corpus = load_corpus();
+    parse_input_t subject;
+    std::vector<size_t> word_offsets;
+    for (const std::string& input : corpus) {
+        auto cur = input.cbegin();
+        while (cur != input.cend()) {
+            if (! std::isalpha(*cur)) {
+                cur++;
+                continue;
+            }
+            word_offsets.push_back(subject.size());
+            while (cur != input.cend() && (std::isalnum(*cur) || *cur == '_'))
+                subject.push_back(*cur++);
+            subject.push_back(' ');
+        }
+    }
+    if (word_offsets.empty()) {
+        std::cerr << "No words found in corpus." << std::endl;
+        return 1;
+    }
+
+    size_t num_keywords = 0;
+    const parse_position_t end = subject.data() + subject.size();
+    for (size_t off : word_offsets) {
+        parse_position_t cur = subject.data() + off;
+        symbol_t legacy_sym = legacy_token_keyword(cur, end);
+        symbol_t new_sym = new_token_keyword(cur, end);
+        if (legacy_sym != new_sym) {
+            std::cerr << "Mismatch at word offset " << off << ": legacy found "
+                      << legacy_sym << " but new found " << new_sym << std::endl;
+            return 1;
+        }
+        if (new_sym != SYMBOL_NONE)
+            num_keywords++;
+    }
+
+    std::cout << "corpus: " << corpus.size() << " inputs, "
+              << word_offsets.size() << " words, "
+              << num_keywords << " keywords" << std::endl;
+
+    size_t found = 0;
+    double legacy_ns = run_timed(iterations, [&]() {
+        for (size_t off : word_offsets)
+            found += legacy_token_keyword(subject.data() + off, end) != SYMBOL_NONE;
+    });
+    double new_ns = run_timed(iterations, [&]() {
+        for (size_t off : word_offsets)
+            found += new_token_keyword(subject.data() + off, end) != SYMBOL_NONE;
+    });
+
+    size_t lookups = iterations * word_offsets.size();
+    report("legacy jump tables", legacy_ns, lookups, "word");
+    report("static hash table", new_ns, lookups, "word");
+    std::cout << "speedup: " << std::setprecision(2) << legacy_ns / new_ns
+              << "x (" << found << " keywords matched)" << std::endl;
+    return 0;
+}
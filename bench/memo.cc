@@ -0,0 +1,109 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Parses the grammar test corpus and a set of statements with nested
+// parenthesized search conditions with and without parse_options_t::memoize
+// set, both building statements and only validating the input. Reports how
+// many rule attempts were replayed from the memo table against how many had
+// to be parsed, and the time taken in each mode, to show whether the memo
+// table pays for itself.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+typedef struct memo_counts {
+    size_t statements;
+    size_t hits;
+    size_t misses;
+} memo_counts_t;
+
+memo_counts_t count_memo(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts) {
+    memo_counts_t counts = {0, 0, 0};
+    for (const std::string& input : inputs) {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        counts.statements += res.statements.size();
+        counts.hits += res.memo_hits;
+        counts.misses += res.memo_misses;
+    }
+    return counts;
+}
+
+double time_parse(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts,
+        size_t iterations) {
+    return run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            clobber_memory();
+        }
+    });
+}
+
+void compare(
+        const char* label,
+        const std::vector<std::string>& inputs,
+        bool disable_construction,
+        size_t iterations) {
+    parse_options_t plain_opts = {
+        SQL_DIALECT_ANSI_1992, disable_construction, false, false, false
+    };
+    parse_options_t memo_opts = {
+        SQL_DIALECT_ANSI_1992, disable_construction, false, false, true
+    };
+    memo_counts_t counts = count_memo(inputs, memo_opts);
+    size_t attempts = counts.hits + counts.misses;
+    std::cout << label << (disable_construction ? " (validate only)" : "")
+              << ": " << counts.hits << " hits, " << counts.misses
+              << " misses, " << std::fixed << std::setprecision(1)
+              << (attempts > 0 ? 100.0 * counts.hits / attempts : 0.0)
+              << "% hit rate" << std::endl;
+
+    size_t num_inputs = inputs.size() * iterations;
+    double plain_ns = time_parse(inputs, plain_opts, iterations);
+    double memo_ns = time_parse(inputs, memo_opts, iterations);
+    report("without memo", plain_ns, num_inputs, "input");
+    report("with memo", memo_ns, num_inputs, "input");
+    std::cout << "speedup: " << std::setprecision(2) << plain_ns / memo_ns
+              << "x" << std::endl << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    // Every parenthesized search condition is first attempted as a row value
+    // constructor, which parses the value expressions and predicates inside
+    // it before failing
+    std::vector<std::string> nested = {
+        "SELECT a FROM t WHERE (a = 1 AND b = 2)",
+        "SELECT a FROM t WHERE ((a = 1 AND b = 2) OR (c = 3 AND d = 4))",
+        "SELECT a FROM t WHERE (a = 1 OR (b = 2 AND (c = 3 OR (d = 4 "
+        "AND e = 5))))",
+        "DELETE FROM t WHERE (a > 1 AND (b < 2 OR c = 'x')) AND d <> 3",
+    };
+    for (bool disable_construction : {false, true}) {
+        compare("corpus", corpus, disable_construction, iterations);
+        compare("nested", nested, disable_construction, iterations * 10);
+    }
+    return 0;
+}
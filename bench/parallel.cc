@@ -0,0 +1,163 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares parsing a large multi-statement script serially with
+// sqltoast::parse() against splitting it into statements and parsing them on
+// several threads with sqltoast::parse_parallel(). The script is made from
+// the valid inputs of the grammar test corpus repeated to around 8MB. Also
+// times sqltoast::split_statements() on its own, since it is the part of
+// parse_parallel() that isn't spread over the threads.
+//
+// Parses with up to one thread per core, doubling the number of threads each
+// time, unless a different maximum is given after the number of iterations.
+//
+// Before timing anything, checks that parse_parallel() returns the same
+// statements and errors as parse() for every corpus input and for scripts
+// made of runs of consecutive corpus inputs, valid or not. Each script is
+// also checked with a NUL byte embedded after its first input, on its own
+// and inside a simple comment, since parse() ends the input there.
+
+#include <sstream>
+#include <thread>
+
+#include <sqltoast/print.h>
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+const size_t SCRIPT_SIZE = 8 * 1024 * 1024;
+const size_t INPUTS_PER_SCRIPT = 7;
+const size_t CHECK_THREADS = 4;
+// What the NUL byte is embedded in the checked scripts as
+const std::string NUL_INSERTS[] = {
+    std::string("\0\n", 2),
+    std::string("-- \0\n", 5)
+};
+
+// Joins inputs into a script. Some corpus inputs end in a simple comment, so
+// the semicolon ending each goes on a line of its own.
+void append_statement(std::string& script, const std::string& input) {
+    script += input;
+    script += "\n;\n";
+}
+
+std::string describe(parse_result_t& res) {
+    std::ostringstream out;
+    out << lexeme_input(res.input) << res.code << std::endl;
+    if (res.code != PARSE_OK)
+        out << res.error << std::endl;
+    for (auto& stmt : res.statements)
+        out << *stmt << std::endl;
+    return out.str();
+}
+
+// Returns true if parse() and parse_parallel() agree on the input
+bool agrees(const std::string& input) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    parse_result_t serial = parse(input.data(), input.size(), opts);
+    parse_result_t parallel = parse_parallel(
+            input.data(), input.size(), opts, CHECK_THREADS);
+    if (describe(serial) == describe(parallel))
+        return true;
+    std::cerr << "parse() and parse_parallel() disagree on: " << input
+              << std::endl;
+    return false;
+}
+
+// Returns the number of inputs and scripts that parse() and
+// parse_parallel() disagree on
+size_t check_agreement(const std::vector<std::string>& inputs) {
+    size_t disagree = 0;
+    for (size_t x = 0; x < inputs.size(); x++) {
+        if (! agrees(inputs[x]))
+            disagree++;
+        std::string script;
+        for (size_t y = x; y < x + INPUTS_PER_SCRIPT && y < inputs.size(); y++)
+            append_statement(script, inputs[y]);
+        if (! agrees(script))
+            disagree++;
+        size_t after_first = inputs[x].size() + 3;
+        for (const std::string& nul : NUL_INSERTS) {
+            std::string with_nul(script);
+            with_nul.insert(after_first, nul);
+            if (! agrees(with_nul))
+                disagree++;
+        }
+    }
+    return disagree;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 5;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2)
+        max_threads = std::stoul(argv[2]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_agreement(corpus) > 0)
+        return 1;
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> valid;
+    for (const std::string& input : corpus) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_OK)
+            valid.emplace_back(input);
+    }
+    std::string script;
+    while (script.size() < SCRIPT_SIZE) {
+        for (const std::string& input : valid)
+            append_statement(script, input);
+    }
+
+    std::vector<lexeme_t> statements;
+    size_t num_statements = split_statements(
+            script.data(), script.size(), statements);
+    std::cout << num_statements << " statements, " << script.size()
+              << " bytes" << std::endl;
+    double split_ns = run_timed(iterations, [&]() {
+        statements.clear();
+        split_statements(script.data(), script.size(), statements);
+        clobber_memory();
+    });
+    report("split_statements()", split_ns, iterations * num_statements,
+           "statement");
+    std::cout << std::fixed << std::setprecision(2) << "split GB/sec: "
+              << (script.size() * iterations) / split_ns << std::endl;
+
+    double serial_ns = run_timed(iterations, [&]() {
+        parse_result_t res = parse(script.data(), script.size(), opts);
+        clobber_memory();
+    });
+    report("parse()", serial_ns, iterations * num_statements, "statement");
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        double ns = run_timed(iterations, [&]() {
+            parse_result_t res = parse_parallel(
+                    script.data(), script.size(), opts, threads);
+            clobber_memory();
+        });
+        std::string label = "parse_parallel(), " + std::to_string(threads) +
+                            " threads";
+        report(label.c_str(), ns, iterations * num_statements, "statement");
+        std::cout << std::fixed << std::setprecision(2)
+                  << "speedup over parse(): " << serial_ns / ns << "x"
+                  << std::endl;
+    }
+    return 0;
+}
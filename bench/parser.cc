@@ -0,0 +1,109 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares calling sqltoast::parse() for each input, which sets up a fresh
+// parse result every time, against a single sqltoast::parser reused for
+// every input. Each is run with the default options, with pre-tokenizing
+// and with arena allocation, over the grammar test corpus, and reports time
+// per input and heap allocations per input.
+
+#include <cstdlib>
+#include <new>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+void compare(
+        const char* label,
+        const std::vector<std::string>& inputs,
+        parse_options_t opts,
+        size_t iterations) {
+    size_t num_inputs = inputs.size() * iterations;
+    size_t oneshot_ok = 0;
+    size_t before = num_heap_allocations;
+    double oneshot_ns = run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t res = parse(input.data(), input.size(), opts);
+            oneshot_ok += (res.code == PARSE_OK);
+        }
+    });
+    size_t oneshot_allocs = num_heap_allocations - before;
+
+    parser_t p(opts);
+    size_t reused_ok = 0;
+    before = num_heap_allocations;
+    double reused_ns = run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            parse_result_t& res = p.parse(input.data(), input.size());
+            reused_ok += (res.code == PARSE_OK);
+        }
+    });
+    size_t reused_allocs = num_heap_allocations - before;
+    if (oneshot_ok != reused_ok)
+        std::cerr << label << ": parse() and parser disagree on "
+                  << "the number of valid inputs" << std::endl;
+
+    std::cout << label << std::endl;
+    report("parse()", oneshot_ns, num_inputs, "input");
+    report("parser::parse()", reused_ns, num_inputs, "input");
+    std::cout << std::fixed << std::setprecision(1)
+              << "heap allocations/input: "
+              << double(oneshot_allocs) / num_inputs << " -> "
+              << double(reused_allocs) / num_inputs
+              << ", speedup: " << std::setprecision(2)
+              << oneshot_ns / reused_ns << "x" << std::endl << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    compare("default", corpus,
+            {SQL_DIALECT_ANSI_1992, false, false, false}, iterations);
+    compare("pretokenize", corpus,
+            {SQL_DIALECT_ANSI_1992, false, true, false}, iterations);
+    compare("arena", corpus,
+            {SQL_DIALECT_ANSI_1992, false, false, true}, iterations);
+    compare("pretokenize+arena", corpus,
+            {SQL_DIALECT_ANSI_1992, false, true, true}, iterations);
+    return 0;
+}
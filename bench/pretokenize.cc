@@ -0,0 +1,175 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares parsing the grammar test corpus with the lexer tokenizing on
+// demand, which re-runs the tokenizers for every peek(), peek_from() and
+// next() call, against parsing with the input pre-tokenized once up front.
+// Reports the number of times the tokenizer chain is run per statement in
+// each mode as well as the time taken to parse the corpus.
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/context.h"
+#include "parser/error.h"
+#include "parser/lexer.h"
+#include "parser/parse.h"
+
+#include "bench.h"
+
+using namespace sqltoast;
+
+namespace {
+
+// Same loop as sqltoast::parse(), but hands back the number of times the
+// lexer ran its tokenizers, how many of those were on-demand fallbacks in
+// pre-tokenized mode, and the number of statements found
+parse_result_t parse_counted(
+        parse_input_t& subject,
+        parse_options_t& opts,
+        size_t* num_tokenize_calls,
+        size_t* num_fallback_calls,
+        size_t* num_statements) {
+    parse_result_t res;
+    res.code = PARSE_OK;
+    parse_context_t ctx(
+            res, opts, subject.data(), subject.data() + subject.size());
+    lexer_t& lex = ctx.lexer;
+    token_t& cur_tok = lex.current_token;
+
+    if (lex.cursor == lex.end) {
+        input_error(ctx, "Nothing to parse.");
+        return res;
+    }
+    cur_tok = lex.next();
+
+    while (res.code == PARSE_OK) {
+        if (cur_tok.symbol == SYMBOL_EOS)
+            break;
+        if (cur_tok.symbol == SYMBOL_SEMICOLON) {
+            cur_tok = lex.next();
+            continue;
+        }
+        if (cur_tok.is_keyword()) {
+            parse_statement(ctx);
+            *num_statements += 1;
+            continue;
+        }
+        syntax_error(ctx, "SQL statements begin with a keyword and end "
+                          "with a semicolon, but found %t.");
+    }
+    *num_tokenize_calls += lex.num_tokenize_calls;
+    // In pre-tokenized mode, every call beyond the one per stored token was
+    // made because the parser reached a position past where pre-tokenizing
+    // stopped, or the final failed attempt that stopped it
+    if (lex.pretokenized)
+        *num_fallback_calls += lex.num_tokenize_calls - lex.tokens.size();
+    return res;
+}
+
+// Checks that both modes produce the same results for the supplied inputs,
+// then reports tokenizer calls per statement and timings for each mode
+int compare(
+        const char *name,
+        std::vector<parse_input_t>& subjects,
+        size_t iterations) {
+    using namespace sqltoast_bench;
+    parse_options_t on_demand_opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    parse_options_t pretokenize_opts = {SQL_DIALECT_ANSI_1992, false, true, false};
+
+    size_t on_demand_calls = 0;
+    size_t pretokenize_calls = 0;
+    size_t fallback_calls = 0;
+    size_t num_statements = 0;
+    size_t ignored = 0;
+    for (parse_input_t& subject : subjects) {
+        parse_result_t a = parse_counted(
+                subject, on_demand_opts, &on_demand_calls, &ignored,
+                &num_statements);
+        parse_result_t b = parse_counted(
+                subject, pretokenize_opts, &pretokenize_calls, &fallback_calls,
+                &ignored);
+        if (a.code != b.code || a.error.str() != b.error.str() ||
+                a.statements.size() != b.statements.size()) {
+            std::cerr << "Mismatch between on-demand and pre-tokenized "
+                         "results for input:" << std::endl
+                      << std::string(subject.cbegin(), subject.cend())
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (num_statements == 0)
+        num_statements = 1;
+
+    std::cout << name << ": " << subjects.size() << " inputs, "
+              << num_statements << " statements" << std::endl;
+    std::cout << "tokenizer calls per statement: on-demand "
+              << std::fixed << std::setprecision(2)
+              << double(on_demand_calls) / num_statements
+              << ", pre-tokenized "
+              << double(pretokenize_calls) / num_statements
+              << " (" << double(fallback_calls) / num_statements
+              << " on demand)" << std::endl;
+
+    double on_demand_ns = run_timed(iterations, [&]() {
+        for (parse_input_t& subject : subjects)
+            parse(subject, on_demand_opts);
+    });
+    double pretokenize_ns = run_timed(iterations, [&]() {
+        for (parse_input_t& subject : subjects)
+            parse(subject, pretokenize_opts);
+    });
+
+    size_t parses = iterations * subjects.size();
+    report("on-demand tokenizing", on_demand_ns, parses, "input");
+    report("pre-tokenized", pretokenize_ns, parses, "input");
+    std::cout << "speedup: " << std::setprecision(2)
+              << on_demand_ns / pretokenize_ns << "x" << std::endl
+              << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    using namespace sqltoast_bench;
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    std::vector<parse_input_t> subjects;
+    for (const std::string& input : corpus)
+        subjects.emplace_back(input.cbegin(), input.cend());
+    if (subjects.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (compare("grammar corpus", subjects, iterations) != 0)
+        return 1;
+
+    // A single query with a number of joined tables and a long search
+    // condition, which is where the parser does most of its lookahead and
+    // backtracking
+    std::string heavy("SELECT t0.a, t0.b FROM t0 INNER JOIN t1 ON t0.a = t1.a");
+    for (int x = 2; x <= 8; x += 2) {
+        std::string l = "t" + std::to_string(x);
+        std::string r = "t" + std::to_string(x + 1);
+        heavy += ", " + l + " INNER JOIN " + r + " ON " + l + ".a = " + r + ".a";
+    }
+    heavy += " WHERE t0.a = 1";
+    for (int x = 1; x <= 32; x++) {
+        std::string n = std::to_string(x);
+        switch (x % 4) {
+            case 0: heavy += " AND t0.b > " + n; break;
+            case 1: heavy += " OR t0.c <> " + n; break;
+            case 2: heavy += " AND t0.d IN (" + n + ", " + n + "1)"; break;
+            case 3: heavy += " OR t0.e LIKE 'x" + n + "%'"; break;
+        }
+    }
+    std::vector<parse_input_t> heavy_subjects;
+    heavy_subjects.emplace_back(heavy.cbegin(), heavy.cend());
+    return compare("join and predicate heavy query", heavy_subjects, iterations * 10);
+}
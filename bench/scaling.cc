@@ -0,0 +1,135 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Measures how parsing throughput scales with the number of threads. Each
+// thread has its own sqltoast::parser and parses the whole grammar test
+// corpus over and over, so the threads share nothing but the library's
+// read-only tables. Ideally N threads get N times the throughput of one.
+//
+// For comparison, the same is done for the locale-aware case-insensitive
+// comparison keywords used to be matched with, which default-constructs a
+// std::locale for every comparison. Every construction and destruction
+// updates the reference count of the one global locale, so threads doing it
+// contend for the same cache line.
+//
+// Runs with up to one thread per core, doubling the number of threads each
+// time, unless a different maximum is given after the number of iterations.
+
+#include <algorithm>
+#include <locale>
+#include <thread>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+struct legacy_cmp_equal {
+    legacy_cmp_equal(const std::locale& loc) : loc_(loc) {}
+    bool operator()(char ch1, char ch2) {
+        return std::toupper(ch1, loc_) == std::toupper(ch2, loc_);
+    }
+private:
+    const std::locale& loc_;
+};
+
+bool legacy_equal(const std::string& a, const std::string& b,
+        const std::locale& loc = std::locale()) {
+    return (a.size() == b.size() &&
+            std::equal(a.begin(), a.end(), b.begin(), legacy_cmp_equal(loc)));
+}
+
+// Runs the supplied function on each of num_threads threads at once and
+// returns the elapsed wall time in nanoseconds
+template<typename F>
+double run_threads(size_t num_threads, F&& func) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t x = 0; x < num_threads; x++)
+        threads.emplace_back(func);
+    for (std::thread& t : threads)
+        t.join();
+    auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    return static_cast<double>(dur.count());
+}
+
+// Reports the throughput with each number of threads and how close it comes
+// to the single-threaded throughput multiplied by the number of threads
+template<typename F>
+void run_scaling(
+        const char* label,
+        size_t max_threads,
+        size_t items_per_thread,
+        const char* unit,
+        F&& func) {
+    std::cout << label << ":" << std::endl;
+    double single_rate = 0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        double ns = run_threads(threads, func);
+        size_t items = threads * items_per_thread;
+        double rate = items / (ns / 1e9);
+        if (threads == 1)
+            single_rate = rate;
+        std::string name = "  " + std::to_string(threads) + " threads";
+        report(name.c_str(), ns, items, unit);
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  scaling efficiency: "
+                  << rate / (single_rate * threads) << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 100;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2)
+        max_threads = std::stoul(argv[2]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+
+    run_scaling("parse", max_threads, corpus.size() * iterations, "input",
+        [&]() {
+            parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+            parser_t p(opts);
+            for (size_t x = 0; x < iterations; x++) {
+                for (const std::string& input : corpus) {
+                    p.parse(input.data(), input.size());
+                    clobber_memory();
+                }
+            }
+        });
+
+    // Compare each corpus input's leading word against a keyword, which is
+    // as much as the old tokenizer did for each candidate keyword
+    std::vector<std::string> words;
+    for (const std::string& input : corpus)
+        words.emplace_back(input.substr(0, input.find(' ')));
+    const std::string keyword = "SELECT";
+    size_t comparisons = words.size() * iterations * 10;
+    run_scaling("locale-aware comparison", max_threads, comparisons,
+        "comparison", [&]() {
+            size_t found = 0;
+            for (size_t x = 0; x < iterations * 10; x++) {
+                for (const std::string& word : words)
+                    found += legacy_equal(word, keyword);
+            }
+            clobber_memory();
+        });
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares loading statements with sqltoast::deserialize() against parsing
+// the SQL they came from, on a script made from the valid inputs of the
+// grammar test corpus repeated to around 1MB. Statements are loaded onto the
+// heap and into an arena, and the script is also loaded as a flat AST alone.
+// Reports time per statement, throughput in terms of the SQL's size and the
+// size of the encoding compared with the SQL.
+//
+// Before timing anything, checks for each corpus input that every truncation
+// of its encoding is rejected. The grammar tests check that the encodings
+// load back into the same statements.
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+const size_t SCRIPT_SIZE = 1024 * 1024;
+
+// Returns the number of corpus inputs with a truncated encoding that
+// deserialize() doesn't reject
+size_t check_truncations(const std::vector<std::string>& inputs) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    size_t accepted = 0;
+    for (const std::string& input : inputs) {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        if (res.code != PARSE_OK)
+            continue;
+        std::string encoded;
+        serialize(res, encoded);
+        for (size_t len = 0; len < encoded.size(); len++) {
+            if (deserialize(encoded.data(), len, opts).code == PARSE_INPUT_ERROR)
+                continue;
+            std::cerr << "truncated encoding loads: " << input << std::endl;
+            accepted++;
+            break;
+        }
+    }
+    return accepted;
+}
+
+void report_load(
+        const char* label,
+        double ns,
+        size_t num_statements,
+        size_t sql_bytes) {
+    report(label, ns, num_statements, "statement");
+    std::cout << std::fixed << std::setprecision(1)
+              << "SQL MB/sec: " << sql_bytes / (ns / 1e9) / 1e6 << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 20;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_truncations(corpus) > 0)
+        return 1;
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> valid;
+    for (const std::string& input : corpus) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_OK)
+            valid.emplace_back(input);
+    }
+    std::string script;
+    while (script.size() < SCRIPT_SIZE) {
+        for (const std::string& input : valid) {
+            script += input;
+            script += "\n;\n";
+        }
+    }
+    parse_result_t res = parse(script.data(), script.size(), opts);
+    if (res.code != PARSE_OK) {
+        std::cerr << "Failed to parse script: " << res.error << std::endl;
+        return 1;
+    }
+    size_t num_statements = res.statements.size();
+    std::string encoded;
+    serialize(res, encoded);
+    std::cout << num_statements << " statements, " << script.size()
+              << " bytes of SQL, " << encoded.size() << " bytes encoded ("
+              << std::fixed << std::setprecision(2)
+              << double(encoded.size()) / script.size() << "x)" << std::endl;
+    size_t total_statements = iterations * num_statements;
+    size_t total_bytes = iterations * script.size();
+
+    parse_options_t arena_opts = opts;
+    arena_opts.use_arena = true;
+    parse_options_t flat_opts = opts;
+    flat_opts.flat = true;
+    const parse_options_t* variants[] = {&opts, &arena_opts};
+    const char* parse_labels[] = {"parse()", "parse(), arena"};
+    const char* load_labels[] = {"deserialize()", "deserialize(), arena"};
+    for (size_t x = 0; x < 2; x++) {
+        parse_options_t o = *variants[x];
+        double ns = run_timed(iterations, [&]() {
+            parse_result_t r = parse(script.data(), script.size(), o);
+            clobber_memory();
+        });
+        report_load(parse_labels[x], ns, total_statements, total_bytes);
+        ns = run_timed(iterations, [&]() {
+            parse_result_t r = deserialize(encoded.data(), encoded.size(), o);
+            clobber_memory();
+        });
+        report_load(load_labels[x], ns, total_statements, total_bytes);
+    }
+
+    double ns = run_timed(iterations, [&]() {
+        parse_result_t r = parse(script.data(), script.size(), flat_opts);
+        clobber_memory();
+    });
+    report_load("parse(), flat", ns, total_statements, total_bytes);
+    ns = run_timed(iterations, [&]() {
+        parse_result_t r = deserialize(encoded.data(), encoded.size(), flat_opts);
+        clobber_memory();
+    });
+    report_load("deserialize(), flat", ns, total_statements, total_bytes);
+    return 0;
+}
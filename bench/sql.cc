@@ -0,0 +1,190 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares writing parsed statements out with sqltoast::to_sql(), in both
+// of its formats, against writing them to a stream with the library's
+// operator<<. The statements are those of a script made from the valid
+// inputs of the grammar test corpus repeated to around 1MB, parsed once.
+// operator<< writes to a stream that throws its output away and to_sql()
+// appends to a string that is cleared, but not shrunk, before each run.
+// Reports time per statement, output throughput and heap allocations per
+// statement.
+//
+// Before timing anything, checks that parsing the SQL to_sql() writes for
+// each corpus input gives back the same statements, by comparing the YAML
+// sqltoaster writes for them.
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#include <sqltoast/print.h>
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+#include "emit.h"
+#include "emitter.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+using namespace sqltoaster;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+const size_t SCRIPT_SIZE = 1024 * 1024;
+
+// Counts the bytes written to it and otherwise discards them
+struct null_buf : std::streambuf {
+    size_t written = 0;
+    int overflow(int c) {
+        written++;
+        return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) {
+        written += n;
+        return n;
+    }
+};
+
+std::string to_yaml(const parse_result_t& res) {
+    std::ostringstream out;
+    {
+        emitter_t em(out, EMIT_FORMAT_YAML, res.input);
+        emit(em, res);
+    }
+    return out.str();
+}
+
+// Returns the number of corpus inputs whose statements come back different
+// after being written out as SQL in the supplied format and parsed again
+size_t check_round_trip(const std::vector<std::string>& inputs, sql_format_t format) {
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    size_t differ = 0;
+    for (const std::string& input : inputs) {
+        parse_result_t res = parse(input.data(), input.size(), opts);
+        if (res.code != PARSE_OK)
+            continue;
+        std::string sql;
+        to_sql(res, sql, format);
+        parse_result_t reparsed = parse(sql.data(), sql.size(), opts);
+        if (reparsed.code == PARSE_OK && to_yaml(res) == to_yaml(reparsed))
+            continue;
+        std::cerr << "round trip through SQL changes: " << input << std::endl
+                  << "written as: " << sql << std::endl;
+        if (reparsed.code != PARSE_OK)
+            std::cerr << reparsed.error << std::endl;
+        differ++;
+    }
+    return differ;
+}
+
+void report_output(
+        const char* label,
+        double ns,
+        size_t num_statements,
+        size_t bytes,
+        size_t allocs) {
+    report(label, ns, num_statements, "statement");
+    std::cout << std::fixed << std::setprecision(1)
+              << "output MB/sec: " << bytes / (ns / 1e9) / 1e6
+              << ", heap allocations/statement: "
+              << double(allocs) / num_statements << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 20;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_round_trip(corpus, SQL_FORMAT_COMPACT) > 0 ||
+            check_round_trip(corpus, SQL_FORMAT_CANONICAL) > 0)
+        return 1;
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    std::vector<std::string> valid;
+    for (const std::string& input : corpus) {
+        if (parse(input.data(), input.size(), opts).code == PARSE_OK)
+            valid.emplace_back(input);
+    }
+    std::string script;
+    while (script.size() < SCRIPT_SIZE) {
+        for (const std::string& input : valid) {
+            script += input;
+            script += "\n;\n";
+        }
+    }
+    parse_result_t res = parse(script.data(), script.size(), opts);
+    if (res.code != PARSE_OK) {
+        std::cerr << "Failed to parse script: " << res.error << std::endl;
+        return 1;
+    }
+    size_t num_statements = res.statements.size();
+    std::cout << num_statements << " statements, " << script.size()
+              << " bytes" << std::endl;
+    size_t total_statements = iterations * num_statements;
+
+    {
+        null_buf nb;
+        std::ostream out(&nb);
+        out << lexeme_input(res.input);
+        size_t before = num_heap_allocations;
+        double ns = run_timed(iterations, [&]() {
+            for (const std::unique_ptr<statement_t>& stmt : res.statements)
+                out << *stmt << ";\n";
+            clobber_memory();
+        });
+        report_output("operator<<", ns, total_statements, nb.written,
+                      num_heap_allocations - before);
+    }
+
+    const sql_format_t formats[] = {SQL_FORMAT_COMPACT, SQL_FORMAT_CANONICAL};
+    const char* labels[] = {"to_sql(), compact", "to_sql(), canonical"};
+    for (size_t x = 0; x < 2; x++) {
+        std::string sql;
+        size_t written = 0;
+        // Let the string grow to its working size before counting
+        to_sql(res, sql, formats[x]);
+        size_t before = num_heap_allocations;
+        double ns = run_timed(iterations, [&]() {
+            sql.clear();
+            to_sql(res, sql, formats[x]);
+            written += sql.size();
+            clobber_memory();
+        });
+        report_output(labels[x], ns, total_statements, written,
+                      num_heap_allocations - before);
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Checks that sqltoast::statement_stream produces the same statements as
+// sqltoast::parse() for the grammar test corpus no matter how the input is
+// chunked, then streams a generated mysqldump-style file of INSERT
+// statements through it, reporting throughput and the most memory the
+// stream buffered at once.
+
+#include <sstream>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+
+namespace {
+
+typedef struct stream_counts {
+    size_t statements;
+    size_t errors;
+} stream_counts_t;
+
+// Feeds the supplied input through a statement stream in chunks of the
+// supplied size
+stream_counts_t stream_chunked(
+        const std::string& input,
+        parse_options_t& opts,
+        size_t chunk_size) {
+    stream_counts_t counts = {0, 0};
+    statement_stream_t stream(opts);
+    parse_result_t res;
+    size_t pos = 0;
+    while (true) {
+        if (pos < input.size()) {
+            size_t len = std::min(chunk_size, input.size() - pos);
+            stream.feed(input.data() + pos, len);
+            pos += len;
+        } else
+            stream.finish();
+        stream_status_t status;
+        while ((status = stream.next(res)) == STREAM_STATEMENT) {
+            if (res.code == PARSE_OK)
+                counts.statements += res.statements.size();
+            else
+                counts.errors++;
+        }
+        if (status == STREAM_END)
+            return counts;
+    }
+}
+
+// Generates a dump of INSERT statements of roughly the supplied size, one
+// chunk at a time, in the style of mysqldump's extended inserts
+typedef struct dump_generator {
+    size_t remaining;
+    size_t row;
+    dump_generator(size_t size) : remaining(size), row(0)
+    {}
+    bool next_chunk(std::string& chunk) {
+        chunk.clear();
+        if (remaining == 0)
+            return false;
+        if (row == 0)
+            chunk += "-- Dump of table `t1`\n-- generated; do not edit\n\n";
+        while (chunk.size() < 64 * 1024) {
+            chunk += "INSERT INTO t1 (id, name, note, amount) VALUES ";
+            for (int x = 0; x < 20; x++, row++) {
+                if (x > 0)
+                    chunk += ",";
+                chunk += "(" + std::to_string(row) + ",'name " +
+                         std::to_string(row) + "','it\\'s; not the end'," +
+                         std::to_string(row * 3) + ".25)";
+            }
+            chunk += ";\n";
+        }
+        remaining = chunk.size() >= remaining ? 0 : remaining - chunk.size();
+        return true;
+    }
+} dump_generator_t;
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    using namespace sqltoast_bench;
+    size_t dump_mb = 64;
+    if (argc > 1)
+        dump_mb = std::stoul(argv[1]);
+
+    parse_options_t opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    // Streaming each input must find the same statements as parsing it
+    // whole, and an input that fails to parse must produce an error
+    for (const std::string& input : corpus) {
+        parse_result_t expected = parse(input.data(), input.size(), opts);
+        for (size_t chunk_size : {1, 3, 7, 64, 4096}) {
+            stream_counts_t counts = stream_chunked(input, opts, chunk_size);
+            bool same;
+            if (expected.code == PARSE_OK)
+                same = (counts.errors == 0 &&
+                        counts.statements == expected.statements.size());
+            else
+                same = counts.errors > 0;
+            if (! same) {
+                std::cerr << "Mismatch streaming in " << chunk_size
+                          << " byte chunks for input:" << std::endl
+                          << input << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::cout << "corpus: " << corpus.size()
+              << " inputs streamed identically in all chunk sizes" << std::endl;
+
+    // Stream the generated dump, never holding more than a chunk of it
+    // outside of the stream
+    dump_generator_t gen(dump_mb * 1024 * 1024);
+    statement_stream_t stream(opts);
+    parse_result_t res;
+    std::string chunk;
+    size_t total_bytes = 0;
+    size_t num_statements = 0;
+    size_t num_errors = 0;
+    size_t max_buffered = 0;
+    double ns = run_timed(1, [&]() {
+        while (true) {
+            if (gen.next_chunk(chunk)) {
+                stream.feed(chunk.data(), chunk.size());
+                total_bytes += chunk.size();
+            } else
+                stream.finish();
+            max_buffered = std::max(max_buffered, stream.buffered());
+            stream_status_t status;
+            while ((status = stream.next(res)) == STREAM_STATEMENT) {
+                num_statements++;
+                if (res.code != PARSE_OK)
+                    num_errors++;
+            }
+            if (status == STREAM_END)
+                break;
+        }
+    });
+    if (num_errors > 0) {
+        std::cerr << num_errors << " statements in the dump failed to parse."
+                  << std::endl;
+        return 1;
+    }
+    std::cout << "dump: " << total_bytes << " bytes, " << num_statements
+              << " statements, at most " << max_buffered
+              << " bytes buffered" << std::endl;
+    report("streamed statements", ns, num_statements, "statement");
+    std::cout << std::setprecision(2)
+              << (total_bytes / (1024.0 * 1024.0)) / (ns / 1e9)
+              << " MB/sec" << std::endl;
+    return 0;
+}
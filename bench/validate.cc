@@ -0,0 +1,115 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+// Compares parsing the grammar test corpus into statements against only
+// checking that it is valid SQL, with statement construction disabled. Both
+// reuse a single sqltoast::parser and report time per input, throughput and
+// heap allocations per input. Validating should agree with a full parse on
+// every input, down to the error, so the two are checked against each other
+// first.
+
+#include <cstdlib>
+#include <new>
+
+#include <sqltoast/sqltoast.h>
+
+#include "bench.h"
+
+using namespace sqltoast;
+using namespace sqltoast_bench;
+
+namespace {
+
+size_t num_heap_allocations = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    num_heap_allocations++;
+    void* mem = std::malloc(size == 0 ? 1 : size);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// Returns the number of inputs that full parsing and validating disagree on
+size_t check_agreement(const std::vector<std::string>& inputs) {
+    parse_options_t full_opts = {SQL_DIALECT_ANSI_1992, false, false, false};
+    parse_options_t val_opts = {SQL_DIALECT_ANSI_1992, true, false, false};
+    parser_t full(full_opts);
+    parser_t validate(val_opts);
+    size_t disagree = 0;
+    for (const std::string& input : inputs) {
+        parse_result_t& full_res = full.parse(input.data(), input.size());
+        parse_result_t& val_res = validate.parse(input.data(), input.size());
+        if (full_res.code == val_res.code &&
+                full_res.error.str() == val_res.error.str())
+            continue;
+        std::cerr << "full parse and validation disagree on: " << input
+                  << std::endl;
+        disagree++;
+    }
+    return disagree;
+}
+
+void run(
+        const char* label,
+        const std::vector<std::string>& inputs,
+        size_t input_bytes,
+        parse_options_t opts,
+        size_t iterations) {
+    parser_t p(opts);
+    size_t num_inputs = inputs.size() * iterations;
+    size_t before = num_heap_allocations;
+    double ns = run_timed(iterations, [&]() {
+        for (const std::string& input : inputs) {
+            p.parse(input.data(), input.size());
+            clobber_memory();
+        }
+    });
+    size_t allocs = num_heap_allocations - before;
+
+    report(label, ns, num_inputs, "input");
+    std::cout << std::fixed << std::setprecision(1)
+              << "MB/sec: " << (input_bytes * iterations) / (ns / 1e9) / 1e6
+              << ", heap allocations/input: "
+              << double(allocs) / num_inputs << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t iterations = 200;
+    if (argc > 1)
+        iterations = std::stoul(argv[1]);
+
+    std::vector<std::string> corpus = load_corpus();
+    if (corpus.empty()) {
+        std::cerr << "No inputs found in corpus." << std::endl;
+        return 1;
+    }
+    if (check_agreement(corpus) > 0)
+        return 1;
+    size_t input_bytes = 0;
+    for (const std::string& input : corpus)
+        input_bytes += input.size();
+
+    run("full parse", corpus, input_bytes,
+        {SQL_DIALECT_ANSI_1992, false, false, false}, iterations);
+    run("validate only", corpus, input_bytes,
+        {SQL_DIALECT_ANSI_1992, true, false, false}, iterations);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_AST_NODE_H
+#define SQLTOAST_AST_NODE_H
+
+namespace sqltoast {
+
+// A bump-pointer allocator that AST nodes are carved out of when parsing
+// with parse_options_t::use_arena set. Memory is handed out from a list of
+// pooled blocks and is only released, all at once, when the arena is
+// destroyed.
+typedef struct arena {
+    // The number of allocations served by the arena
+    size_t num_allocations;
+    // The number of bytes handed out by the arena, including alignment
+    // padding
+    size_t bytes_allocated;
+    arena() :
+        num_allocations(0),
+        bytes_allocated(0),
+        cursor(nullptr),
+        remaining(0),
+        next_block(0)
+    {}
+    ~arena();
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    void* allocate(size_t size);
+    // Makes all of the arena's memory available for allocation again
+    // without returning any blocks to the heap. Anything previously
+    // allocated from the arena must no longer be in use.
+    void reset();
+    // Takes over all of the other arena's blocks, along with everything
+    // allocated from them, leaving the other arena empty
+    void adopt(arena& other);
+    inline size_t num_blocks() const {
+        return blocks.size();
+    }
+private:
+    typedef struct block {
+        void* mem;
+        size_t size;
+    } block_t;
+    std::vector<block_t> blocks;
+    char* cursor;
+    size_t remaining;
+    // Index of the block to carve from once the current one is exhausted
+    size_t next_block;
+} arena_t;
+
+// The base of every dynamically-allocated node in the abstract syntax tree.
+//
+// Nodes are allocated from the arena of the parse result being built when
+// parsing with parse_options_t::use_arena set, and from the heap otherwise.
+// Deleting a node only returns its memory to the heap if it came from the
+// heap; arena memory is reclaimed when the owning parse result is
+// destroyed. The virtual destructor ensures that deleting a node through a
+// pointer to its base type destroys the whole node.
+typedef struct ast_node {
+    virtual ~ast_node() {}
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+} ast_node_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_AST_NODE_H */
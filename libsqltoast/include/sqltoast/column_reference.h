@@ -19,18 +19,18 @@ typedef struct derived_column {
         value(std::move(ve))
     {}
     inline bool has_alias() const {
-        return alias.start != parse_position_t(0);
+        return bool(alias);
     }
 } derived_column_t;
 
 typedef struct grouping_column_reference {
     lexeme_t column;
     lexeme_t collation;
-    grouping_column_reference(lexeme_t& column) :
+    grouping_column_reference(const lexeme_t& column) :
         column(column)
     {}
     inline bool has_collation() const {
-        return collation.start != parse_position_t(0);
+        return bool(collation);
     }
 } grouping_column_reference_t;
 
@@ -18,7 +18,7 @@ typedef enum constraint_type {
     CONSTRAINT_TYPE_CHECK
 } constraint_type_t;
 
-typedef struct constraint {
+typedef struct constraint : ast_node_t {
     constraint_type_t type;
     lexeme_t name;
     std::vector<lexeme_t> columns;
@@ -27,7 +27,7 @@ typedef enum data_type {
     DATA_TYPE_INTERVAL
 } data_type_t;
 
-typedef struct data_type_descriptor {
+typedef struct data_type_descriptor : ast_node_t {
     data_type_t type;
     data_type_descriptor(data_type_t type) : type(type)
     {}
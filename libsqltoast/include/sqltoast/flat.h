@@ -0,0 +1,319 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_FLAT_H
+#define SQLTOAST_FLAT_H
+
+namespace sqltoast {
+
+// A flat AST stores the nodes of one or more statements in parallel arrays
+// instead of a tree of separately-allocated structs. Node N's type, role,
+// values, lexeme and links to its relatives are the Nth elements of the
+// arrays below. Children are referred to by 32-bit index, and lexemes are
+// the same offsets into the parsed input as the tree's lexemes.
+//
+// Nodes are stored in pre-order, so a node's descendants directly follow it
+// and each node's parent has a lower index. Analyzers that only care about
+// one kind of node can scan the types array from start to finish without
+// following a single pointer, and emptying a flat AST is a matter of
+// clearing a handful of vectors of integers.
+typedef uint32_t flat_index_t;
+
+// Marks a missing parent, child or sibling
+const flat_index_t FLAT_NONE = UINT32_MAX;
+
+// The kind of a flat node. For each, the comment describes what the node's
+// value, param and param2 hold, what its lexeme is and which children it
+// may have. Nodes that mirror an AST struct with a type or op field store
+// that field's enum in value. Children are listed by their role.
+typedef enum flat_node_type {
+    // value: statement_type_t
+    // CREATE SCHEMA: lexeme is the schema name; AUTHORIZATION and CHARSET
+    //   NAME children
+    // CREATE TABLE: lexeme is the table name; param is the table_type_t;
+    //   COLUMN_DEFINITION and CONSTRAINT children
+    // ALTER TABLE: lexeme is the table name; an ALTER_TABLE_ACTION child
+    // DROP SCHEMA/TABLE/VIEW: lexeme is the object name; param is the
+    //   drop_behaviour_t
+    // CREATE VIEW: lexeme is the view name; param is the check_option_t;
+    //   COLUMN NAME children and a QUERY child
+    // SELECT: a QUERY_SPECIFICATION child
+    // INSERT: lexeme is the table name; COLUMN NAME children and a QUERY
+    //   child unless inserting DEFAULT VALUES
+    // DELETE: lexeme is the table name; an optional WHERE child
+    // UPDATE: lexeme is the table name; SET_COLUMN children and an optional
+    //   WHERE child
+    // GRANT: lexeme is the object granted on; param is the
+    //   grant_object_type_t; FLAT_FLAG_WITH_GRANT_OPTION; GRANT_ACTION
+    //   children (none for ALL PRIVILEGES) and a GRANTEE NAME child (none for
+    //   PUBLIC)
+    FLAT_NODE_TYPE_STATEMENT,
+    // value: alter_table_action_type_t
+    // ADD COLUMN: a COLUMN_DEFINITION child
+    // ALTER COLUMN: lexeme is the column name; param is the
+    //   alter_column_action_type_t; an optional DEFAULT child
+    // DROP COLUMN/CONSTRAINT: lexeme is the column or constraint name; param
+    //   is the drop_behaviour_t
+    // ADD CONSTRAINT: a CONSTRAINT child
+    FLAT_NODE_TYPE_ALTER_TABLE_ACTION,
+    // lexeme is the column name; DATA_TYPE, optional DEFAULT, CONSTRAINT and
+    // optional COLLATION NAME children
+    FLAT_NODE_TYPE_COLUMN_DEFINITION,
+    // value: data_type_t
+    // param is the size of character and bit strings and the precision of
+    // numeric, datetime and interval types. param2 is the scale of exact
+    // numerics and the interval_unit_t of intervals. FLAT_FLAG_WITH_TZ for
+    // datetimes. Character strings may have a CHARSET NAME child.
+    FLAT_NODE_TYPE_DATA_TYPE,
+    // value: default_type_t; lexeme is the literal; param is the precision
+    FLAT_NODE_TYPE_DEFAULT,
+    // value: constraint_type_t; lexeme is the constraint name; COLUMN NAME
+    // children. Foreign keys have param set to the match_type_t, a
+    // REFERENCED_TABLE NAME child, REFERENCED_COLUMN NAME children and
+    // ON_UPDATE and ON_DELETE REFERENTIAL_ACTION children.
+    FLAT_NODE_TYPE_CONSTRAINT,
+    // value: referential_action_t
+    FLAT_NODE_TYPE_REFERENTIAL_ACTION,
+    // value: grant_action_type_t; COLUMN NAME children
+    FLAT_NODE_TYPE_GRANT_ACTION,
+    // value: set_column_type_t; lexeme is the column name; a VALUE_EXPRESSION
+    // child when setting the column to a value expression
+    FLAT_NODE_TYPE_SET_COLUMN,
+    // value: query_expression_type_t
+    // A QUERY_SPECIFICATION or TABLE_VALUE_CONSTRUCTOR child, or for a
+    // joined table, a TABLE_REFERENCE child
+    FLAT_NODE_TYPE_QUERY_EXPRESSION,
+    // ROW_VALUE_CONSTRUCTOR children
+    FLAT_NODE_TYPE_TABLE_VALUE_CONSTRUCTOR,
+    // FLAT_FLAG_DISTINCT; DERIVED_COLUMN children and a TABLE_EXPRESSION
+    // child
+    FLAT_NODE_TYPE_QUERY_SPECIFICATION,
+    // lexeme is the alias; FLAT_FLAG_STAR for the asterisk projection and
+    // otherwise a VALUE_EXPRESSION child
+    FLAT_NODE_TYPE_DERIVED_COLUMN,
+    // TABLE_REFERENCE children, an optional WHERE child, GROUPING_COLUMN
+    // children and an optional HAVING child
+    FLAT_NODE_TYPE_TABLE_EXPRESSION,
+    // lexeme is the column; an optional COLLATION NAME child
+    FLAT_NODE_TYPE_GROUPING_COLUMN,
+    // value: table_reference_type_t
+    // Tables have the table name as their lexeme and an optional ALIAS NAME
+    // child. Derived tables have their correlation name as their lexeme and
+    // a QUERY child. Either may have COLUMN NAME children naming correlated
+    // columns and a JOIN child.
+    FLAT_NODE_TYPE_TABLE_REFERENCE,
+    // value: join_type_t; a TABLE_REFERENCE child and either an ON child or
+    // COLUMN NAME children for a USING clause
+    FLAT_NODE_TYPE_JOIN,
+    // BOOLEAN_TERM children that are OR'd together
+    FLAT_NODE_TYPE_SEARCH_CONDITION,
+    // BOOLEAN_FACTOR children that are AND'd together
+    FLAT_NODE_TYPE_BOOLEAN_TERM,
+    // FLAT_FLAG_NOT; a PREDICATE or a parenthesized SEARCH_CONDITION child
+    FLAT_NODE_TYPE_BOOLEAN_FACTOR,
+    // value: predicate_type_t; FLAT_FLAG_NOT for negated predicates
+    // Comparisons have param set to the comp_op_t and LEFT and RIGHT
+    // children. BETWEEN has LEFT, LOWER and UPPER children. LIKE has LEFT,
+    // PATTERN and an optional ESCAPE child. IS NULL has a LEFT child. IN
+    // has a LEFT child and either VALUE children or a QUERY child. Quantified
+    // comparisons have param set to the comp_op_t, param2 to the
+    // quantifier_t, and LEFT and QUERY children. EXISTS and UNIQUE have a
+    // QUERY child. MATCH has FLAT_FLAG_MATCH_UNIQUE and
+    // FLAT_FLAG_MATCH_PARTIAL and LEFT and QUERY children. OVERLAPS has LEFT
+    // and RIGHT children.
+    FLAT_NODE_TYPE_PREDICATE,
+    // value: rvc_type_t; param: rvc_element_type_t for elements
+    // Value expression elements have a VALUE_EXPRESSION child and lists
+    // have ROW_VALUE_CONSTRUCTOR children
+    FLAT_NODE_TYPE_ROW_VALUE_CONSTRUCTOR,
+    // value: value_expression_type_t
+    // Numeric expressions have param set to the numeric_op_t and LEFT and
+    // optional RIGHT NUMERIC_TERM children. String expressions have
+    // CHARACTER_FACTOR children that are concatenated. Datetime expressions
+    // have param set to the numeric_op_t, a LEFT DATETIME_FACTOR child and
+    // an optional RIGHT INTERVAL_TERM child. Interval expressions have
+    // param set to the numeric_op_t and LEFT and optional RIGHT
+    // INTERVAL_TERM children.
+    FLAT_NODE_TYPE_VALUE_EXPRESSION,
+    // param: numeric_op_t; LEFT and optional RIGHT NUMERIC_FACTOR children
+    FLAT_NODE_TYPE_NUMERIC_TERM,
+    // FLAT_FLAG_NEGATIVE or FLAT_FLAG_POSITIVE when signed; a
+    // VALUE_EXPRESSION_PRIMARY or NUMERIC_FUNCTION child
+    FLAT_NODE_TYPE_NUMERIC_FACTOR,
+    // value: numeric_function_type_t
+    // POSITION has OPERAND and SUBJECT children. EXTRACT has param set to
+    // the interval_unit_t extracted and an OPERAND child. The length
+    // functions have an OPERAND child.
+    FLAT_NODE_TYPE_NUMERIC_FUNCTION,
+    // value: vep_type_t; lexeme is the primary's lexeme
+    // Unsigned value specifications have param set to the uvs_type_t. Set
+    // functions have param set to the set_function_type_t,
+    // FLAT_FLAG_STAR, FLAT_FLAG_DISTINCT and an OPERAND child unless they
+    // are COUNT(*). CASE expressions have param set to the
+    // case_expression_type_t. COALESCE has VALUE children. NULLIF has LEFT
+    // and RIGHT children. Simple CASE has an OPERAND child. Both kinds of
+    // CASE have CASE_WHEN children and an optional ELSE child. Scalar
+    // subqueries have a QUERY child and parenthesized value expressions a
+    // VALUE_EXPRESSION child.
+    FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY,
+    // A WHEN child that is a VALUE_EXPRESSION in a simple CASE or a
+    // SEARCH_CONDITION in a searched CASE, and a RESULT child
+    FLAT_NODE_TYPE_CASE_WHEN,
+    // value: string_function_type_t; an OPERAND child
+    // SUBSTRING has a START child and an optional LENGTH child. CONVERT and
+    // TRANSLATE have the conversion or translation name as their lexeme.
+    // TRIM has param set to the trim_specification_t and an optional
+    // TRIM_CHARACTER child.
+    FLAT_NODE_TYPE_STRING_FUNCTION,
+    // lexeme is the collation; a VALUE_EXPRESSION_PRIMARY or STRING_FUNCTION
+    // child
+    FLAT_NODE_TYPE_CHARACTER_FACTOR,
+    // lexeme is the time zone, which is empty for the local time zone; a
+    // VALUE_EXPRESSION_PRIMARY or DATETIME_FUNCTION child
+    FLAT_NODE_TYPE_DATETIME_FACTOR,
+    // value: datetime_function_type_t; param is the precision
+    FLAT_NODE_TYPE_DATETIME_FUNCTION,
+    // param: numeric_op_t; a LEFT INTERVAL_FACTOR child and an optional RIGHT
+    // NUMERIC_FACTOR child
+    FLAT_NODE_TYPE_INTERVAL_TERM,
+    // FLAT_FLAG_NEGATIVE or FLAT_FLAG_POSITIVE when signed; a
+    // VALUE_EXPRESSION_PRIMARY child and an optional INTERVAL_QUALIFIER child
+    FLAT_NODE_TYPE_INTERVAL_FACTOR,
+    // START and optional END DATETIME_FIELD children
+    FLAT_NODE_TYPE_INTERVAL_QUALIFIER,
+    // value: interval_unit_t; param is the precision and param2 the
+    // fractional precision
+    FLAT_NODE_TYPE_DATETIME_FIELD,
+    // A name or other lexeme belonging to the parent node, such as an alias
+    // or one of a list of column names. The role says which.
+    FLAT_NODE_TYPE_NAME
+} flat_node_type_t;
+
+// The part a node plays in its parent
+typedef enum flat_role {
+    FLAT_ROLE_NONE,
+    FLAT_ROLE_LEFT,
+    FLAT_ROLE_RIGHT,
+    FLAT_ROLE_LOWER,
+    FLAT_ROLE_UPPER,
+    FLAT_ROLE_PATTERN,
+    FLAT_ROLE_ESCAPE,
+    FLAT_ROLE_OPERAND,
+    FLAT_ROLE_SUBJECT,
+    FLAT_ROLE_VALUE,
+    FLAT_ROLE_START,
+    FLAT_ROLE_END,
+    FLAT_ROLE_LENGTH,
+    FLAT_ROLE_TRIM_CHARACTER,
+    FLAT_ROLE_WHEN,
+    FLAT_ROLE_RESULT,
+    FLAT_ROLE_ELSE,
+    FLAT_ROLE_WHERE,
+    FLAT_ROLE_HAVING,
+    FLAT_ROLE_ON,
+    FLAT_ROLE_QUERY,
+    FLAT_ROLE_ALIAS,
+    FLAT_ROLE_COLUMN,
+    FLAT_ROLE_COLLATION,
+    FLAT_ROLE_CHARSET,
+    FLAT_ROLE_AUTHORIZATION,
+    FLAT_ROLE_GRANTEE,
+    FLAT_ROLE_REFERENCED_TABLE,
+    FLAT_ROLE_REFERENCED_COLUMN,
+    FLAT_ROLE_ON_UPDATE,
+    FLAT_ROLE_ON_DELETE
+} flat_role_t;
+
+// Boolean attributes of a flat node
+typedef enum flat_flag {
+    FLAT_FLAG_NOT = 1 << 0,
+    FLAT_FLAG_DISTINCT = 1 << 1,
+    FLAT_FLAG_STAR = 1 << 2,
+    FLAT_FLAG_NEGATIVE = 1 << 3,
+    FLAT_FLAG_WITH_TZ = 1 << 4,
+    FLAT_FLAG_WITH_GRANT_OPTION = 1 << 5,
+    FLAT_FLAG_MATCH_UNIQUE = 1 << 6,
+    FLAT_FLAG_MATCH_PARTIAL = 1 << 7,
+    FLAT_FLAG_POSITIVE = 1 << 8
+} flat_flag_t;
+
+typedef struct flat_ast {
+    // The start of the input that lexeme offsets are relative to
+    parse_position_t input;
+    // The index of the root node of each statement, in the order the
+    // statements appear in the input
+    std::vector<flat_index_t> statements;
+    std::vector<uint8_t> types;
+    std::vector<uint8_t> roles;
+    std::vector<uint16_t> flags;
+    std::vector<uint32_t> values;
+    std::vector<uint32_t> params;
+    std::vector<uint32_t> params2;
+    std::vector<flat_index_t> parents;
+    std::vector<flat_index_t> first_children;
+    std::vector<flat_index_t> next_siblings;
+    std::vector<lexeme_t> lexemes;
+    flat_ast() : input(nullptr)
+    {}
+    inline size_t size() const {
+        return types.size();
+    }
+    inline flat_node_type_t type(flat_index_t node) const {
+        return flat_node_type_t(types[node]);
+    }
+    inline flat_role_t role(flat_index_t node) const {
+        return flat_role_t(roles[node]);
+    }
+    inline bool has_flag(flat_index_t node, flat_flag_t flag) const {
+        return (flags[node] & flag) != 0;
+    }
+    inline const lexeme_t& lexeme(flat_index_t node) const {
+        return lexemes[node];
+    }
+    // Returns the first child of the supplied node playing the supplied
+    // role, or FLAT_NONE if there isn't one
+    flat_index_t child(flat_index_t node, flat_role_t role) const;
+    // Forgets every node while keeping the arrays' memory for reuse
+    void clear();
+} flat_ast_t;
+
+// Appends the nodes of the supplied statement, which must have been parsed
+// from the input starting at input_start, to the flat AST and returns the
+// index of the statement's root node
+flat_index_t flatten(
+        const statement_t& stmt,
+        parse_position_t input_start,
+        flat_ast_t& out);
+
+// Rebuilds the statement rooted at the supplied node of the flat AST, the
+// reverse of flatten(). Returns false if the nodes don't describe a
+// statement that flatten() could have produced.
+bool unflatten(
+        const flat_ast_t& ast,
+        flat_index_t root,
+        std::unique_ptr<statement_t>& out);
+
+// Receives the nodes of a flat AST in pre-order from walk(). enter() is
+// called when a node is reached and may return false to skip the node's
+// descendants. leave() is called once all of a node's descendants have been
+// visited, including when they were skipped.
+typedef struct flat_visitor {
+    virtual ~flat_visitor() {}
+    virtual bool enter(const flat_ast_t&, flat_index_t) {
+        return true;
+    }
+    virtual void leave(const flat_ast_t&, flat_index_t)
+    {}
+} flat_visitor_t;
+
+// Walks the subtree rooted at the supplied node. The walk follows the
+// child and sibling links without recursing, so it uses the same amount of
+// native stack however deep the tree is.
+void walk(const flat_ast_t& ast, flat_index_t root, flat_visitor_t& visitor);
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_FLAT_H */
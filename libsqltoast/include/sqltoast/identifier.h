@@ -11,7 +11,8 @@ namespace sqltoast {
 
 typedef struct identifier {
     const std::string name;
-    identifier(lexeme_t& lexeme) : name(lexeme.start, lexeme.end)
+    identifier(const lexeme_t& lexeme, parse_position_t input) :
+        name(lexeme.str(input))
     {}
 } identifier_t;
 
@@ -11,32 +11,103 @@ namespace sqltoast {
 
 typedef std::vector<char> parse_input_t;
 
-typedef parse_input_t::const_iterator parse_position_t;
+// A position within the SQL being parsed. Positions point directly into the
+// caller's buffer; the parser never copies the input.
+typedef const char* parse_position_t;
 
-// A lexeme_t demarcates some word or phrase within the tokenized input stream
+// Marks a lexeme_t that doesn't demarcate anything, such as the alias of a
+// table that wasn't given one
+const uint32_t LEXEME_NONE = UINT32_MAX;
+
+// A lexeme_t demarcates some word or phrase within the parsed input. It is
+// stored as the phrase's offset from the start of the input and its length,
+// which keeps it to eight bytes in every AST node that has a name, alias,
+// literal or the like. The input is parse_result_t::input, and start(),
+// end() and str() get at the phrase within it.
 typedef struct lexeme {
-    parse_position_t start;
-    parse_position_t end;
-    lexeme() :start(0), end(0)
+    uint32_t offset;
+    uint32_t length;
+    lexeme() : offset(LEXEME_NONE), length(0)
     {}
     lexeme(
-        parse_position_t start,
-        parse_position_t end) :
-        start(start), end(end)
+        uint32_t offset,
+        uint32_t length) :
+        offset(offset), length(length)
     {}
     inline size_t size() const {
-        return end - start;
+        return length;
     }
     inline operator bool() const {
-        return start != parse_position_t(0);
+        return offset != LEXEME_NONE;
+    }
+    inline parse_position_t start(parse_position_t input) const {
+        return input + offset;
+    }
+    inline parse_position_t end(parse_position_t input) const {
+        return input + offset + length;
+    }
+    inline std::string str(parse_position_t input) const {
+        return std::string(input + offset, length);
     }
 } lexeme_t;
 
-inline std::ostream& operator<< (std::ostream& out, const lexeme_t& word) {
-    out << std::string(word.start, word.end);
+// A lexeme doesn't record the input it refers to, so a lexeme is written to
+// a stream as its text with lexeme_text(), which is given the input:
+//
+//   std::cout << sqltoast::lexeme_text(stmt.table_name, res.input);
+//
+// or the stream the input has been set on with lexeme_input(), below.
+typedef struct lexeme_text {
+    const lexeme_t& lexeme;
+    parse_position_t input;
+    lexeme_text(const lexeme_t& lexeme, parse_position_t input) :
+        lexeme(lexeme), input(input)
+    {}
+    inline lexeme_text(const lexeme_t& lexeme, std::ostream& out);
+} lexeme_text_t;
+
+// A lexeme can't be written to a stream on its own, since there's no input
+// to look its text up in
+std::ostream& operator<< (std::ostream& out, const lexeme_t& word) = delete;
+
+// AST nodes written to a stream look their lexemes up in the input most
+// recently set on the stream with lexeme_input():
+//
+//   std::cout << sqltoast::lexeme_input(res.input) << *res.statements[0];
+//
+// A lexeme of an AST node written to a stream without an input is written
+// as its offset and length.
+typedef struct lexeme_input {
+    parse_position_t input;
+    explicit lexeme_input(parse_position_t input) : input(input)
+    {}
+} lexeme_input_t;
+
+// Returns the index of the stream's pword() that holds its lexeme input
+inline int lexeme_input_index() {
+    static const int index = std::ios_base::xalloc();
+    return index;
+}
+
+inline std::ostream& operator<< (std::ostream& out, const lexeme_input_t& li) {
+    out.pword(lexeme_input_index()) = const_cast<char*>(li.input);
+    return out;
+}
+
+inline lexeme_text::lexeme_text(const lexeme_t& lexeme, std::ostream& out) :
+    lexeme(lexeme),
+    input(static_cast<parse_position_t>(out.pword(lexeme_input_index())))
+{}
+
+inline std::ostream& operator<< (std::ostream& out, const lexeme_text_t& text) {
+    const lexeme_t& word = text.lexeme;
+    if (text.input == nullptr)
+        out << '@' << word.offset << '+' << word.length;
+    else
+        out.write(word.start(text.input), word.length);
     return out;
 }
 
 } // namespace sqltoast
 
-#endif /* SQLTOAST_STATEMENT_H */
+#endif /* SQLTOAST_LEXEME_H */
@@ -25,7 +25,7 @@ typedef enum predicate_type {
     PREDICATE_TYPE_OVERLAPS
 } predicate_type_t;
 
-typedef struct predicate {
+typedef struct predicate : ast_node_t {
     predicate_type_t predicate_type;
     predicate(predicate_type_t pred_type) :
         predicate_type(pred_type)
@@ -215,7 +215,7 @@ typedef struct overlaps_predicate : predicate_t {
 // predicate or a complex IN (<subquery>) predicate or it could be a pointer to
 // another search_condition_t
 struct search_condition;
-typedef struct boolean_primary {
+typedef struct boolean_primary : ast_node_t {
     std::unique_ptr<predicate_t> predicate;
     std::unique_ptr<struct search_condition> search_condition;
     boolean_primary(std::unique_ptr<predicate_t>& predicate) :
@@ -229,7 +229,7 @@ typedef struct boolean_primary {
 // A boolean factor is anything that evaluates to a boolean. This could be a
 // simple comparison predicate or a complex IN (<subquery>) predicate or it
 // could be a pointer to another search_condition_t
-typedef struct boolean_factor {
+typedef struct boolean_factor : ast_node_t {
     bool reverse_op;
     std::unique_ptr<boolean_primary_t> primary;
     boolean_factor(std::unique_ptr<boolean_primary_t>& primary, bool reverse_op) :
@@ -238,12 +238,19 @@ typedef struct boolean_factor {
     {}
 } boolean_factor_t;
 
-typedef struct boolean_term {
+typedef struct boolean_term : ast_node_t {
     std::unique_ptr<boolean_factor_t> factor;
     std::unique_ptr<boolean_term> and_operand;
     boolean_term(std::unique_ptr<boolean_factor_t>& factor) :
         factor(std::move(factor))
     {}
+    // Unlinks the chain of AND'd terms one at a time so that destroying a
+    // long chain does not recurse once per term
+    ~boolean_term() {
+        std::unique_ptr<boolean_term> next = std::move(and_operand);
+        while (next)
+            next = std::move(next->and_operand);
+    }
     inline boolean_term* and_(std::unique_ptr<boolean_factor_t>& and_factor) {
         boolean_term* next_term = this;
         while (next_term->and_operand)
@@ -255,7 +262,7 @@ typedef struct boolean_term {
 
 // A container for processing boolean terms found in WHERE and HAVING clause
 // conditions
-typedef struct search_condition {
+typedef struct search_condition : ast_node_t {
     // A collection of boolean terms that are OR'd together
     std::vector<std::unique_ptr<boolean_term_t>> terms;
 } search_condition_t;
@@ -30,6 +30,11 @@ std::ostream& operator<< (std::ostream& out, const interval_unit_t& unit);
 std::ostream& operator<< (std::ostream& out, const not_null_constraint_t& constraint);
 std::ostream& operator<< (std::ostream& out, const unique_constraint_t& constraint);
 
+/* flat AST */
+std::ostream& operator<< (std::ostream& out, const flat_ast_t& ast);
+std::ostream& operator<< (std::ostream& out, const flat_node_type_t& type);
+std::ostream& operator<< (std::ostream& out, const flat_role_t& role);
+
 /*  predicates */
 std::ostream& operator<< (std::ostream& out, const between_predicate_t& pred);
 std::ostream& operator<< (std::ostream& out, const boolean_factor_t& bf);
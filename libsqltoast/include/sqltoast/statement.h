@@ -26,7 +26,7 @@ typedef enum statement_type {
     STATEMENT_TYPE_UPDATE
 } statement_type_t;
 
-typedef struct statement {
+typedef struct statement : ast_node_t {
     statement_type_t type;
     statement(statement_type_t type) : type(type)
     {}
@@ -105,7 +105,7 @@ typedef enum alter_table_action_type {
     ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT
 } alter_table_action_type_t;
 
-typedef struct alter_table_action {
+typedef struct alter_table_action : ast_node_t {
     alter_table_action_type_t type;
     alter_table_action(alter_table_action_type_t type) :
         type(type)
@@ -312,7 +312,7 @@ typedef enum grant_action_type {
     GRANT_ACTION_TYPE_USAGE
 } grant_action_type_t;
 
-typedef struct grant_action {
+typedef struct grant_action : ast_node_t {
     grant_action_type_t type;
     grant_action(grant_action_type_t type) :
         type(type)
@@ -12,7 +12,7 @@ namespace sqltoast {
 // A correlation specification is the parse element that indicates a table
 // reference's alias (technically called a "correlation name") and the optional
 // list of correlated column names.
-typedef struct correlation_spec {
+typedef struct correlation_spec : ast_node_t {
     lexeme_t alias;
     std::vector<lexeme_t> columns;
     correlation_spec(lexeme_t& alias) :
@@ -37,7 +37,7 @@ typedef enum join_type {
     JOIN_TYPE_UNION
 } join_type_t;
 
-typedef struct join_specification {
+typedef struct join_specification : ast_node_t {
     std::unique_ptr<search_condition_t> condition;
     std::vector<lexeme_t> named_columns;
     join_specification()
@@ -50,7 +50,7 @@ typedef struct join_specification {
     {}
 } join_specification_t;
 
-typedef struct join_target {
+typedef struct join_target : ast_node_t {
     join_type_t join_type;
     std::unique_ptr<struct table_reference> table_ref;
     std::unique_ptr<join_specification_t> join_spec;
@@ -82,7 +82,7 @@ typedef enum table_reference_type_t {
     TABLE_REFERENCE_TYPE_DERIVED_TABLE
 } table_reference_type_t;
 
-typedef struct table_reference {
+typedef struct table_reference : ast_node_t {
     table_reference_type_t type;
     std::unique_ptr<join_target_t> joined;
     table_reference(table_reference_type_t type) :
@@ -21,7 +21,7 @@ typedef enum vep_type {
     VEP_TYPE_CAST_SPECIFICATION
 } vep_type_t;
 
-typedef struct value_expression_primary {
+typedef struct value_expression_primary : ast_node_t {
     vep_type_t vep_type;
     lexeme_t lexeme;
     value_expression_primary(
@@ -41,6 +41,8 @@ typedef enum uvs_type {
     UVS_TYPE_NATIONAL_CHARACTER_STRING,
     UVS_TYPE_BIT_STRING,
     UVS_TYPE_HEX_STRING,
+    // Datetime and interval literal lexemes span both the keyword and the
+    // string, e.g. DATE '2020-01-01'
     UVS_TYPE_DATETIME,
     UVS_TYPE_INTERVAL,
     UVS_TYPE_PARAMETER,
@@ -225,7 +227,7 @@ typedef enum numeric_primary_type {
     NUMERIC_PRIMARY_TYPE_FUNCTION
 } numeric_primary_type_t;
 
-typedef struct numeric_primary {
+typedef struct numeric_primary : ast_node_t {
     numeric_primary_type_t type;
     numeric_primary(numeric_primary_type_t type) :
         type(type)
@@ -295,11 +297,11 @@ typedef struct length_expression : numeric_function_t {
     {}
 } length_expression_t;
 
-typedef struct numeric_factor {
+typedef struct numeric_factor : ast_node_t {
     int8_t sign;
     std::unique_ptr<numeric_primary_t> primary;
     numeric_factor(std::unique_ptr<numeric_primary_t>& primary, int8_t sign) :
-        sign(0),
+        sign(sign),
         primary(std::move(primary))
     {}
 } numeric_factor_t;
@@ -312,7 +314,7 @@ typedef enum numeric_op {
     NUMERIC_OP_DIVIDE
 } numeric_op_t;
 
-typedef struct numeric_term {
+typedef struct numeric_term : ast_node_t {
     std::unique_ptr<numeric_factor_t> left;
     numeric_op_t op;
     std::unique_ptr<numeric_factor_t> right;
@@ -340,7 +342,7 @@ typedef enum string_function_type {
 } string_function_type_t;
 
 struct value_expression;
-typedef struct string_function {
+typedef struct string_function : ast_node_t {
     string_function_type_t type;
     // Guaranteed to be static_castable to a character_value_expression_t
     std::unique_ptr<struct value_expression> operand;
@@ -414,7 +416,7 @@ typedef struct trim_function : string_function_t {
 } trim_function_t;
 
 // A character primary is a value expression primary or a string value function
-typedef struct character_primary {
+typedef struct character_primary : ast_node_t {
     std::unique_ptr<value_expression_primary_t> value;
     std::unique_ptr<string_function_t> string_function;
     character_primary(
@@ -428,7 +430,7 @@ typedef struct character_primary {
 } character_primary_t;
 
 // A character factor is a character primary with an optional collation.
-typedef struct character_factor {
+typedef struct character_factor : ast_node_t {
     std::unique_ptr<character_primary_t> primary;
     lexeme_t collation;
     character_factor(
@@ -446,7 +448,7 @@ typedef enum datetime_primary_type {
     DATETIME_PRIMARY_TYPE_FUNCTION
 } datetime_primary_type_t;
 
-typedef struct datetime_primary {
+typedef struct datetime_primary : ast_node_t {
     datetime_primary_type_t type;
     datetime_primary(datetime_primary_type_t type) :
         type(type)
@@ -487,7 +489,7 @@ typedef struct current_datetime_function : datetime_function_t {
 
 // A datetime factor evaluates to a datetime value. It contains a datetime
 // primary and has an optional timezone component.
-typedef struct datetime_factor {
+typedef struct datetime_factor : ast_node_t {
     std::unique_ptr<datetime_primary_t> primary;
     lexeme_t tz;
     datetime_factor(
@@ -501,14 +503,14 @@ typedef struct datetime_factor {
     }
 } datetime_factor_t;
 
-typedef struct datetime_term {
+typedef struct datetime_term : ast_node_t {
     std::unique_ptr<datetime_factor_t> value;
     datetime_term(std::unique_ptr<datetime_factor_t>& value) :
         value(std::move(value))
     {}
 } datetime_term_t;
 
-typedef struct datetime_field {
+typedef struct datetime_field : ast_node_t {
     interval_unit_t interval;
     size_t precision;
     size_t fractional_precision;
@@ -522,7 +524,7 @@ typedef struct datetime_field {
     {}
 } datetime_field_t;
 
-typedef struct interval_qualifier {
+typedef struct interval_qualifier : ast_node_t {
     datetime_field_t start;
     std::unique_ptr<datetime_field_t> end;
     interval_qualifier(
@@ -543,7 +545,7 @@ typedef struct interval_qualifier {
     {}
 } interval_qualifier_t;
 
-typedef struct interval_primary {
+typedef struct interval_primary : ast_node_t {
     std::unique_ptr<value_expression_primary_t> value;
     std::unique_ptr<interval_qualifier_t> qualifier;
     interval_primary(
@@ -554,7 +556,7 @@ typedef struct interval_primary {
     {}
 } interval_primary_t;
 
-typedef struct interval_factor {
+typedef struct interval_factor : ast_node_t {
     int8_t sign;
     std::unique_ptr<interval_primary_t> primary;
     interval_factor(
@@ -565,7 +567,7 @@ typedef struct interval_factor {
     {}
 } interval_factor_t;
 
-typedef struct interval_term {
+typedef struct interval_term : ast_node_t {
     std::unique_ptr<interval_factor_t> left;
     // Operating on an interval term with a numeric factor results in an
     // interval term
@@ -22,7 +22,7 @@ typedef enum value_expression_type {
     VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION,
 } value_expression_type_t;
 
-typedef struct value_expression {
+typedef struct value_expression : ast_node_t {
     value_expression_type_t type;
     value_expression(value_expression_type_t ve_type) :
         type(ve_type)
@@ -133,7 +133,7 @@ typedef enum rvc_type {
 // lists deduce to multiple values. Examples of where row-value constructors
 // can be found in the SQL grammar include either or both sides of a predicate
 // expression or the contents of the VALUES clause
-typedef struct row_value_constructor {
+typedef struct row_value_constructor : ast_node_t {
     rvc_type_t rvc_type;
     row_value_constructor(rvc_type_t rvc_type) : rvc_type(rvc_type)
     {}
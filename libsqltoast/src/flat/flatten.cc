@@ -0,0 +1,846 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <sqltoast/sqltoast.h>
+
+namespace sqltoast {
+
+namespace {
+
+typedef struct flat_builder {
+    flat_ast_t& ast;
+    flat_builder(flat_ast_t& ast) : ast(ast)
+    {}
+    // Appends a node as the last child of the supplied parent, which must be
+    // the most recently added node or one of its ancestors
+    flat_index_t add(
+            flat_index_t parent,
+            flat_role_t role,
+            flat_node_type_t type,
+            uint32_t value = 0,
+            const lexeme_t& lexeme = lexeme_t()) {
+        flat_index_t node = flat_index_t(ast.types.size());
+        ast.types.push_back(uint8_t(type));
+        ast.roles.push_back(uint8_t(role));
+        ast.flags.push_back(0);
+        ast.values.push_back(value);
+        ast.params.push_back(0);
+        ast.params2.push_back(0);
+        ast.parents.push_back(parent);
+        ast.first_children.push_back(FLAT_NONE);
+        ast.next_siblings.push_back(FLAT_NONE);
+        ast.lexemes.push_back(lexeme);
+        if (parent == FLAT_NONE)
+            return node;
+        if (ast.first_children[parent] == FLAT_NONE) {
+            ast.first_children[parent] = node;
+            return node;
+        }
+        // Nodes are added in pre-order, so the parent's last child so far is
+        // whichever ancestor of the previous node has the parent as its own
+        // parent. Each node is only climbed past once, when the first
+        // sibling after it is added.
+        flat_index_t prev = node - 1;
+        while (ast.parents[prev] != parent)
+            prev = ast.parents[prev];
+        ast.next_siblings[prev] = node;
+        return node;
+    }
+    inline void name(
+            flat_index_t parent,
+            flat_role_t role,
+            const lexeme_t& lexeme) {
+        if (lexeme)
+            add(parent, role, FLAT_NODE_TYPE_NAME, 0, lexeme);
+    }
+    inline void names(
+            flat_index_t parent,
+            flat_role_t role,
+            const std::vector<lexeme_t>& lexemes) {
+        for (const lexeme_t& lexeme : lexemes)
+            add(parent, role, FLAT_NODE_TYPE_NAME, 0, lexeme);
+    }
+} flat_builder_t;
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const value_expression_t& ve);
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const search_condition_t& sc);
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const query_expression_t& qe);
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const table_reference_t& tr);
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const data_type_descriptor_t& dt) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_DATA_TYPE, dt.type);
+    switch (dt.type) {
+        case DATA_TYPE_CHAR:
+        case DATA_TYPE_VARCHAR:
+        case DATA_TYPE_NCHAR:
+        case DATA_TYPE_NVARCHAR:
+            {
+                const char_string_t& sub = static_cast<const char_string_t&>(dt);
+                b.ast.params[node] = uint32_t(sub.size);
+                b.name(node, FLAT_ROLE_CHARSET, sub.charset);
+            }
+            break;
+        case DATA_TYPE_BIT:
+        case DATA_TYPE_VARBIT:
+            b.ast.params[node] = uint32_t(
+                    static_cast<const bit_string_t&>(dt).size);
+            break;
+        case DATA_TYPE_NUMERIC:
+        case DATA_TYPE_INT:
+        case DATA_TYPE_SMALLINT:
+            {
+                const exact_numeric_t& sub = static_cast<const exact_numeric_t&>(dt);
+                b.ast.params[node] = uint32_t(sub.precision);
+                b.ast.params2[node] = uint32_t(sub.scale);
+            }
+            break;
+        case DATA_TYPE_FLOAT:
+        case DATA_TYPE_DOUBLE:
+            b.ast.params[node] = uint32_t(
+                    static_cast<const approximate_numeric_t&>(dt).precision);
+            break;
+        case DATA_TYPE_DATE:
+        case DATA_TYPE_TIME:
+        case DATA_TYPE_TIMESTAMP:
+            {
+                const datetime_t& sub = static_cast<const datetime_t&>(dt);
+                b.ast.params[node] = uint32_t(sub.precision);
+                if (sub.with_tz)
+                    b.ast.flags[node] |= FLAT_FLAG_WITH_TZ;
+            }
+            break;
+        case DATA_TYPE_INTERVAL:
+            {
+                const interval_t& sub = static_cast<const interval_t&>(dt);
+                b.ast.params[node] = uint32_t(sub.precision);
+                b.ast.params2[node] = sub.unit;
+            }
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const default_descriptor_t& dd) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_DEFAULT, dd.type, dd.lexeme);
+    b.ast.params[node] = uint32_t(dd.precision);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const constraint_t& c) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_CONSTRAINT, c.type, c.name);
+    b.names(node, FLAT_ROLE_COLUMN, c.columns);
+    if (c.type != CONSTRAINT_TYPE_FOREIGN_KEY)
+        return;
+    const foreign_key_constraint_t& fk =
+        static_cast<const foreign_key_constraint_t&>(c);
+    b.ast.params[node] = fk.match_type;
+    b.name(node, FLAT_ROLE_REFERENCED_TABLE, fk.referenced_table);
+    b.names(node, FLAT_ROLE_REFERENCED_COLUMN, fk.referenced_columns);
+    b.add(node, FLAT_ROLE_ON_UPDATE, FLAT_NODE_TYPE_REFERENTIAL_ACTION,
+          fk.on_update);
+    b.add(node, FLAT_ROLE_ON_DELETE, FLAT_NODE_TYPE_REFERENTIAL_ACTION,
+          fk.on_delete);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const column_definition_t& cd) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_COLUMN_DEFINITION, 0, cd.name);
+    if (cd.data_type)
+        add_node(b, node, FLAT_ROLE_NONE, *cd.data_type);
+    if (cd.default_descriptor)
+        add_node(b, node, FLAT_ROLE_NONE, *cd.default_descriptor);
+    for (const std::unique_ptr<constraint_t>& c : cd.constraints)
+        add_node(b, node, FLAT_ROLE_NONE, *c);
+    b.name(node, FLAT_ROLE_COLLATION, cd.collate);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const value_expression_primary_t& vep) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY,
+            vep.vep_type, vep.lexeme);
+    switch (vep.vep_type) {
+        case VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION:
+            b.ast.params[node] =
+                static_cast<const unsigned_value_specification_t&>(vep).uvs_type;
+            break;
+        case VEP_TYPE_SET_FUNCTION_SPECIFICATION:
+            {
+                const set_function_t& sub = static_cast<const set_function_t&>(vep);
+                b.ast.params[node] = sub.func_type;
+                if (sub.star)
+                    b.ast.flags[node] |= FLAT_FLAG_STAR;
+                if (sub.distinct)
+                    b.ast.flags[node] |= FLAT_FLAG_DISTINCT;
+                if (sub.value)
+                    add_node(b, node, FLAT_ROLE_OPERAND, *sub.value);
+            }
+            break;
+        case VEP_TYPE_SCALAR_SUBQUERY:
+            add_node(b, node, FLAT_ROLE_QUERY,
+                     *static_cast<const scalar_subquery_t&>(vep).query);
+            break;
+        case VEP_TYPE_PARENTHESIZED_VALUE_EXPRESSION:
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const parenthesized_value_expression_t&>(vep).value);
+            break;
+        case VEP_TYPE_CASE_EXPRESSION:
+            {
+                const case_expression_t& ce = static_cast<const case_expression_t&>(vep);
+                b.ast.params[node] = ce.case_type;
+                switch (ce.case_type) {
+                    case CASE_EXPRESSION_TYPE_COALESCE_FUNCTION:
+                        for (const std::unique_ptr<value_expression_t>& value :
+                                static_cast<const coalesce_function_t&>(ce).values)
+                            add_node(b, node, FLAT_ROLE_VALUE, *value);
+                        break;
+                    case CASE_EXPRESSION_TYPE_NULLIF_FUNCTION:
+                        {
+                            const nullif_function_t& sub =
+                                static_cast<const nullif_function_t&>(ce);
+                            add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                            add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+                        }
+                        break;
+                    case CASE_EXPRESSION_TYPE_SIMPLE_CASE:
+                        {
+                            const simple_case_expression_t& sub =
+                                static_cast<const simple_case_expression_t&>(ce);
+                            add_node(b, node, FLAT_ROLE_OPERAND, *sub.operand);
+                            for (const simple_case_expression_when_clause_t& when :
+                                    sub.when_clauses) {
+                                flat_index_t when_node = b.add(
+                                        node, FLAT_ROLE_NONE,
+                                        FLAT_NODE_TYPE_CASE_WHEN);
+                                add_node(b, when_node, FLAT_ROLE_WHEN, *when.operand);
+                                add_node(b, when_node, FLAT_ROLE_RESULT, *when.result);
+                            }
+                            if (sub.else_value)
+                                add_node(b, node, FLAT_ROLE_ELSE, *sub.else_value);
+                        }
+                        break;
+                    case CASE_EXPRESSION_TYPE_SEARCHED_CASE:
+                        {
+                            const searched_case_expression_t& sub =
+                                static_cast<const searched_case_expression_t&>(ce);
+                            for (const searched_case_expression_when_clause_t& when :
+                                    sub.when_clauses) {
+                                flat_index_t when_node = b.add(
+                                        node, FLAT_ROLE_NONE,
+                                        FLAT_NODE_TYPE_CASE_WHEN);
+                                add_node(b, when_node, FLAT_ROLE_WHEN, *when.condition);
+                                add_node(b, when_node, FLAT_ROLE_RESULT, *when.result);
+                            }
+                            if (sub.else_value)
+                                add_node(b, node, FLAT_ROLE_ELSE, *sub.else_value);
+                        }
+                        break;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const numeric_factor_t& nf) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_NUMERIC_FACTOR);
+    if (nf.sign < 0)
+        b.ast.flags[node] |= FLAT_FLAG_NEGATIVE;
+    else if (nf.sign > 0)
+        b.ast.flags[node] |= FLAT_FLAG_POSITIVE;
+    if (nf.primary->type == NUMERIC_PRIMARY_TYPE_VALUE) {
+        add_node(b, node, FLAT_ROLE_NONE,
+                 *static_cast<const numeric_value_t&>(*nf.primary).primary);
+        return;
+    }
+    const numeric_function_t& func =
+        static_cast<const numeric_function_t&>(*nf.primary);
+    flat_index_t func_node = b.add(
+            node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_NUMERIC_FUNCTION, func.type);
+    switch (func.type) {
+        case NUMERIC_FUNCTION_TYPE_POSITION:
+            {
+                const position_expression_t& sub =
+                    static_cast<const position_expression_t&>(func);
+                add_node(b, func_node, FLAT_ROLE_OPERAND, *sub.to_find);
+                add_node(b, func_node, FLAT_ROLE_SUBJECT, *sub.subject);
+            }
+            break;
+        case NUMERIC_FUNCTION_TYPE_EXTRACT:
+            {
+                const extract_expression_t& sub =
+                    static_cast<const extract_expression_t&>(func);
+                b.ast.params[func_node] = sub.extract_field;
+                add_node(b, func_node, FLAT_ROLE_OPERAND, *sub.extract_source);
+            }
+            break;
+        case NUMERIC_FUNCTION_TYPE_CHAR_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_OCTET_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_BIT_LENGTH:
+            add_node(b, func_node, FLAT_ROLE_OPERAND,
+                     *static_cast<const length_expression_t&>(func).operand);
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const numeric_term_t& nt) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_NUMERIC_TERM);
+    b.ast.params[node] = nt.op;
+    add_node(b, node, FLAT_ROLE_LEFT, *nt.left);
+    if (nt.right)
+        add_node(b, node, FLAT_ROLE_RIGHT, *nt.right);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const string_function_t& sf) {
+    lexeme_t name;
+    if (sf.type == STRING_FUNCTION_TYPE_CONVERT)
+        name = static_cast<const convert_function_t&>(sf).conversion_name;
+    else if (sf.type == STRING_FUNCTION_TYPE_TRANSLATE)
+        name = static_cast<const translate_function_t&>(sf).translation_name;
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_STRING_FUNCTION, sf.type, name);
+    add_node(b, node, FLAT_ROLE_OPERAND, *sf.operand);
+    if (sf.type == STRING_FUNCTION_TYPE_SUBSTRING) {
+        const substring_function_t& sub =
+            static_cast<const substring_function_t&>(sf);
+        add_node(b, node, FLAT_ROLE_START, *sub.start_position_value);
+        if (sub.for_length_value)
+            add_node(b, node, FLAT_ROLE_LENGTH, *sub.for_length_value);
+    } else if (sf.type == STRING_FUNCTION_TYPE_TRIM) {
+        const trim_function_t& sub = static_cast<const trim_function_t&>(sf);
+        b.ast.params[node] = sub.specification;
+        if (sub.trim_character)
+            add_node(b, node, FLAT_ROLE_TRIM_CHARACTER, *sub.trim_character);
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const character_factor_t& cf) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_CHARACTER_FACTOR, 0, cf.collation);
+    if (cf.primary->value)
+        add_node(b, node, FLAT_ROLE_NONE, *cf.primary->value);
+    else
+        add_node(b, node, FLAT_ROLE_NONE, *cf.primary->string_function);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const datetime_factor_t& df) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_DATETIME_FACTOR, 0, df.tz);
+    if (df.primary->type == DATETIME_PRIMARY_TYPE_VALUE) {
+        add_node(b, node, FLAT_ROLE_NONE,
+                 *static_cast<const datetime_value_t&>(*df.primary).primary);
+        return;
+    }
+    const current_datetime_function_t& func =
+        static_cast<const current_datetime_function_t&>(*df.primary);
+    flat_index_t func_node = b.add(
+            node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_DATETIME_FUNCTION,
+            func.func_type);
+    b.ast.params[func_node] = uint32_t(func.precision);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const datetime_field_t& field) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_DATETIME_FIELD, field.interval);
+    b.ast.params[node] = uint32_t(field.precision);
+    b.ast.params2[node] = uint32_t(field.fractional_precision);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const interval_term_t& it) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_INTERVAL_TERM);
+    b.ast.params[node] = it.op;
+    const interval_factor_t& factor = *it.left;
+    flat_index_t factor_node = b.add(
+            node, FLAT_ROLE_LEFT, FLAT_NODE_TYPE_INTERVAL_FACTOR);
+    if (factor.sign < 0)
+        b.ast.flags[factor_node] |= FLAT_FLAG_NEGATIVE;
+    else if (factor.sign > 0)
+        b.ast.flags[factor_node] |= FLAT_FLAG_POSITIVE;
+    add_node(b, factor_node, FLAT_ROLE_NONE, *factor.primary->value);
+    if (factor.primary->qualifier) {
+        const interval_qualifier_t& qualifier = *factor.primary->qualifier;
+        flat_index_t qualifier_node = b.add(
+                factor_node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_INTERVAL_QUALIFIER);
+        add_node(b, qualifier_node, FLAT_ROLE_START, qualifier.start);
+        if (qualifier.end)
+            add_node(b, qualifier_node, FLAT_ROLE_END, *qualifier.end);
+    }
+    if (it.right)
+        add_node(b, node, FLAT_ROLE_RIGHT, *it.right);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const value_expression_t& ve) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_VALUE_EXPRESSION, ve.type);
+    switch (ve.type) {
+        case VALUE_EXPRESSION_TYPE_NUMERIC_EXPRESSION:
+            {
+                const numeric_expression_t& sub =
+                    static_cast<const numeric_expression_t&>(ve);
+                b.ast.params[node] = sub.op;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                if (sub.right)
+                    add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+            }
+            break;
+        case VALUE_EXPRESSION_TYPE_STRING_EXPRESSION:
+            for (const std::unique_ptr<character_factor_t>& value :
+                    static_cast<const character_value_expression_t&>(ve).values)
+                add_node(b, node, FLAT_ROLE_NONE, *value);
+            break;
+        case VALUE_EXPRESSION_TYPE_DATETIME_EXPRESSION:
+            {
+                const datetime_value_expression_t& sub =
+                    static_cast<const datetime_value_expression_t&>(ve);
+                b.ast.params[node] = sub.op;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left->value);
+                if (sub.right)
+                    add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+            }
+            break;
+        case VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION:
+            {
+                const interval_value_expression_t& sub =
+                    static_cast<const interval_value_expression_t&>(ve);
+                b.ast.params[node] = sub.op;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                if (sub.right)
+                    add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+            }
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const row_value_constructor_t& rvc) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_ROW_VALUE_CONSTRUCTOR, rvc.rvc_type);
+    if (rvc.rvc_type == RVC_TYPE_ELEMENT) {
+        const row_value_constructor_element_t& element =
+            static_cast<const row_value_constructor_element_t&>(rvc);
+        b.ast.params[node] = element.rvc_element_type;
+        if (element.rvc_element_type == RVC_ELEMENT_TYPE_VALUE_EXPRESSION)
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const row_value_expression_t&>(element).value);
+    } else if (rvc.rvc_type == RVC_TYPE_LIST) {
+        for (const std::unique_ptr<row_value_constructor_t>& element :
+                static_cast<const row_value_constructor_list_t&>(rvc).elements)
+            add_node(b, node, FLAT_ROLE_NONE, *element);
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const predicate_t& pred) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_PREDICATE, pred.predicate_type);
+    switch (pred.predicate_type) {
+        case PREDICATE_TYPE_COMPARISON:
+            {
+                const comp_predicate_t& sub = static_cast<const comp_predicate_t&>(pred);
+                b.ast.params[node] = sub.op;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+            }
+            break;
+        case PREDICATE_TYPE_BETWEEN:
+            {
+                const between_predicate_t& sub =
+                    static_cast<const between_predicate_t&>(pred);
+                if (sub.reverse_op)
+                    b.ast.flags[node] |= FLAT_FLAG_NOT;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_LOWER, *sub.comp_left);
+                add_node(b, node, FLAT_ROLE_UPPER, *sub.comp_right);
+            }
+            break;
+        case PREDICATE_TYPE_LIKE:
+            {
+                const like_predicate_t& sub = static_cast<const like_predicate_t&>(pred);
+                if (sub.reverse_op)
+                    b.ast.flags[node] |= FLAT_FLAG_NOT;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.match);
+                add_node(b, node, FLAT_ROLE_PATTERN, *sub.pattern);
+                if (sub.escape_char)
+                    add_node(b, node, FLAT_ROLE_ESCAPE, *sub.escape_char);
+            }
+            break;
+        case PREDICATE_TYPE_NULL:
+            {
+                const null_predicate_t& sub = static_cast<const null_predicate_t&>(pred);
+                if (sub.reverse_op)
+                    b.ast.flags[node] |= FLAT_FLAG_NOT;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+            }
+            break;
+        case PREDICATE_TYPE_IN_VALUES:
+            {
+                const in_values_predicate_t& sub =
+                    static_cast<const in_values_predicate_t&>(pred);
+                if (sub.reverse_op)
+                    b.ast.flags[node] |= FLAT_FLAG_NOT;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                for (const std::unique_ptr<value_expression_t>& value : sub.values)
+                    add_node(b, node, FLAT_ROLE_VALUE, *value);
+            }
+            break;
+        case PREDICATE_TYPE_IN_SUBQUERY:
+            {
+                const in_subquery_predicate_t& sub =
+                    static_cast<const in_subquery_predicate_t&>(pred);
+                if (sub.reverse_op)
+                    b.ast.flags[node] |= FLAT_FLAG_NOT;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_QUERY, *sub.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_QUANTIFIED_COMPARISON:
+            {
+                const quantified_comparison_predicate_t& sub =
+                    static_cast<const quantified_comparison_predicate_t&>(pred);
+                b.ast.params[node] = sub.op;
+                b.ast.params2[node] = sub.quantifier;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_QUERY, *sub.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_EXISTS:
+            add_node(b, node, FLAT_ROLE_QUERY,
+                     *static_cast<const exists_predicate_t&>(pred).subquery);
+            break;
+        case PREDICATE_TYPE_UNIQUE:
+            add_node(b, node, FLAT_ROLE_QUERY,
+                     *static_cast<const unique_predicate_t&>(pred).subquery);
+            break;
+        case PREDICATE_TYPE_MATCH:
+            {
+                const match_predicate_t& sub = static_cast<const match_predicate_t&>(pred);
+                if (sub.match_unique)
+                    b.ast.flags[node] |= FLAT_FLAG_MATCH_UNIQUE;
+                if (sub.match_partial)
+                    b.ast.flags[node] |= FLAT_FLAG_MATCH_PARTIAL;
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_QUERY, *sub.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_OVERLAPS:
+            {
+                const overlaps_predicate_t& sub =
+                    static_cast<const overlaps_predicate_t&>(pred);
+                add_node(b, node, FLAT_ROLE_LEFT, *sub.left);
+                add_node(b, node, FLAT_ROLE_RIGHT, *sub.right);
+            }
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const search_condition_t& sc) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_SEARCH_CONDITION);
+    for (const std::unique_ptr<boolean_term_t>& term : sc.terms) {
+        flat_index_t term_node = b.add(
+                node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_BOOLEAN_TERM);
+        // The chain of AND'd factors becomes a list of children
+        for (const boolean_term_t* bt = term.get(); bt;
+                bt = bt->and_operand.get()) {
+            flat_index_t factor_node = b.add(
+                    term_node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_BOOLEAN_FACTOR);
+            if (bt->factor->reverse_op)
+                b.ast.flags[factor_node] |= FLAT_FLAG_NOT;
+            const boolean_primary_t& primary = *bt->factor->primary;
+            if (primary.predicate)
+                add_node(b, factor_node, FLAT_ROLE_NONE, *primary.predicate);
+            else
+                add_node(b, factor_node, FLAT_ROLE_NONE, *primary.search_condition);
+        }
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const table_expression_t& te) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_TABLE_EXPRESSION);
+    for (const std::unique_ptr<table_reference_t>& tr : te.referenced_tables)
+        add_node(b, node, FLAT_ROLE_NONE, *tr);
+    if (te.where_condition)
+        add_node(b, node, FLAT_ROLE_WHERE, *te.where_condition);
+    for (const grouping_column_reference_t& gcr : te.group_by_columns) {
+        flat_index_t gcr_node = b.add(
+                node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_GROUPING_COLUMN, 0,
+                gcr.column);
+        b.name(gcr_node, FLAT_ROLE_COLLATION, gcr.collation);
+    }
+    if (te.having_condition)
+        add_node(b, node, FLAT_ROLE_HAVING, *te.having_condition);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const query_specification_t& qs) {
+    flat_index_t node = b.add(parent, role, FLAT_NODE_TYPE_QUERY_SPECIFICATION);
+    if (qs.distinct)
+        b.ast.flags[node] |= FLAT_FLAG_DISTINCT;
+    for (const derived_column_t& dc : qs.selected_columns) {
+        flat_index_t dc_node = b.add(
+                node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_DERIVED_COLUMN, 0,
+                dc.alias);
+        if (dc.value)
+            add_node(b, dc_node, FLAT_ROLE_NONE, *dc.value);
+        else
+            b.ast.flags[dc_node] |= FLAT_FLAG_STAR;
+    }
+    if (qs.table_expression)
+        add_node(b, node, FLAT_ROLE_NONE, *qs.table_expression);
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const query_expression_t& qe) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_QUERY_EXPRESSION,
+            qe.query_expression_type);
+    if (qe.query_expression_type == QUERY_EXPRESSION_TYPE_JOINED_TABLE) {
+        add_node(b, node, FLAT_ROLE_NONE,
+                 *static_cast<const joined_table_query_expression_t&>(qe).joined_table);
+        return;
+    }
+    const non_join_query_primary_t& primary =
+        *static_cast<const non_join_query_expression_t&>(qe).term->primary;
+    switch (primary.primary_type) {
+        case NON_JOIN_QUERY_PRIMARY_TYPE_QUERY_SPECIFICATION:
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const query_specification_non_join_query_primary_t&>(
+                         primary).query_spec);
+            break;
+        case NON_JOIN_QUERY_PRIMARY_TYPE_TABLE_VALUE_CONSTRUCTOR:
+            {
+                const table_value_constructor_t& tvc =
+                    *static_cast<const table_value_constructor_non_join_query_primary_t&>(
+                        primary).table_value;
+                flat_index_t tvc_node = b.add(
+                        node, FLAT_ROLE_NONE,
+                        FLAT_NODE_TYPE_TABLE_VALUE_CONSTRUCTOR);
+                for (const std::unique_ptr<row_value_constructor_t>& value :
+                        tvc.values)
+                    add_node(b, tvc_node, FLAT_ROLE_NONE, *value);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const table_reference_t& tr) {
+    flat_index_t node;
+    if (tr.type == TABLE_REFERENCE_TYPE_TABLE) {
+        const table_t& t = static_cast<const table_t&>(tr);
+        node = b.add(parent, role, FLAT_NODE_TYPE_TABLE_REFERENCE, tr.type,
+                     t.table_name);
+        if (t.correlation_spec) {
+            b.name(node, FLAT_ROLE_ALIAS, t.correlation_spec->alias);
+            b.names(node, FLAT_ROLE_COLUMN, t.correlation_spec->columns);
+        }
+    } else {
+        const derived_table_t& dt = static_cast<const derived_table_t&>(tr);
+        node = b.add(parent, role, FLAT_NODE_TYPE_TABLE_REFERENCE, tr.type,
+                     dt.correlation_spec.alias);
+        b.names(node, FLAT_ROLE_COLUMN, dt.correlation_spec.columns);
+        add_node(b, node, FLAT_ROLE_QUERY, *dt.query);
+    }
+    if (! tr.joined)
+        return;
+    const join_target_t& target = *tr.joined;
+    flat_index_t join_node = b.add(
+            node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_JOIN, target.join_type);
+    add_node(b, join_node, FLAT_ROLE_NONE, *target.table_ref);
+    if (target.join_spec) {
+        if (target.join_spec->condition)
+            add_node(b, join_node, FLAT_ROLE_ON, *target.join_spec->condition);
+        b.names(join_node, FLAT_ROLE_COLUMN, target.join_spec->named_columns);
+    }
+}
+
+void add_node(flat_builder_t& b, flat_index_t parent, flat_role_t role, const alter_table_action_t& action) {
+    flat_index_t node = b.add(
+            parent, role, FLAT_NODE_TYPE_ALTER_TABLE_ACTION, action.type);
+    switch (action.type) {
+        case ALTER_TABLE_ACTION_TYPE_ADD_COLUMN:
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const add_column_action_t&>(action).column_definition);
+            break;
+        case ALTER_TABLE_ACTION_TYPE_ALTER_COLUMN:
+            {
+                const alter_column_action_t& sub =
+                    static_cast<const alter_column_action_t&>(action);
+                b.ast.params[node] = sub.alter_column_action_type;
+                b.ast.lexemes[node] = sub.column_name;
+                if (sub.default_descriptor)
+                    add_node(b, node, FLAT_ROLE_NONE, *sub.default_descriptor);
+            }
+            break;
+        case ALTER_TABLE_ACTION_TYPE_DROP_COLUMN:
+            {
+                const drop_column_action_t& sub =
+                    static_cast<const drop_column_action_t&>(action);
+                b.ast.params[node] = sub.drop_behaviour;
+                b.ast.lexemes[node] = sub.column_name;
+            }
+            break;
+        case ALTER_TABLE_ACTION_TYPE_ADD_CONSTRAINT:
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const add_constraint_action_t&>(action).constraint);
+            break;
+        case ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT:
+            {
+                const drop_constraint_action_t& sub =
+                    static_cast<const drop_constraint_action_t&>(action);
+                b.ast.params[node] = sub.drop_behaviour;
+                b.ast.lexemes[node] = sub.constraint_name;
+            }
+            break;
+    }
+}
+
+} // namespace
+
+flat_index_t flatten(
+        const statement_t& stmt,
+        parse_position_t input_start,
+        flat_ast_t& out) {
+    flat_builder_t b(out);
+    out.input = input_start;
+    flat_index_t node = b.add(
+            FLAT_NONE, FLAT_ROLE_NONE, FLAT_NODE_TYPE_STATEMENT, stmt.type);
+    out.statements.push_back(node);
+    // Most statements are named after the object they act on
+    lexeme_t name;
+    switch (stmt.type) {
+        case STATEMENT_TYPE_CREATE_SCHEMA:
+            {
+                const create_schema_statement_t& sub =
+                    static_cast<const create_schema_statement_t&>(stmt);
+                name = sub.schema_name;
+                b.name(node, FLAT_ROLE_AUTHORIZATION, sub.authorization_identifier);
+                b.name(node, FLAT_ROLE_CHARSET, sub.default_charset);
+            }
+            break;
+        case STATEMENT_TYPE_DROP_SCHEMA:
+            {
+                const drop_schema_statement_t& sub =
+                    static_cast<const drop_schema_statement_t&>(stmt);
+                name = sub.schema_name;
+                out.params[node] = sub.drop_behaviour;
+            }
+            break;
+        case STATEMENT_TYPE_CREATE_TABLE:
+            {
+                const create_table_statement_t& sub =
+                    static_cast<const create_table_statement_t&>(stmt);
+                name = sub.table_name;
+                out.params[node] = sub.table_type;
+                for (const std::unique_ptr<column_definition_t>& cd :
+                        sub.column_definitions)
+                    add_node(b, node, FLAT_ROLE_NONE, *cd);
+                for (const std::unique_ptr<constraint_t>& c : sub.constraints)
+                    add_node(b, node, FLAT_ROLE_NONE, *c);
+            }
+            break;
+        case STATEMENT_TYPE_DROP_TABLE:
+            {
+                const drop_table_statement_t& sub =
+                    static_cast<const drop_table_statement_t&>(stmt);
+                name = sub.table_name;
+                out.params[node] = sub.drop_behaviour;
+            }
+            break;
+        case STATEMENT_TYPE_ALTER_TABLE:
+            {
+                const alter_table_statement_t& sub =
+                    static_cast<const alter_table_statement_t&>(stmt);
+                name = sub.table_name;
+                add_node(b, node, FLAT_ROLE_NONE, *sub.action);
+            }
+            break;
+        case STATEMENT_TYPE_CREATE_VIEW:
+            {
+                const create_view_statement_t& sub =
+                    static_cast<const create_view_statement_t&>(stmt);
+                name = sub.table_name;
+                out.params[node] = sub.check_option;
+                b.names(node, FLAT_ROLE_COLUMN, sub.columns);
+                add_node(b, node, FLAT_ROLE_QUERY, *sub.query);
+            }
+            break;
+        case STATEMENT_TYPE_DROP_VIEW:
+            {
+                const drop_view_statement_t& sub =
+                    static_cast<const drop_view_statement_t&>(stmt);
+                name = sub.table_name;
+                out.params[node] = sub.drop_behaviour;
+            }
+            break;
+        case STATEMENT_TYPE_SELECT:
+            add_node(b, node, FLAT_ROLE_NONE,
+                     *static_cast<const select_statement_t&>(stmt).query);
+            break;
+        case STATEMENT_TYPE_INSERT:
+            {
+                const insert_statement_t& sub =
+                    static_cast<const insert_statement_t&>(stmt);
+                name = sub.table_name;
+                b.names(node, FLAT_ROLE_COLUMN, sub.insert_columns);
+                // INSERT ... DEFAULT VALUES has no query
+                if (sub.query)
+                    add_node(b, node, FLAT_ROLE_QUERY, *sub.query);
+            }
+            break;
+        case STATEMENT_TYPE_DELETE:
+            {
+                const delete_statement_t& sub =
+                    static_cast<const delete_statement_t&>(stmt);
+                name = sub.table_name;
+                if (sub.where_condition)
+                    add_node(b, node, FLAT_ROLE_WHERE, *sub.where_condition);
+            }
+            break;
+        case STATEMENT_TYPE_UPDATE:
+            {
+                const update_statement_t& sub =
+                    static_cast<const update_statement_t&>(stmt);
+                name = sub.table_name;
+                for (const set_column_t& sc : sub.set_columns) {
+                    flat_index_t sc_node = b.add(
+                            node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_SET_COLUMN,
+                            sc.type, sc.column_name);
+                    if (sc.value)
+                        add_node(b, sc_node, FLAT_ROLE_NONE, *sc.value);
+                }
+                if (sub.where_condition)
+                    add_node(b, node, FLAT_ROLE_WHERE, *sub.where_condition);
+            }
+            break;
+        case STATEMENT_TYPE_GRANT:
+            {
+                const grant_statement_t& sub =
+                    static_cast<const grant_statement_t&>(stmt);
+                name = sub.on;
+                out.params[node] = sub.object_type;
+                if (sub.with_grant_option)
+                    out.flags[node] |= FLAT_FLAG_WITH_GRANT_OPTION;
+                for (const std::unique_ptr<grant_action_t>& action :
+                        sub.privileges) {
+                    flat_index_t action_node = b.add(
+                            node, FLAT_ROLE_NONE, FLAT_NODE_TYPE_GRANT_ACTION,
+                            action->type);
+                    if (action->type == GRANT_ACTION_TYPE_UPDATE ||
+                            action->type == GRANT_ACTION_TYPE_INSERT ||
+                            action->type == GRANT_ACTION_TYPE_REFERENCES)
+                        b.names(action_node, FLAT_ROLE_COLUMN,
+                                static_cast<const column_list_grant_action_t&>(
+                                    *action).columns);
+                }
+                b.name(node, FLAT_ROLE_GRANTEE, sub.to);
+            }
+            break;
+        default:
+            break;
+    }
+    if (name)
+        out.lexemes[node] = name;
+    return node;
+}
+
+} // namespace sqltoast
@@ -0,0 +1,317 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <cstring>
+
+#include <sqltoast/sqltoast.h>
+
+#include "parser/arena.h"
+
+namespace sqltoast {
+
+// The encoding is made up of:
+//
+//   "SQLT", then SERIALIZE_FORMAT_VERSION as a single byte
+//   the length of the input the lexemes refer to, then the input itself
+//   the number of nodes
+//   each node of the flat AST, in pre-order:
+//     its type and role, a byte each
+//     a byte of FIELD_ bits saying which of the following are present
+//     its flags, value, param and param2, where not zero
+//     the distance back to its parent, 0 for the root of a statement,
+//     unless the parent is the node just before
+//     its lexeme, if it has one: the difference between its offset and the
+//     offset of the previous lexeme, zigzag-encoded, then its length
+//
+// Every number but the type, role and field bits is a little-endian base
+// 128 varint, so the small values most nodes have take a byte each. The
+// children and siblings of each node are rebuilt from the parents when
+// loading.
+
+namespace {
+
+const char SERIALIZE_MAGIC[] = {'S', 'Q', 'L', 'T'};
+
+enum field_bits {
+    FIELD_FLAGS = 1 << 0,
+    FIELD_VALUE = 1 << 1,
+    FIELD_PARAM = 1 << 2,
+    FIELD_PARAM2 = 1 << 3,
+    FIELD_PARENT = 1 << 4,
+    FIELD_LEXEME = 1 << 5,
+    FIELD_ALL = (1 << 6) - 1
+};
+
+// The type, role and field bits are the least a node takes
+const size_t MIN_NODE_SIZE = 3;
+
+inline void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(char(uint8_t(value) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+typedef struct decoder {
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool failed;
+    decoder(const char* data, size_t len) :
+        cursor(reinterpret_cast<const uint8_t*>(data)),
+        end(reinterpret_cast<const uint8_t*>(data) + len),
+        failed(false)
+    {}
+    inline uint8_t byte() {
+        if (cursor == end) {
+            failed = true;
+            return 0;
+        }
+        return *cursor++;
+    }
+    inline uint64_t varint(uint64_t max) {
+        // Most values fit in a single byte
+        if (cursor != end && *cursor < 0x80 && *cursor <= max)
+            return *cursor++;
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (cursor == end)
+                break;
+            uint8_t b = *cursor++;
+            value |= uint64_t(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                if (value > max)
+                    break;
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+    inline size_t remaining() const {
+        return end - cursor;
+    }
+} decoder_t;
+
+void encode(const flat_ast_t& ast, std::string& out) {
+    size_t num_nodes = ast.size();
+    // Only the part of the input up to the end of the last lexeme is needed
+    uint64_t input_len = 0;
+    for (const lexeme_t& lexeme : ast.lexemes) {
+        if (lexeme && uint64_t(lexeme.offset) + lexeme.length > input_len)
+            input_len = uint64_t(lexeme.offset) + lexeme.length;
+    }
+    out.reserve(out.size() + 16 + input_len + num_nodes * 6);
+    out.append(SERIALIZE_MAGIC, sizeof(SERIALIZE_MAGIC));
+    out.push_back(char(SERIALIZE_FORMAT_VERSION));
+    put_varint(out, input_len);
+    out.append(ast.input, input_len);
+    put_varint(out, num_nodes);
+    int64_t last_offset = 0;
+    for (flat_index_t x = 0; x < num_nodes; x++) {
+        flat_index_t parent = ast.parents[x];
+        uint32_t parent_distance = parent == FLAT_NONE ? 0 : x - parent;
+        const lexeme_t& lexeme = ast.lexemes[x];
+        uint8_t fields = 0;
+        if (ast.flags[x] != 0)
+            fields |= FIELD_FLAGS;
+        if (ast.values[x] != 0)
+            fields |= FIELD_VALUE;
+        if (ast.params[x] != 0)
+            fields |= FIELD_PARAM;
+        if (ast.params2[x] != 0)
+            fields |= FIELD_PARAM2;
+        if (parent_distance != 1)
+            fields |= FIELD_PARENT;
+        if (lexeme)
+            fields |= FIELD_LEXEME;
+        out.push_back(char(ast.types[x]));
+        out.push_back(char(ast.roles[x]));
+        out.push_back(char(fields));
+        if (fields & FIELD_FLAGS)
+            put_varint(out, ast.flags[x]);
+        if (fields & FIELD_VALUE)
+            put_varint(out, ast.values[x]);
+        if (fields & FIELD_PARAM)
+            put_varint(out, ast.params[x]);
+        if (fields & FIELD_PARAM2)
+            put_varint(out, ast.params2[x]);
+        if (fields & FIELD_PARENT)
+            put_varint(out, parent_distance);
+        if (fields & FIELD_LEXEME) {
+            int64_t delta = int64_t(lexeme.offset) - last_offset;
+            put_varint(out, (uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+            put_varint(out, lexeme.length);
+            last_offset = lexeme.offset;
+        }
+    }
+}
+
+// Returns a description of what is wrong with the data, or nullptr if the
+// flat AST was decoded from it
+const char* decode(decoder_t& dec, flat_ast_t& ast) {
+    if (dec.remaining() < sizeof(SERIALIZE_MAGIC) ||
+            std::memcmp(dec.cursor, SERIALIZE_MAGIC, sizeof(SERIALIZE_MAGIC)) != 0)
+        return "Input is not serialized statements.";
+    dec.cursor += sizeof(SERIALIZE_MAGIC);
+    if (dec.byte() != SERIALIZE_FORMAT_VERSION)
+        return "Serialized statements are from an unsupported version of "
+               "the format.";
+    uint64_t input_len = dec.varint(LEXEME_NONE - 1);
+    if (dec.failed || input_len > dec.remaining())
+        return "Serialized statements are malformed.";
+    ast.input = reinterpret_cast<parse_position_t>(dec.cursor);
+    dec.cursor += input_len;
+    // Bound the number of nodes by the data left before allocating
+    // anything for them
+    uint64_t num_nodes = dec.varint(FLAT_NONE - 1);
+    if (dec.failed || num_nodes > dec.remaining() / MIN_NODE_SIZE)
+        return "Serialized statements are malformed.";
+    // The arrays are sized up front and filled in place. Nodes are only
+    // linked to nodes before them, so the zeroed nodes past the one being
+    // decoded are never looked at.
+    ast.types.resize(num_nodes);
+    ast.roles.resize(num_nodes);
+    ast.flags.resize(num_nodes);
+    ast.values.resize(num_nodes);
+    ast.params.resize(num_nodes);
+    ast.params2.resize(num_nodes);
+    ast.parents.resize(num_nodes);
+    ast.first_children.resize(num_nodes, FLAT_NONE);
+    ast.next_siblings.resize(num_nodes, FLAT_NONE);
+    ast.lexemes.resize(num_nodes);
+    int64_t last_offset = 0;
+    for (flat_index_t node = 0; node < num_nodes; node++) {
+        uint8_t type = dec.byte();
+        uint8_t role = dec.byte();
+        uint8_t fields = dec.byte();
+        ast.types[node] = type;
+        ast.roles[node] = role;
+        if (fields & FIELD_FLAGS)
+            ast.flags[node] = uint16_t(dec.varint(UINT16_MAX));
+        // What a value or param means depends on the kind of node, so the
+        // ones holding enums are range checked by unflatten() instead
+        if (fields & FIELD_VALUE)
+            ast.values[node] = uint32_t(dec.varint(UINT32_MAX));
+        if (fields & FIELD_PARAM)
+            ast.params[node] = uint32_t(dec.varint(UINT32_MAX));
+        if (fields & FIELD_PARAM2)
+            ast.params2[node] = uint32_t(dec.varint(UINT32_MAX));
+        uint64_t parent_distance = 1;
+        if (fields & FIELD_PARENT)
+            parent_distance = dec.varint(node);
+        if (fields & FIELD_LEXEME) {
+            uint64_t zigzag = dec.varint(UINT64_MAX);
+            int64_t offset = last_offset +
+                int64_t((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            uint64_t length = dec.varint(UINT32_MAX);
+            if (offset < 0 || uint64_t(offset) + length > input_len)
+                return "Serialized statements are malformed.";
+            ast.lexemes[node] = lexeme_t(uint32_t(offset), uint32_t(length));
+            last_offset = offset;
+        }
+        if (dec.failed ||
+                fields > FIELD_ALL ||
+                type > FLAT_NODE_TYPE_NAME ||
+                role > FLAT_ROLE_ON_DELETE ||
+                parent_distance > node)
+            return "Serialized statements are malformed.";
+        flat_index_t parent = FLAT_NONE;
+        if (parent_distance == 0) {
+            if (type != FLAT_NODE_TYPE_STATEMENT)
+                return "Serialized statements are malformed.";
+            ast.statements.push_back(node);
+        } else {
+            parent = node - flat_index_t(parent_distance);
+        }
+        ast.parents[node] = parent;
+        if (parent == FLAT_NONE)
+            continue;
+        // Link the node in the same way flatten() does. In pre-order, a
+        // parent with no children yet must be the node just before, and
+        // one with children must be an ancestor of the node just before.
+        if (ast.first_children[parent] == FLAT_NONE) {
+            if (parent != node - 1)
+                return "Serialized statements are malformed.";
+            ast.first_children[parent] = node;
+            continue;
+        }
+        flat_index_t prev = node - 1;
+        while (prev != FLAT_NONE && ast.parents[prev] != parent)
+            prev = ast.parents[prev];
+        if (prev == FLAT_NONE)
+            return "Serialized statements are malformed.";
+        ast.next_siblings[prev] = node;
+    }
+    if (dec.remaining() != 0)
+        return "Serialized statements are malformed.";
+    return nullptr;
+}
+
+void deserialize_error(
+        parse_result_t& res,
+        const char* message,
+        const char* data,
+        size_t len) {
+    parse_error_t& err = res.error;
+    err.code = PARSE_INPUT_ERROR;
+    err.message = message;
+    err.offset = 0;
+    err.found_symbol = 0;
+    err.found_length = 0;
+    err.input = data;
+    err.input_end = data + len;
+    res.code = PARSE_INPUT_ERROR;
+    res.statements.clear();
+    res.flat.clear();
+}
+
+} // namespace
+
+void serialize(const parse_result_t& res, std::string& out) {
+    if (res.statements.empty()) {
+        encode(res.flat, out);
+        return;
+    }
+    flat_ast_t ast;
+    for (const std::unique_ptr<statement_t>& stmt : res.statements)
+        flatten(*stmt, res.input, ast);
+    encode(ast, out);
+}
+
+parse_result_t deserialize(
+        const char* data,
+        size_t len,
+        parse_options_t& opts) {
+    parse_result_t res;
+    decoder_t dec(data, len);
+    const char* message = decode(dec, res.flat);
+    if (message != nullptr) {
+        deserialize_error(res, message, data, len);
+        return res;
+    }
+    res.input = res.flat.input;
+    if (opts.flat)
+        return res;
+
+    if (opts.use_arena)
+        res.arena.reset(new arena_t);
+    arena_scope_t scope(res.arena.get());
+    res.statements.reserve(res.flat.statements.size());
+    for (flat_index_t root : res.flat.statements) {
+        std::unique_ptr<statement_t> stmt;
+        if (! unflatten(res.flat, root, stmt)) {
+            deserialize_error(res, "Serialized statements are malformed.",
+                              data, len);
+            return res;
+        }
+        res.statements.emplace_back(std::move(stmt));
+    }
+    res.flat = flat_ast_t();
+    return res;
+}
+
+} // namespace sqltoast
@@ -0,0 +1,1419 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <sqltoast/sqltoast.h>
+
+namespace sqltoast {
+
+namespace {
+
+// Each build() overload below rebuilds the tree node for one kind of flat
+// node, the reverse of the matching add_node() in flatten.cc. They return
+// false if the flat node isn't of the expected kind or is missing a child or
+// lexeme that the parser always gives the tree node, since code walking the
+// tree relies on those being there.
+
+inline bool is_type(
+        const flat_ast_t& ast,
+        flat_index_t node,
+        flat_node_type_t type) {
+    return node != FLAT_NONE && ast.type(node) == type;
+}
+
+// Sets out to an enum value the flat AST records, returning false if the
+// value is past last, the enum's last enumerator. A flat AST loaded by
+// deserialize() can hold any value there.
+template<typename E>
+inline bool decode(uint32_t value, E last, E& out) {
+    if (value > uint32_t(last))
+        return false;
+    out = E(value);
+    return true;
+}
+
+inline int8_t sign_of(const flat_ast_t& ast, flat_index_t node) {
+    if (ast.has_flag(node, FLAT_FLAG_NEGATIVE))
+        return -1;
+    if (ast.has_flag(node, FLAT_FLAG_POSITIVE))
+        return 1;
+    return 0;
+}
+
+// Returns the lexeme of the NAME child playing the supplied role, or an
+// empty lexeme if there isn't one
+lexeme_t name(const flat_ast_t& ast, flat_index_t node, flat_role_t role) {
+    flat_index_t child = ast.child(node, role);
+    if (child == FLAT_NONE)
+        return lexeme_t();
+    return ast.lexeme(child);
+}
+
+// Appends the lexemes of the NAME children playing the supplied role,
+// returning false if any of them has no lexeme
+bool names(
+        const flat_ast_t& ast,
+        flat_index_t node,
+        flat_role_t role,
+        std::vector<lexeme_t>& out) {
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        if (ast.role(x) != role || ast.type(x) != FLAT_NODE_TYPE_NAME)
+            continue;
+        if (! ast.lexeme(x))
+            return false;
+        out.push_back(ast.lexeme(x));
+    }
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<data_type_descriptor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<default_descriptor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<constraint_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<column_definition_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<case_expression_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<value_expression_primary_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_primary_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_factor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_term_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<string_function_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<character_factor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<datetime_factor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_qualifier_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_factor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_term_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<value_expression_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<row_value_constructor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<predicate_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<boolean_factor_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<search_condition_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<table_expression_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<query_specification_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<query_expression_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<join_target_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<table_reference_t>& out);
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<alter_table_action_t>& out);
+
+// Builds the child playing the supplied role, leaving out empty if there
+// isn't one
+template<typename T>
+bool build_optional(
+        const flat_ast_t& ast,
+        flat_index_t node,
+        flat_role_t role,
+        std::unique_ptr<T>& out) {
+    flat_index_t child = ast.child(node, role);
+    if (child == FLAT_NONE)
+        return true;
+    return build(ast, child, out);
+}
+
+template<typename T>
+bool build_required(
+        const flat_ast_t& ast,
+        flat_index_t node,
+        flat_role_t role,
+        std::unique_ptr<T>& out) {
+    flat_index_t child = ast.child(node, role);
+    if (child == FLAT_NONE)
+        return false;
+    return build(ast, child, out);
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<data_type_descriptor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_DATA_TYPE))
+        return false;
+    data_type_t type;
+    if (! decode(ast.values[node], DATA_TYPE_INTERVAL, type))
+        return false;
+    size_t param = ast.params[node];
+    switch (type) {
+        case DATA_TYPE_CHAR:
+        case DATA_TYPE_VARCHAR:
+        case DATA_TYPE_NCHAR:
+        case DATA_TYPE_NVARCHAR:
+            out = std::make_unique<char_string_t>(
+                    type, param, name(ast, node, FLAT_ROLE_CHARSET));
+            return true;
+        case DATA_TYPE_BIT:
+        case DATA_TYPE_VARBIT:
+            out = std::make_unique<bit_string_t>(type, param);
+            return true;
+        case DATA_TYPE_NUMERIC:
+        case DATA_TYPE_INT:
+        case DATA_TYPE_SMALLINT:
+            out = std::make_unique<exact_numeric_t>(
+                    type, param, ast.params2[node]);
+            return true;
+        case DATA_TYPE_FLOAT:
+        case DATA_TYPE_DOUBLE:
+            out = std::make_unique<approximate_numeric_t>(type, param);
+            return true;
+        case DATA_TYPE_DATE:
+        case DATA_TYPE_TIME:
+        case DATA_TYPE_TIMESTAMP:
+            out = std::make_unique<datetime_t>(
+                    type, param, ast.has_flag(node, FLAT_FLAG_WITH_TZ));
+            return true;
+        case DATA_TYPE_INTERVAL:
+            {
+                interval_unit_t unit;
+                if (! decode(ast.params2[node], INTERVAL_UNIT_SECOND, unit))
+                    return false;
+                out = std::make_unique<interval_t>(unit, param);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<default_descriptor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_DEFAULT))
+        return false;
+    default_type_t type;
+    if (! decode(ast.values[node], DEFAULT_TYPE_NULL, type))
+        return false;
+    if (type == DEFAULT_TYPE_LITERAL && ! ast.lexeme(node))
+        return false;
+    out = std::make_unique<default_descriptor_t>(
+            type, ast.lexeme(node), ast.params[node]);
+    return true;
+}
+
+inline bool referential_action(
+        const flat_ast_t& ast,
+        flat_index_t node,
+        flat_role_t role,
+        referential_action_t& out) {
+    flat_index_t child = ast.child(node, role);
+    if (child == FLAT_NONE) {
+        out = REFERENTIAL_ACTION_NONE;
+        return true;
+    }
+    return decode(ast.values[child], REFERENTIAL_ACTION_SET_DEFAULT, out);
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<constraint_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_CONSTRAINT))
+        return false;
+    constraint_type_t type;
+    if (! decode(ast.values[node], CONSTRAINT_TYPE_CHECK, type))
+        return false;
+    switch (type) {
+        case CONSTRAINT_TYPE_NOT_NULL:
+            out = std::make_unique<not_null_constraint_t>();
+            break;
+        case CONSTRAINT_TYPE_UNIQUE:
+        case CONSTRAINT_TYPE_PRIMARY_KEY:
+            out = std::make_unique<unique_constraint_t>(
+                    type == CONSTRAINT_TYPE_PRIMARY_KEY);
+            break;
+        case CONSTRAINT_TYPE_FOREIGN_KEY:
+            {
+                lexeme_t referenced_table =
+                    name(ast, node, FLAT_ROLE_REFERENCED_TABLE);
+                std::vector<lexeme_t> referenced_columns;
+                match_type_t match_type;
+                referential_action_t on_update;
+                referential_action_t on_delete;
+                if (! referenced_table ||
+                        ! names(ast, node, FLAT_ROLE_REFERENCED_COLUMN,
+                                referenced_columns) ||
+                        ! decode(ast.params[node], MATCH_TYPE_PARTIAL,
+                                 match_type) ||
+                        ! referential_action(ast, node, FLAT_ROLE_ON_UPDATE,
+                                             on_update) ||
+                        ! referential_action(ast, node, FLAT_ROLE_ON_DELETE,
+                                             on_delete))
+                    return false;
+                out = std::make_unique<foreign_key_constraint_t>(
+                        referenced_table, referenced_columns, match_type,
+                        on_update, on_delete);
+            }
+            break;
+        default:
+            out = std::make_unique<constraint_t>(type);
+            break;
+    }
+    out->name = ast.lexeme(node);
+    return names(ast, node, FLAT_ROLE_COLUMN, out->columns);
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<column_definition_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_COLUMN_DEFINITION) ||
+            ! ast.lexeme(node))
+        return false;
+    lexeme_t column_name = ast.lexeme(node);
+    std::unique_ptr<data_type_descriptor_t> data_type;
+    std::unique_ptr<default_descriptor_t> default_descriptor;
+    std::vector<std::unique_ptr<constraint_t>> constraints;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        switch (ast.type(x)) {
+            case FLAT_NODE_TYPE_DATA_TYPE:
+                if (! build(ast, x, data_type))
+                    return false;
+                break;
+            case FLAT_NODE_TYPE_DEFAULT:
+                if (! build(ast, x, default_descriptor))
+                    return false;
+                break;
+            case FLAT_NODE_TYPE_CONSTRAINT:
+                {
+                    std::unique_ptr<constraint_t> c;
+                    if (! build(ast, x, c))
+                        return false;
+                    constraints.emplace_back(std::move(c));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (! data_type)
+        return false;
+    out = std::make_unique<column_definition_t>(
+            column_name, data_type, default_descriptor, constraints);
+    out->collate = name(ast, node, FLAT_ROLE_COLLATION);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<case_expression_t>& out) {
+    lexeme_t lexeme = ast.lexeme(node);
+    std::unique_ptr<value_expression_t> else_value;
+    if (! build_optional(ast, node, FLAT_ROLE_ELSE, else_value))
+        return false;
+    case_expression_type_t type;
+    if (! decode(ast.params[node], CASE_EXPRESSION_TYPE_SEARCHED_CASE, type))
+        return false;
+    switch (type) {
+        case CASE_EXPRESSION_TYPE_COALESCE_FUNCTION:
+            {
+                std::vector<std::unique_ptr<value_expression_t>> values;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    std::unique_ptr<value_expression_t> value;
+                    if (! build(ast, x, value))
+                        return false;
+                    values.emplace_back(std::move(value));
+                }
+                if (values.empty())
+                    return false;
+                out = std::make_unique<coalesce_function_t>(lexeme, values);
+            }
+            return true;
+        case CASE_EXPRESSION_TYPE_NULLIF_FUNCTION:
+            {
+                std::unique_ptr<value_expression_t> left;
+                std::unique_ptr<value_expression_t> right;
+                if (! build_required(ast, node, FLAT_ROLE_LEFT, left) ||
+                        ! build_required(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                out = std::make_unique<nullif_function_t>(lexeme, left, right);
+            }
+            return true;
+        case CASE_EXPRESSION_TYPE_SIMPLE_CASE:
+            {
+                std::unique_ptr<value_expression_t> operand;
+                if (! build_required(ast, node, FLAT_ROLE_OPERAND, operand))
+                    return false;
+                std::vector<simple_case_expression_when_clause_t> when_clauses;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    if (ast.type(x) != FLAT_NODE_TYPE_CASE_WHEN)
+                        continue;
+                    std::unique_ptr<value_expression_t> when_operand;
+                    std::unique_ptr<value_expression_t> result;
+                    if (! build_required(ast, x, FLAT_ROLE_WHEN, when_operand) ||
+                            ! build_required(ast, x, FLAT_ROLE_RESULT, result))
+                        return false;
+                    when_clauses.emplace_back(when_operand, result);
+                }
+                if (when_clauses.empty())
+                    return false;
+                out = std::make_unique<simple_case_expression_t>(
+                        lexeme, operand, when_clauses, else_value);
+            }
+            return true;
+        case CASE_EXPRESSION_TYPE_SEARCHED_CASE:
+            {
+                std::vector<searched_case_expression_when_clause_t> when_clauses;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    if (ast.type(x) != FLAT_NODE_TYPE_CASE_WHEN)
+                        continue;
+                    std::unique_ptr<search_condition_t> condition;
+                    std::unique_ptr<value_expression_t> result;
+                    if (! build_required(ast, x, FLAT_ROLE_WHEN, condition) ||
+                            ! build_required(ast, x, FLAT_ROLE_RESULT, result))
+                        return false;
+                    when_clauses.emplace_back(condition, result);
+                }
+                if (when_clauses.empty())
+                    return false;
+                out = std::make_unique<searched_case_expression_t>(
+                        lexeme, when_clauses, else_value);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<value_expression_primary_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY))
+        return false;
+    vep_type_t vep_type;
+    if (! decode(ast.values[node], VEP_TYPE_CAST_SPECIFICATION, vep_type))
+        return false;
+    lexeme_t lexeme = ast.lexeme(node);
+    switch (vep_type) {
+        case VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION:
+            {
+                // Literals, parameters and variables are written out as
+                // their lexeme, the rest as a keyword
+                uvs_type_t uvs_type;
+                if (! decode(ast.params[node], UVS_TYPE_VALUE, uvs_type))
+                    return false;
+                if (uvs_type <= UVS_TYPE_VARIABLE && ! lexeme)
+                    return false;
+                out = std::make_unique<unsigned_value_specification_t>(
+                        uvs_type, lexeme);
+            }
+            return true;
+        case VEP_TYPE_COLUMN_REFERENCE:
+            if (! lexeme)
+                return false;
+            out = std::make_unique<value_expression_primary_t>(vep_type, lexeme);
+            return true;
+        case VEP_TYPE_SET_FUNCTION_SPECIFICATION:
+            {
+                set_function_type_t func_type;
+                if (! decode(ast.params[node], SET_FUNCTION_TYPE_SUM,
+                             func_type))
+                    return false;
+                std::unique_ptr<value_expression_t> value;
+                if (! build_optional(ast, node, FLAT_ROLE_OPERAND, value))
+                    return false;
+                if (! value && ! ast.has_flag(node, FLAT_FLAG_STAR))
+                    return false;
+                out = std::make_unique<set_function_t>(
+                        func_type, lexeme,
+                        ast.has_flag(node, FLAT_FLAG_STAR),
+                        ast.has_flag(node, FLAT_FLAG_DISTINCT), value);
+            }
+            return true;
+        case VEP_TYPE_SCALAR_SUBQUERY:
+            {
+                std::unique_ptr<query_expression_t> query;
+                if (! build_required(ast, node, FLAT_ROLE_QUERY, query))
+                    return false;
+                out = std::make_unique<scalar_subquery_t>(query, lexeme);
+            }
+            return true;
+        case VEP_TYPE_PARENTHESIZED_VALUE_EXPRESSION:
+            {
+                std::unique_ptr<value_expression_t> value;
+                if (! build(ast, ast.first_children[node], value))
+                    return false;
+                out = std::make_unique<parenthesized_value_expression_t>(
+                        value, lexeme);
+            }
+            return true;
+        case VEP_TYPE_CASE_EXPRESSION:
+            {
+                std::unique_ptr<case_expression_t> ce;
+                if (! build(ast, node, ce))
+                    return false;
+                out = std::move(ce);
+            }
+            return true;
+        default:
+            out = std::make_unique<value_expression_primary_t>(vep_type, lexeme);
+            return true;
+    }
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_primary_t>& out) {
+    if (is_type(ast, node, FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY)) {
+        std::unique_ptr<value_expression_primary_t> primary;
+        if (! build(ast, node, primary))
+            return false;
+        out = std::make_unique<numeric_value_t>(primary);
+        return true;
+    }
+    if (! is_type(ast, node, FLAT_NODE_TYPE_NUMERIC_FUNCTION))
+        return false;
+    numeric_function_type_t type;
+    if (! decode(ast.values[node], NUMERIC_FUNCTION_TYPE_BIT_LENGTH, type))
+        return false;
+    std::unique_ptr<value_expression_t> operand;
+    if (! build_required(ast, node, FLAT_ROLE_OPERAND, operand))
+        return false;
+    switch (type) {
+        case NUMERIC_FUNCTION_TYPE_POSITION:
+            {
+                std::unique_ptr<value_expression_t> subject;
+                if (! build_required(ast, node, FLAT_ROLE_SUBJECT, subject))
+                    return false;
+                out = std::make_unique<position_expression_t>(operand, subject);
+            }
+            return true;
+        case NUMERIC_FUNCTION_TYPE_EXTRACT:
+            {
+                interval_unit_t unit;
+                if (! decode(ast.params[node], INTERVAL_UNIT_SECOND, unit))
+                    return false;
+                out = std::make_unique<extract_expression_t>(unit, operand);
+            }
+            return true;
+        case NUMERIC_FUNCTION_TYPE_CHAR_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_OCTET_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_BIT_LENGTH:
+            out = std::make_unique<length_expression_t>(type, operand);
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_factor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_NUMERIC_FACTOR))
+        return false;
+    std::unique_ptr<numeric_primary_t> primary;
+    if (! build(ast, ast.first_children[node], primary))
+        return false;
+    out = std::make_unique<numeric_factor_t>(primary, sign_of(ast, node));
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<numeric_term_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_NUMERIC_TERM))
+        return false;
+    numeric_op_t op;
+    std::unique_ptr<numeric_factor_t> left;
+    std::unique_ptr<numeric_factor_t> right;
+    if (! decode(ast.params[node], NUMERIC_OP_DIVIDE, op) ||
+            ! build_required(ast, node, FLAT_ROLE_LEFT, left) ||
+            ! build_optional(ast, node, FLAT_ROLE_RIGHT, right))
+        return false;
+    out = std::make_unique<numeric_term_t>(left);
+    out->op = op;
+    out->right = std::move(right);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<string_function_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_STRING_FUNCTION))
+        return false;
+    string_function_type_t type;
+    if (! decode(ast.values[node], STRING_FUNCTION_TYPE_TRIM, type))
+        return false;
+    std::unique_ptr<value_expression_t> operand;
+    if (! build_required(ast, node, FLAT_ROLE_OPERAND, operand))
+        return false;
+    switch (type) {
+        case STRING_FUNCTION_TYPE_SUBSTRING:
+            {
+                std::unique_ptr<value_expression_t> start;
+                std::unique_ptr<value_expression_t> length;
+                if (! build_required(ast, node, FLAT_ROLE_START, start) ||
+                        ! build_optional(ast, node, FLAT_ROLE_LENGTH, length))
+                    return false;
+                out = std::make_unique<substring_function_t>(
+                        operand, start, length);
+            }
+            return true;
+        case STRING_FUNCTION_TYPE_UPPER:
+        case STRING_FUNCTION_TYPE_LOWER:
+            out = std::make_unique<string_function_t>(type, operand);
+            return true;
+        case STRING_FUNCTION_TYPE_CONVERT:
+            if (! ast.lexeme(node))
+                return false;
+            out = std::make_unique<convert_function_t>(
+                    operand, ast.lexeme(node));
+            return true;
+        case STRING_FUNCTION_TYPE_TRANSLATE:
+            if (! ast.lexeme(node))
+                return false;
+            out = std::make_unique<translate_function_t>(
+                    operand, ast.lexeme(node));
+            return true;
+        case STRING_FUNCTION_TYPE_TRIM:
+            {
+                trim_specification_t specification;
+                std::unique_ptr<value_expression_t> trim_character;
+                if (! decode(ast.params[node], TRIM_SPECIFICATION_BOTH,
+                             specification) ||
+                        ! build_optional(ast, node, FLAT_ROLE_TRIM_CHARACTER,
+                                         trim_character))
+                    return false;
+                out = std::make_unique<trim_function_t>(
+                        operand, specification, trim_character);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<character_factor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_CHARACTER_FACTOR))
+        return false;
+    flat_index_t child = ast.first_children[node];
+    std::unique_ptr<character_primary_t> primary;
+    if (is_type(ast, child, FLAT_NODE_TYPE_STRING_FUNCTION)) {
+        std::unique_ptr<string_function_t> func;
+        if (! build(ast, child, func))
+            return false;
+        primary = std::make_unique<character_primary_t>(func);
+    } else {
+        std::unique_ptr<value_expression_primary_t> value;
+        if (! build(ast, child, value))
+            return false;
+        primary = std::make_unique<character_primary_t>(value);
+    }
+    out = std::make_unique<character_factor_t>(primary, ast.lexeme(node));
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<datetime_factor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_DATETIME_FACTOR))
+        return false;
+    flat_index_t child = ast.first_children[node];
+    std::unique_ptr<datetime_primary_t> primary;
+    if (is_type(ast, child, FLAT_NODE_TYPE_DATETIME_FUNCTION)) {
+        datetime_function_type_t func_type;
+        if (! decode(ast.values[child],
+                     DATETIME_FUNCTION_TYPE_CURRENT_TIMESTAMP, func_type))
+            return false;
+        primary = std::make_unique<current_datetime_function_t>(
+                func_type, ast.params[child]);
+    } else {
+        std::unique_ptr<value_expression_primary_t> value;
+        if (! build(ast, child, value))
+            return false;
+        primary = std::make_unique<datetime_value_t>(value);
+    }
+    out = std::make_unique<datetime_factor_t>(primary, ast.lexeme(node));
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_qualifier_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_INTERVAL_QUALIFIER))
+        return false;
+    flat_index_t start = ast.child(node, FLAT_ROLE_START);
+    interval_unit_t unit;
+    if (! is_type(ast, start, FLAT_NODE_TYPE_DATETIME_FIELD) ||
+            ! decode(ast.values[start], INTERVAL_UNIT_SECOND, unit))
+        return false;
+    out = std::make_unique<interval_qualifier_t>(
+            unit, ast.params[start], ast.params2[start]);
+    flat_index_t end = ast.child(node, FLAT_ROLE_END);
+    if (end == FLAT_NONE)
+        return true;
+    if (! is_type(ast, end, FLAT_NODE_TYPE_DATETIME_FIELD) ||
+            ! decode(ast.values[end], INTERVAL_UNIT_SECOND, unit))
+        return false;
+    out->end = std::make_unique<datetime_field_t>(
+            unit, ast.params[end], ast.params2[end]);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_factor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_INTERVAL_FACTOR))
+        return false;
+    std::unique_ptr<value_expression_primary_t> value;
+    std::unique_ptr<interval_qualifier_t> qualifier;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        bool built;
+        if (ast.type(x) == FLAT_NODE_TYPE_INTERVAL_QUALIFIER)
+            built = build(ast, x, qualifier);
+        else
+            built = build(ast, x, value);
+        if (! built)
+            return false;
+    }
+    if (! value)
+        return false;
+    std::unique_ptr<interval_primary_t> primary =
+        std::make_unique<interval_primary_t>(value, qualifier);
+    out = std::make_unique<interval_factor_t>(sign_of(ast, node), primary);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<interval_term_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_INTERVAL_TERM))
+        return false;
+    numeric_op_t op;
+    std::unique_ptr<interval_factor_t> left;
+    std::unique_ptr<numeric_factor_t> right;
+    if (! decode(ast.params[node], NUMERIC_OP_DIVIDE, op) ||
+            ! build_required(ast, node, FLAT_ROLE_LEFT, left) ||
+            ! build_optional(ast, node, FLAT_ROLE_RIGHT, right))
+        return false;
+    out = std::make_unique<interval_term_t>(left);
+    out->op = op;
+    out->right = std::move(right);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<value_expression_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_VALUE_EXPRESSION))
+        return false;
+    numeric_op_t op;
+    value_expression_type_t type;
+    if (! decode(ast.params[node], NUMERIC_OP_DIVIDE, op) ||
+            ! decode(ast.values[node],
+                     VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION, type))
+        return false;
+    switch (type) {
+        case VALUE_EXPRESSION_TYPE_NUMERIC_EXPRESSION:
+            {
+                std::unique_ptr<numeric_term_t> left;
+                std::unique_ptr<numeric_term_t> right;
+                if (! build_required(ast, node, FLAT_ROLE_LEFT, left) ||
+                        ! build_optional(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                std::unique_ptr<numeric_expression_t> sub =
+                    std::make_unique<numeric_expression_t>(left);
+                sub->op = op;
+                sub->right = std::move(right);
+                out = std::move(sub);
+            }
+            return true;
+        case VALUE_EXPRESSION_TYPE_STRING_EXPRESSION:
+            {
+                std::vector<std::unique_ptr<character_factor_t>> values;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    std::unique_ptr<character_factor_t> value;
+                    if (! build(ast, x, value))
+                        return false;
+                    values.emplace_back(std::move(value));
+                }
+                if (values.empty())
+                    return false;
+                out = std::make_unique<character_value_expression_t>(values);
+            }
+            return true;
+        case VALUE_EXPRESSION_TYPE_DATETIME_EXPRESSION:
+            {
+                std::unique_ptr<datetime_factor_t> factor;
+                std::unique_ptr<interval_term_t> right;
+                if (! build_required(ast, node, FLAT_ROLE_LEFT, factor) ||
+                        ! build_optional(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                std::unique_ptr<datetime_term_t> left =
+                    std::make_unique<datetime_term_t>(factor);
+                std::unique_ptr<datetime_value_expression_t> sub =
+                    std::make_unique<datetime_value_expression_t>(left);
+                sub->op = op;
+                sub->right = std::move(right);
+                out = std::move(sub);
+            }
+            return true;
+        case VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION:
+            {
+                std::unique_ptr<interval_term_t> left;
+                std::unique_ptr<interval_term_t> right;
+                if (! build_required(ast, node, FLAT_ROLE_LEFT, left) ||
+                        ! build_optional(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                std::unique_ptr<interval_value_expression_t> sub =
+                    std::make_unique<interval_value_expression_t>(left);
+                sub->op = op;
+                sub->right = std::move(right);
+                out = std::move(sub);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<row_value_constructor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_ROW_VALUE_CONSTRUCTOR))
+        return false;
+    rvc_type_t rvc_type;
+    if (! decode(ast.values[node], RVC_TYPE_SUBQUERY, rvc_type))
+        return false;
+    switch (rvc_type) {
+        case RVC_TYPE_ELEMENT:
+            {
+                rvc_element_type_t type;
+                if (! decode(ast.params[node], RVC_ELEMENT_TYPE_DEFAULT, type))
+                    return false;
+                if (type != RVC_ELEMENT_TYPE_VALUE_EXPRESSION) {
+                    out = std::make_unique<row_value_constructor_element_t>(type);
+                    return true;
+                }
+                std::unique_ptr<value_expression_t> value;
+                if (! build(ast, ast.first_children[node], value))
+                    return false;
+                out = std::make_unique<row_value_expression_t>(value);
+            }
+            return true;
+        case RVC_TYPE_LIST:
+            {
+                std::vector<std::unique_ptr<row_value_constructor_t>> elements;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    std::unique_ptr<row_value_constructor_t> element;
+                    if (! build(ast, x, element))
+                        return false;
+                    elements.emplace_back(std::move(element));
+                }
+                if (elements.empty())
+                    return false;
+                out = std::make_unique<row_value_constructor_list_t>(elements);
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<predicate_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_PREDICATE))
+        return false;
+    bool reverse_op = ast.has_flag(node, FLAT_FLAG_NOT);
+    std::unique_ptr<row_value_constructor_t> left;
+    if (! build_optional(ast, node, FLAT_ROLE_LEFT, left))
+        return false;
+    std::unique_ptr<query_expression_t> subquery;
+    if (! build_optional(ast, node, FLAT_ROLE_QUERY, subquery))
+        return false;
+    predicate_type_t type;
+    if (! decode(ast.values[node], PREDICATE_TYPE_OVERLAPS, type))
+        return false;
+    switch (type) {
+        case PREDICATE_TYPE_EXISTS:
+        case PREDICATE_TYPE_UNIQUE:
+            if (! subquery)
+                return false;
+            break;
+        default:
+            if (! left)
+                return false;
+            break;
+    }
+    switch (type) {
+        case PREDICATE_TYPE_COMPARISON:
+            {
+                comp_op_t op;
+                std::unique_ptr<row_value_constructor_t> right;
+                if (! decode(ast.params[node], COMP_OP_GREATER_EQUAL, op) ||
+                        ! build_required(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                out = std::make_unique<comp_predicate_t>(op, left, right);
+            }
+            return true;
+        case PREDICATE_TYPE_BETWEEN:
+            {
+                std::unique_ptr<row_value_constructor_t> lower;
+                std::unique_ptr<row_value_constructor_t> upper;
+                if (! build_required(ast, node, FLAT_ROLE_LOWER, lower) ||
+                        ! build_required(ast, node, FLAT_ROLE_UPPER, upper))
+                    return false;
+                out = std::make_unique<between_predicate_t>(
+                        left, lower, upper, reverse_op);
+            }
+            return true;
+        case PREDICATE_TYPE_LIKE:
+            {
+                std::unique_ptr<value_expression_t> pattern;
+                std::unique_ptr<value_expression_t> escape_char;
+                if (! build_required(ast, node, FLAT_ROLE_PATTERN, pattern) ||
+                        ! build_optional(ast, node, FLAT_ROLE_ESCAPE, escape_char))
+                    return false;
+                out = std::make_unique<like_predicate_t>(
+                        left, pattern, escape_char, reverse_op);
+            }
+            return true;
+        case PREDICATE_TYPE_NULL:
+            out = std::make_unique<null_predicate_t>(left, reverse_op);
+            return true;
+        case PREDICATE_TYPE_IN_VALUES:
+            {
+                std::vector<std::unique_ptr<value_expression_t>> values;
+                for (flat_index_t x = ast.first_children[node];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    if (ast.role(x) != FLAT_ROLE_VALUE)
+                        continue;
+                    std::unique_ptr<value_expression_t> value;
+                    if (! build(ast, x, value))
+                        return false;
+                    values.emplace_back(std::move(value));
+                }
+                if (values.empty())
+                    return false;
+                out = std::make_unique<in_values_predicate_t>(
+                        left, values, reverse_op);
+            }
+            return true;
+        case PREDICATE_TYPE_IN_SUBQUERY:
+            if (! subquery)
+                return false;
+            out = std::make_unique<in_subquery_predicate_t>(
+                    left, subquery, reverse_op);
+            return true;
+        case PREDICATE_TYPE_QUANTIFIED_COMPARISON:
+            {
+                comp_op_t op;
+                quantifier_t quantifier;
+                if (! subquery ||
+                        ! decode(ast.params[node], COMP_OP_GREATER_EQUAL, op) ||
+                        ! decode(ast.params2[node], QUANTIFIER_ANY, quantifier))
+                    return false;
+                out = std::make_unique<quantified_comparison_predicate_t>(
+                        op, quantifier, left, subquery);
+            }
+            return true;
+        case PREDICATE_TYPE_EXISTS:
+            out = std::make_unique<exists_predicate_t>(subquery);
+            return true;
+        case PREDICATE_TYPE_UNIQUE:
+            out = std::make_unique<unique_predicate_t>(subquery);
+            return true;
+        case PREDICATE_TYPE_MATCH:
+            if (! subquery)
+                return false;
+            out = std::make_unique<match_predicate_t>(
+                    left, ast.has_flag(node, FLAT_FLAG_MATCH_UNIQUE),
+                    ast.has_flag(node, FLAT_FLAG_MATCH_PARTIAL), subquery);
+            return true;
+        case PREDICATE_TYPE_OVERLAPS:
+            {
+                std::unique_ptr<row_value_constructor_t> right;
+                if (! build_required(ast, node, FLAT_ROLE_RIGHT, right))
+                    return false;
+                out = std::make_unique<overlaps_predicate_t>(left, right);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<boolean_factor_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_BOOLEAN_FACTOR))
+        return false;
+    flat_index_t child = ast.first_children[node];
+    std::unique_ptr<boolean_primary_t> primary;
+    if (is_type(ast, child, FLAT_NODE_TYPE_SEARCH_CONDITION)) {
+        std::unique_ptr<search_condition_t> condition;
+        if (! build(ast, child, condition))
+            return false;
+        primary = std::make_unique<boolean_primary_t>(condition);
+    } else {
+        std::unique_ptr<predicate_t> predicate;
+        if (! build(ast, child, predicate))
+            return false;
+        primary = std::make_unique<boolean_primary_t>(predicate);
+    }
+    out = std::make_unique<boolean_factor_t>(
+            primary, ast.has_flag(node, FLAT_FLAG_NOT));
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<search_condition_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_SEARCH_CONDITION))
+        return false;
+    out = std::make_unique<search_condition_t>();
+    for (flat_index_t term_node = ast.first_children[node];
+            term_node != FLAT_NONE; term_node = ast.next_siblings[term_node]) {
+        if (ast.type(term_node) != FLAT_NODE_TYPE_BOOLEAN_TERM)
+            return false;
+        // The list of AND'd factors becomes a chain of terms again
+        std::unique_ptr<boolean_term_t> term;
+        boolean_term_t* last = nullptr;
+        for (flat_index_t x = ast.first_children[term_node]; x != FLAT_NONE;
+                x = ast.next_siblings[x]) {
+            std::unique_ptr<boolean_factor_t> factor;
+            if (! build(ast, x, factor))
+                return false;
+            std::unique_ptr<boolean_term_t> next =
+                std::make_unique<boolean_term_t>(factor);
+            boolean_term_t* next_p = next.get();
+            if (last == nullptr)
+                term = std::move(next);
+            else
+                last->and_operand = std::move(next);
+            last = next_p;
+        }
+        if (! term)
+            return false;
+        out->terms.emplace_back(std::move(term));
+    }
+    return ! out->terms.empty();
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<table_expression_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_TABLE_EXPRESSION))
+        return false;
+    std::vector<std::unique_ptr<table_reference_t>> referenced_tables;
+    std::unique_ptr<search_condition_t> where_condition;
+    std::vector<grouping_column_reference_t> group_by_columns;
+    std::unique_ptr<search_condition_t> having_condition;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        switch (ast.role(x)) {
+            case FLAT_ROLE_WHERE:
+                if (! build(ast, x, where_condition))
+                    return false;
+                continue;
+            case FLAT_ROLE_HAVING:
+                if (! build(ast, x, having_condition))
+                    return false;
+                continue;
+            default:
+                break;
+        }
+        if (ast.type(x) == FLAT_NODE_TYPE_GROUPING_COLUMN) {
+            if (! ast.lexeme(x))
+                return false;
+            group_by_columns.emplace_back(ast.lexeme(x));
+            group_by_columns.back().collation =
+                name(ast, x, FLAT_ROLE_COLLATION);
+            continue;
+        }
+        std::unique_ptr<table_reference_t> tr;
+        if (! build(ast, x, tr))
+            return false;
+        referenced_tables.emplace_back(std::move(tr));
+    }
+    if (referenced_tables.empty())
+        return false;
+    out = std::make_unique<table_expression_t>(
+            referenced_tables, where_condition, group_by_columns,
+            having_condition);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<query_specification_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_QUERY_SPECIFICATION))
+        return false;
+    std::vector<derived_column_t> selected_columns;
+    std::unique_ptr<table_expression_t> table_expression;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        if (ast.type(x) == FLAT_NODE_TYPE_TABLE_EXPRESSION) {
+            if (! build(ast, x, table_expression))
+                return false;
+            continue;
+        }
+        if (ast.type(x) != FLAT_NODE_TYPE_DERIVED_COLUMN)
+            return false;
+        if (ast.has_flag(x, FLAT_FLAG_STAR)) {
+            selected_columns.emplace_back();
+        } else {
+            std::unique_ptr<value_expression_t> value;
+            if (! build(ast, ast.first_children[x], value))
+                return false;
+            selected_columns.emplace_back(value);
+        }
+        selected_columns.back().alias = ast.lexeme(x);
+    }
+    if (selected_columns.empty() || ! table_expression)
+        return false;
+    out = std::make_unique<query_specification_t>(
+            ast.has_flag(node, FLAT_FLAG_DISTINCT), selected_columns,
+            table_expression);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<query_expression_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_QUERY_EXPRESSION))
+        return false;
+    flat_index_t child = ast.first_children[node];
+    if (child == FLAT_NONE)
+        return false;
+    if (ast.values[node] == QUERY_EXPRESSION_TYPE_JOINED_TABLE) {
+        std::unique_ptr<table_reference_t> joined_table;
+        if (! build(ast, child, joined_table))
+            return false;
+        out = std::make_unique<joined_table_query_expression_t>(joined_table);
+        return true;
+    }
+    std::unique_ptr<non_join_query_primary_t> primary;
+    if (ast.type(child) == FLAT_NODE_TYPE_TABLE_VALUE_CONSTRUCTOR) {
+        std::vector<std::unique_ptr<row_value_constructor_t>> values;
+        for (flat_index_t x = ast.first_children[child]; x != FLAT_NONE;
+                x = ast.next_siblings[x]) {
+            std::unique_ptr<row_value_constructor_t> value;
+            if (! build(ast, x, value))
+                return false;
+            values.emplace_back(std::move(value));
+        }
+        if (values.empty())
+            return false;
+        std::unique_ptr<table_value_constructor_t> tvc =
+            std::make_unique<table_value_constructor_t>(values);
+        primary = std::make_unique<table_value_constructor_non_join_query_primary_t>(tvc);
+    } else {
+        std::unique_ptr<query_specification_t> query_spec;
+        if (! build(ast, child, query_spec))
+            return false;
+        primary = std::make_unique<query_specification_non_join_query_primary_t>(query_spec);
+    }
+    std::unique_ptr<non_join_query_term_t> term =
+        std::make_unique<non_join_query_term_t>(primary);
+    out = std::make_unique<non_join_query_expression_t>(term);
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<join_target_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_JOIN))
+        return false;
+    join_type_t join_type;
+    if (! decode(ast.values[node], JOIN_TYPE_UNION, join_type))
+        return false;
+    std::unique_ptr<table_reference_t> table_ref;
+    std::unique_ptr<search_condition_t> condition;
+    std::vector<lexeme_t> named_columns;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        bool built = true;
+        switch (ast.role(x)) {
+            case FLAT_ROLE_ON:
+                built = build(ast, x, condition);
+                break;
+            case FLAT_ROLE_COLUMN:
+                built = bool(ast.lexeme(x));
+                named_columns.push_back(ast.lexeme(x));
+                break;
+            default:
+                built = build(ast, x, table_ref);
+                break;
+        }
+        if (! built)
+            return false;
+    }
+    if (! table_ref)
+        return false;
+    if (condition) {
+        std::unique_ptr<join_specification_t> spec =
+            std::make_unique<join_specification_t>(condition);
+        out = std::make_unique<join_target_t>(join_type, table_ref, spec);
+    } else if (! named_columns.empty()) {
+        std::unique_ptr<join_specification_t> spec =
+            std::make_unique<join_specification_t>(named_columns);
+        out = std::make_unique<join_target_t>(join_type, table_ref, spec);
+    } else {
+        out = std::make_unique<join_target_t>(join_type, table_ref);
+    }
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<table_reference_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_TABLE_REFERENCE))
+        return false;
+    // Both a table's name and a derived table's alias are required
+    lexeme_t lexeme = ast.lexeme(node);
+    if (! lexeme)
+        return false;
+    if (ast.values[node] == TABLE_REFERENCE_TYPE_TABLE) {
+        lexeme_t alias = name(ast, node, FLAT_ROLE_ALIAS);
+        std::unique_ptr<table_t> t = std::make_unique<table_t>(lexeme, alias);
+        if (! names(ast, node, FLAT_ROLE_COLUMN, t->correlation_spec->columns))
+            return false;
+        out = std::move(t);
+    } else {
+        std::unique_ptr<query_expression_t> query;
+        if (! build_required(ast, node, FLAT_ROLE_QUERY, query))
+            return false;
+        std::unique_ptr<derived_table_t> dt =
+            std::make_unique<derived_table_t>(lexeme, query);
+        if (! names(ast, node, FLAT_ROLE_COLUMN, dt->correlation_spec.columns))
+            return false;
+        out = std::move(dt);
+    }
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        if (ast.type(x) != FLAT_NODE_TYPE_JOIN)
+            continue;
+        std::unique_ptr<join_target_t> target;
+        if (! build(ast, x, target))
+            return false;
+        out->join(target);
+    }
+    return true;
+}
+
+bool build(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<alter_table_action_t>& out) {
+    if (! is_type(ast, node, FLAT_NODE_TYPE_ALTER_TABLE_ACTION))
+        return false;
+    lexeme_t lexeme = ast.lexeme(node);
+    alter_table_action_type_t type;
+    if (! decode(ast.values[node], ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT,
+                 type))
+        return false;
+    switch (type) {
+        case ALTER_TABLE_ACTION_TYPE_ADD_COLUMN:
+            {
+                std::unique_ptr<column_definition_t> column_def;
+                if (! build(ast, ast.first_children[node], column_def))
+                    return false;
+                out = std::make_unique<add_column_action_t>(column_def);
+            }
+            return true;
+        case ALTER_TABLE_ACTION_TYPE_ALTER_COLUMN:
+            {
+                if (! lexeme)
+                    return false;
+                std::unique_ptr<alter_column_action_t> sub =
+                    std::make_unique<alter_column_action_t>(lexeme);
+                if (! decode(ast.params[node],
+                             ALTER_COLUMN_ACTION_TYPE_DROP_DEFAULT,
+                             sub->alter_column_action_type))
+                    return false;
+                if (sub->alter_column_action_type ==
+                        ALTER_COLUMN_ACTION_TYPE_SET_DEFAULT &&
+                        ! build(ast, ast.first_children[node],
+                                sub->default_descriptor))
+                    return false;
+                out = std::move(sub);
+            }
+            return true;
+        case ALTER_TABLE_ACTION_TYPE_DROP_COLUMN:
+            {
+                drop_behaviour_t drop_behaviour;
+                if (! lexeme ||
+                        ! decode(ast.params[node], DROP_BEHAVIOUR_RESTRICT,
+                                 drop_behaviour))
+                    return false;
+                out = std::make_unique<drop_column_action_t>(
+                        lexeme, drop_behaviour);
+            }
+            return true;
+        case ALTER_TABLE_ACTION_TYPE_ADD_CONSTRAINT:
+            {
+                std::unique_ptr<constraint_t> constraint;
+                if (! build(ast, ast.first_children[node], constraint))
+                    return false;
+                out = std::make_unique<add_constraint_action_t>(constraint);
+            }
+            return true;
+        case ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT:
+            {
+                drop_behaviour_t drop_behaviour;
+                if (! lexeme ||
+                        ! decode(ast.params[node], DROP_BEHAVIOUR_RESTRICT,
+                                 drop_behaviour))
+                    return false;
+                out = std::make_unique<drop_constraint_action_t>(
+                        lexeme, drop_behaviour);
+            }
+            return true;
+    }
+    return false;
+}
+
+bool build_grant(const flat_ast_t& ast, flat_index_t node, std::unique_ptr<statement_t>& out) {
+    std::vector<std::unique_ptr<grant_action_t>> privileges;
+    for (flat_index_t x = ast.first_children[node]; x != FLAT_NONE;
+            x = ast.next_siblings[x]) {
+        if (ast.type(x) != FLAT_NODE_TYPE_GRANT_ACTION)
+            continue;
+        grant_action_type_t type;
+        if (! decode(ast.values[x], GRANT_ACTION_TYPE_USAGE, type))
+            return false;
+        switch (type) {
+            case GRANT_ACTION_TYPE_UPDATE:
+            case GRANT_ACTION_TYPE_INSERT:
+            case GRANT_ACTION_TYPE_REFERENCES:
+                {
+                    std::vector<lexeme_t> columns;
+                    if (! names(ast, x, FLAT_ROLE_COLUMN, columns))
+                        return false;
+                    privileges.emplace_back(
+                            std::make_unique<column_list_grant_action_t>(
+                                type, columns));
+                }
+                break;
+            case GRANT_ACTION_TYPE_SELECT:
+            case GRANT_ACTION_TYPE_DELETE:
+            case GRANT_ACTION_TYPE_USAGE:
+                privileges.emplace_back(std::make_unique<grant_action_t>(type));
+                break;
+            default:
+                return false;
+        }
+    }
+    lexeme_t on = ast.lexeme(node);
+    lexeme_t to = name(ast, node, FLAT_ROLE_GRANTEE);
+    grant_object_type_t object_type;
+    if (! on || ! to ||
+            ! decode(ast.params[node], GRANT_OBJECT_TYPE_TRANSLATION,
+                     object_type))
+        return false;
+    out = std::make_unique<grant_statement_t>(
+            object_type, on, to,
+            ast.has_flag(node, FLAT_FLAG_WITH_GRANT_OPTION), privileges);
+    return true;
+}
+
+} // namespace
+
+bool unflatten(
+        const flat_ast_t& ast,
+        flat_index_t root,
+        std::unique_ptr<statement_t>& out) {
+    if (! is_type(ast, root, FLAT_NODE_TYPE_STATEMENT))
+        return false;
+    statement_type_t type;
+    if (! decode(ast.values[root], STATEMENT_TYPE_UPDATE, type))
+        return false;
+    lexeme_t name = ast.lexeme(root);
+    // Only the DROP statements record a drop behaviour
+    drop_behaviour_t drop_behaviour = DROP_BEHAVIOUR_CASCADE;
+    if ((type == STATEMENT_TYPE_DROP_SCHEMA ||
+                type == STATEMENT_TYPE_DROP_TABLE ||
+                type == STATEMENT_TYPE_DROP_VIEW) &&
+            ! decode(ast.params[root], DROP_BEHAVIOUR_RESTRICT, drop_behaviour))
+        return false;
+    // Every statement but a SELECT, COMMIT or ROLLBACK names what it works
+    // on. GRANT checks its own.
+    if (! name && type != STATEMENT_TYPE_SELECT &&
+            type != STATEMENT_TYPE_GRANT && type != STATEMENT_TYPE_COMMIT &&
+            type != STATEMENT_TYPE_ROLLBACK)
+        return false;
+    switch (type) {
+        case STATEMENT_TYPE_CREATE_SCHEMA:
+            {
+                lexeme_t authorization =
+                    sqltoast::name(ast, root, FLAT_ROLE_AUTHORIZATION);
+                lexeme_t charset = sqltoast::name(ast, root, FLAT_ROLE_CHARSET);
+                out = std::make_unique<create_schema_statement_t>(
+                        name, authorization, charset);
+            }
+            return true;
+        case STATEMENT_TYPE_DROP_SCHEMA:
+            out = std::make_unique<drop_schema_statement_t>(name, drop_behaviour);
+            return true;
+        case STATEMENT_TYPE_CREATE_TABLE:
+            {
+                std::vector<std::unique_ptr<column_definition_t>> column_defs;
+                std::vector<std::unique_ptr<constraint_t>> constraints;
+                for (flat_index_t x = ast.first_children[root];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    bool built;
+                    if (ast.type(x) == FLAT_NODE_TYPE_COLUMN_DEFINITION) {
+                        std::unique_ptr<column_definition_t> cd;
+                        built = build(ast, x, cd);
+                        column_defs.emplace_back(std::move(cd));
+                    } else {
+                        std::unique_ptr<constraint_t> c;
+                        built = build(ast, x, c);
+                        constraints.emplace_back(std::move(c));
+                    }
+                    if (! built)
+                        return false;
+                }
+                table_type_t table_type;
+                if (! decode(ast.params[root], TABLE_TYPE_TEMPORARY_LOCAL,
+                             table_type))
+                    return false;
+                out = std::make_unique<create_table_statement_t>(
+                        table_type, name, column_defs, constraints);
+            }
+            return true;
+        case STATEMENT_TYPE_DROP_TABLE:
+            out = std::make_unique<drop_table_statement_t>(name, drop_behaviour);
+            return true;
+        case STATEMENT_TYPE_ALTER_TABLE:
+            {
+                std::unique_ptr<alter_table_action_t> action;
+                if (! build(ast, ast.first_children[root], action))
+                    return false;
+                out = std::make_unique<alter_table_statement_t>(name, action);
+            }
+            return true;
+        case STATEMENT_TYPE_CREATE_VIEW:
+            {
+                check_option_t check_option;
+                if (! decode(ast.params[root], CHECK_OPTION_CASCADED,
+                             check_option))
+                    return false;
+                std::vector<lexeme_t> columns;
+                if (! sqltoast::names(ast, root, FLAT_ROLE_COLUMN, columns))
+                    return false;
+                std::unique_ptr<query_expression_t> query;
+                if (! build_required(ast, root, FLAT_ROLE_QUERY, query))
+                    return false;
+                out = std::make_unique<create_view_statement_t>(
+                        name, check_option, columns, query);
+            }
+            return true;
+        case STATEMENT_TYPE_DROP_VIEW:
+            out = std::make_unique<drop_view_statement_t>(name, drop_behaviour);
+            return true;
+        case STATEMENT_TYPE_SELECT:
+            {
+                std::unique_ptr<query_specification_t> query;
+                if (! build(ast, ast.first_children[root], query))
+                    return false;
+                out = std::make_unique<select_statement_t>(query);
+            }
+            return true;
+        case STATEMENT_TYPE_INSERT:
+            {
+                std::vector<lexeme_t> columns;
+                if (! sqltoast::names(ast, root, FLAT_ROLE_COLUMN, columns))
+                    return false;
+                std::unique_ptr<query_expression_t> query;
+                if (! build_optional(ast, root, FLAT_ROLE_QUERY, query))
+                    return false;
+                out = std::make_unique<insert_statement_t>(name, columns, query);
+            }
+            return true;
+        case STATEMENT_TYPE_DELETE:
+            {
+                std::unique_ptr<search_condition_t> where;
+                if (! build_optional(ast, root, FLAT_ROLE_WHERE, where))
+                    return false;
+                out = std::make_unique<delete_statement_t>(name, where);
+            }
+            return true;
+        case STATEMENT_TYPE_UPDATE:
+            {
+                std::vector<set_column_t> set_columns;
+                for (flat_index_t x = ast.first_children[root];
+                        x != FLAT_NONE; x = ast.next_siblings[x]) {
+                    if (ast.type(x) != FLAT_NODE_TYPE_SET_COLUMN)
+                        continue;
+                    set_column_type_t sc_type;
+                    if (! ast.lexeme(x) ||
+                            ! decode(ast.values[x],
+                                     SET_COLUMN_TYPE_VALUE_EXPRESSION, sc_type))
+                        return false;
+                    if (sc_type == SET_COLUMN_TYPE_NULL ||
+                            sc_type == SET_COLUMN_TYPE_DEFAULT) {
+                        set_columns.emplace_back(sc_type, ast.lexeme(x));
+                        continue;
+                    }
+                    std::unique_ptr<value_expression_t> value;
+                    if (! build(ast, ast.first_children[x], value))
+                        return false;
+                    set_columns.emplace_back(ast.lexeme(x), value);
+                }
+                if (set_columns.empty())
+                    return false;
+                std::unique_ptr<search_condition_t> where;
+                if (! build_optional(ast, root, FLAT_ROLE_WHERE, where))
+                    return false;
+                out = std::make_unique<update_statement_t>(
+                        name, set_columns, where);
+            }
+            return true;
+        case STATEMENT_TYPE_GRANT:
+            return build_grant(ast, root, out);
+        case STATEMENT_TYPE_COMMIT:
+        case STATEMENT_TYPE_ROLLBACK:
+            out = std::make_unique<statement_t>(type);
+            return true;
+    }
+    return false;
+}
+
+} // namespace sqltoast
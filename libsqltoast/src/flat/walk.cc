@@ -0,0 +1,58 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <sqltoast/sqltoast.h>
+
+namespace sqltoast {
+
+flat_index_t flat_ast::child(flat_index_t node, flat_role_t role) const {
+    for (flat_index_t x = first_children[node]; x != FLAT_NONE;
+            x = next_siblings[x]) {
+        if (roles[x] == role)
+            return x;
+    }
+    return FLAT_NONE;
+}
+
+void flat_ast::clear() {
+    input = nullptr;
+    statements.clear();
+    types.clear();
+    roles.clear();
+    flags.clear();
+    values.clear();
+    params.clear();
+    params2.clear();
+    parents.clear();
+    first_children.clear();
+    next_siblings.clear();
+    lexemes.clear();
+}
+
+void walk(const flat_ast_t& ast, flat_index_t root, flat_visitor_t& visitor) {
+    flat_index_t node = root;
+    for (;;) {
+        if (visitor.enter(ast, node) &&
+                ast.first_children[node] != FLAT_NONE) {
+            node = ast.first_children[node];
+            continue;
+        }
+        // Leave this node and any ancestors whose last child it was, then
+        // move on to the next sibling
+        for (;;) {
+            visitor.leave(ast, node);
+            if (node == root)
+                return;
+            if (ast.next_siblings[node] != FLAT_NONE) {
+                node = ast.next_siblings[node];
+                break;
+            }
+            node = ast.parents[node];
+        }
+    }
+}
+
+} // namespace sqltoast
@@ -0,0 +1,129 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "parser/arena.h"
+
+namespace sqltoast {
+
+namespace {
+
+thread_local arena_t* current_arena = nullptr;
+
+const size_t ALIGNMENT = alignof(std::max_align_t);
+
+// Each node is preceded by a header recording where it was allocated from,
+// which is how deleting a node tells arena nodes apart from heap nodes. The
+// heap may return memory with any alignment, so nothing about a node's
+// address can be relied on for this. No node needs more than pointer
+// alignment.
+const uintptr_t NODE_FROM_HEAP = 0;
+const uintptr_t NODE_FROM_ARENA = 1;
+const size_t NODE_HEADER_SIZE = sizeof(uintptr_t);
+static_assert(NODE_HEADER_SIZE >= alignof(void*),
+              "nodes must stay pointer-aligned");
+
+// Arenas start with small blocks so parsing a short statement doesn't cost
+// much memory, and double the blocks as more nodes are allocated, up to
+// 64KB
+const size_t MIN_BLOCK_SIZE = 1024;
+const size_t MAX_BLOCK_SHIFT = 6;
+
+} // namespace <anonymous>
+
+arena_t* set_current_arena(arena_t* a) {
+    arena_t* prev = current_arena;
+    current_arena = a;
+    return prev;
+}
+
+arena::~arena() {
+    for (block_t& b : blocks)
+        std::free(b.mem);
+}
+
+void arena::reset() {
+    cursor = nullptr;
+    remaining = 0;
+    next_block = 0;
+    num_allocations = 0;
+    bytes_allocated = 0;
+}
+
+void arena::adopt(arena& other) {
+    // The adopted blocks are in use, so they go before any blocks kept from
+    // before a reset, which are still free
+    blocks.insert(blocks.begin() + next_block,
+                  other.blocks.begin(), other.blocks.end());
+    next_block += other.blocks.size();
+    num_allocations += other.num_allocations;
+    bytes_allocated += other.bytes_allocated;
+    other.blocks.clear();
+    other.reset();
+}
+
+void* arena::allocate(size_t size) {
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    while (size > remaining) {
+        // Blocks kept from before a reset are reused, in order, before any
+        // new block is allocated
+        if (next_block < blocks.size() && blocks[next_block].size >= size) {
+            cursor = static_cast<char*>(blocks[next_block].mem);
+            remaining = blocks[next_block].size;
+            next_block++;
+            continue;
+        }
+        size_t block_size =
+            MIN_BLOCK_SIZE << std::min(blocks.size(), MAX_BLOCK_SHIFT);
+        if (size > block_size)
+            block_size = size;
+        void* mem = std::malloc(block_size);
+        if (mem == nullptr)
+            throw std::bad_alloc();
+        blocks.insert(blocks.begin() + next_block, block_t{mem, block_size});
+        next_block++;
+        cursor = static_cast<char*>(mem);
+        remaining = block_size;
+    }
+    void* mem = cursor;
+    cursor += size;
+    remaining -= size;
+    num_allocations++;
+    bytes_allocated += size;
+    return mem;
+}
+
+void* ast_node::operator new(size_t size) {
+    arena_t* a = current_arena;
+    uintptr_t* header;
+    if (a == nullptr) {
+        header = static_cast<uintptr_t*>(
+                ::operator new(size + NODE_HEADER_SIZE));
+        *header = NODE_FROM_HEAP;
+    } else {
+        header = static_cast<uintptr_t*>(
+                a->allocate(size + NODE_HEADER_SIZE));
+        *header = NODE_FROM_ARENA;
+    }
+    return header + 1;
+}
+
+void ast_node::operator delete(void* ptr) {
+    if (ptr == nullptr)
+        return;
+    uintptr_t* header = static_cast<uintptr_t*>(ptr) - 1;
+    // Nodes carved out of an arena are released along with the arena
+    if (*header == NODE_FROM_ARENA)
+        return;
+    ::operator delete(header);
+}
+
+} // namespace sqltoast
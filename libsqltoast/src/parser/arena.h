@@ -0,0 +1,31 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_ARENA_H
+#define SQLTOAST_PARSER_ARENA_H
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+// Sets the arena that AST nodes allocated on the calling thread are carved
+// out of, or the heap if NULL, and returns the previously set arena
+arena_t* set_current_arena(arena_t* a);
+
+// Directs AST node allocations on the calling thread to the supplied arena
+// (or the heap if NULL) for the lifetime of the scope
+typedef struct arena_scope {
+    arena_t* prev;
+    arena_scope(arena_t* a) : prev(set_current_arena(a))
+    {}
+    ~arena_scope() {
+        set_current_arena(prev);
+    }
+} arena_scope_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_ARENA_H */
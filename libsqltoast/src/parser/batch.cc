@@ -0,0 +1,142 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+namespace {
+
+// The inputs a thread takes from the front of its own range at a time.
+// Small enough that the ranges stay balanced, large enough that the owner
+// rarely has to contend with a thief for the range's lock.
+const size_t BATCH_CHUNK_SIZE = 16;
+
+// The range of input indexes [next, end) still to be parsed by a worker
+typedef struct work_range {
+    std::mutex mtx;
+    size_t next;
+    size_t end;
+} work_range_t;
+
+typedef struct batch {
+    const batch_input_t* inputs;
+    parse_options_t& opts;
+    std::vector<parse_result_t>& results;
+    std::vector<work_range_t> ranges;
+    batch(
+            const batch_input_t* inputs,
+            size_t num_inputs,
+            parse_options_t& opts,
+            std::vector<parse_result_t>& results,
+            size_t num_workers) :
+        inputs(inputs),
+        opts(opts),
+        results(results),
+        ranges(num_workers)
+    {
+        size_t per_worker = num_inputs / num_workers;
+        size_t extra = num_inputs % num_workers;
+        size_t start = 0;
+        for (size_t x = 0; x < num_workers; x++) {
+            size_t len = per_worker + (x < extra ? 1 : 0);
+            ranges[x].next = start;
+            ranges[x].end = start + len;
+            start += len;
+        }
+    }
+    // Takes the next chunk of the worker's own range into [begin, end),
+    // returning false if the range is exhausted
+    bool take(size_t worker, size_t* begin, size_t* end) {
+        work_range_t& r = ranges[worker];
+        std::lock_guard<std::mutex> lock(r.mtx);
+        if (r.next == r.end)
+            return false;
+        *begin = r.next;
+        r.next = std::min(r.end, r.next + BATCH_CHUNK_SIZE);
+        *end = r.next;
+        return true;
+    }
+    // Moves the back half of the largest remaining range belonging to
+    // another worker onto the worker's own range, returning false if there
+    // is nothing left anywhere to steal
+    bool steal(size_t worker) {
+        while (true) {
+            size_t victim = worker;
+            size_t most = 0;
+            for (size_t x = 0; x < ranges.size(); x++) {
+                if (x == worker)
+                    continue;
+                std::lock_guard<std::mutex> lock(ranges[x].mtx);
+                size_t left = ranges[x].end - ranges[x].next;
+                if (left > most) {
+                    most = left;
+                    victim = x;
+                }
+            }
+            if (victim == worker)
+                return false;
+            size_t begin, end;
+            {
+                work_range_t& r = ranges[victim];
+                std::lock_guard<std::mutex> lock(r.mtx);
+                size_t left = r.end - r.next;
+                // The victim may have finished in the meantime
+                if (left == 0)
+                    continue;
+                end = r.end;
+                begin = end - (left + 1) / 2;
+                r.end = begin;
+            }
+            work_range_t& own = ranges[worker];
+            std::lock_guard<std::mutex> lock(own.mtx);
+            own.next = begin;
+            own.end = end;
+            return true;
+        }
+    }
+    void run(size_t worker) {
+        size_t begin, end;
+        do {
+            while (take(worker, &begin, &end)) {
+                for (size_t x = begin; x < end; x++)
+                    results[x] = parse(inputs[x].subject, inputs[x].len, opts);
+            }
+        } while (steal(worker));
+    }
+} batch_t;
+
+} // namespace <anonymous>
+
+std::vector<parse_result_t> parse_batch(
+        const batch_input_t* inputs,
+        size_t num_inputs,
+        parse_options_t& opts,
+        size_t num_threads) {
+    std::vector<parse_result_t> results(num_inputs);
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    // No point in starting threads that would have nothing but stealing to
+    // do from the start
+    num_threads = std::min(num_threads, num_inputs / BATCH_CHUNK_SIZE + 1);
+
+    batch_t b(inputs, num_inputs, opts, results, num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t x = 1; x < num_threads; x++)
+        threads.emplace_back(&batch_t::run, &b, x);
+    // The calling thread is the first worker
+    b.run(0);
+    for (std::thread& t : threads)
+        t.join();
+    return results;
+}
+
+} // namespace sqltoast
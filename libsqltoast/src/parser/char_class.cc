@@ -0,0 +1,308 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SQLTOAST_CHAR_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#include "parser/char_class.h"
+
+namespace sqltoast {
+
+namespace {
+
+template<uint8_t cls>
+parse_position_t scan_scalar(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    while (cursor != end && (char_classes[*cursor] & cls))
+        cursor++;
+    return cursor;
+}
+
+#ifdef SQLTOAST_CHAR_SCAN_X86
+
+// Each matcher returns a vector with 0xFF in the byte positions holding a
+// member of its character class and 0x00 elsewhere. Comparisons are signed,
+// so bytes >= 0x80 are never members of any range checked here, which is
+// what we want since none of the classes contain non-ASCII characters.
+//
+// 32-bit x86 CPUs may lack SSE2, so like the AVX2 code, the SSE2 code is
+// compiled for its instruction set whatever the library's target, and is
+// only used once the CPU is known to support it.
+
+struct space_matcher {
+    static const uint8_t cls = CC_SPACE;
+    __attribute__((target("sse2")))
+    static inline __m128i match(__m128i v) {
+        __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        __m128i ctl = _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1)));
+        return _mm_or_si128(sp, ctl);
+    }
+    __attribute__((target("avx2")))
+    static inline __m256i match(__m256i v) {
+        __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+        __m256i ctl = _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8('\t' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), v));
+        return _mm256_or_si256(sp, ctl);
+    }
+};
+
+struct digit_matcher {
+    static const uint8_t cls = CC_DIGIT;
+    __attribute__((target("sse2")))
+    static inline __m128i match(__m128i v) {
+        return _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    }
+    __attribute__((target("avx2")))
+    static inline __m256i match(__m256i v) {
+        return _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+    }
+};
+
+// Setting bit 0x20 maps 'A'-'Z' onto 'a'-'z' and doesn't map anything else
+// into that range, so letters of either case need only one range check
+struct identifier_matcher {
+    static const uint8_t cls = CC_IDENTIFIER;
+    __attribute__((target("sse2")))
+    static inline __m128i match(__m128i v) {
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i alpha = _mm_and_si128(
+            _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i digit = digit_matcher::match(v);
+        __m128i other = _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+        return _mm_or_si128(_mm_or_si128(alpha, digit), other);
+    }
+    __attribute__((target("avx2")))
+    static inline __m256i match(__m256i v) {
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i alpha = _mm256_and_si256(
+            _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i digit = digit_matcher::match(v);
+        __m256i other = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'))),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+        return _mm256_or_si256(_mm256_or_si256(alpha, digit), other);
+    }
+};
+
+// The structural characters aren't a contiguous range, so each is compared
+// for separately
+struct plain_matcher {
+    static const uint8_t cls = CC_PLAIN;
+    __attribute__((target("sse2")))
+    static inline __m128i match(__m128i v) {
+        // Folding letters onto lower case halves the comparisons needed for
+        // 'F' and 'J', and leaves the punctuation compared for alone
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i hits = _mm_or_si128(
+            _mm_cmpeq_epi8(lower, _mm_set1_epi8('f')),
+            _mm_cmpeq_epi8(lower, _mm_set1_epi8('j')));
+        for (const char c : {';', '\'', '"', '`', '(', ')', '-', '/'})
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+        return _mm_xor_si128(hits, _mm_set1_epi8(-1));
+    }
+    __attribute__((target("avx2")))
+    static inline __m256i match(__m256i v) {
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i hits = _mm256_or_si256(
+            _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('f')),
+            _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('j')));
+        for (const char c : {';', '\'', '"', '`', '(', ')', '-', '/'})
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+        return _mm256_xor_si256(hits, _mm256_set1_epi8(-1));
+    }
+};
+
+struct text_matcher {
+    static const uint8_t cls = CC_TEXT;
+    __attribute__((target("sse2")))
+    static inline __m128i match(__m128i v) {
+        __m128i hits = _mm_setzero_si128();
+        for (const char c : {';', '\'', '"', '`', '-', '/', '\0'})
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+        return _mm_xor_si128(hits, _mm_set1_epi8(-1));
+    }
+    __attribute__((target("avx2")))
+    static inline __m256i match(__m256i v) {
+        __m256i hits = _mm256_setzero_si256();
+        for (const char c : {';', '\'', '"', '`', '-', '/', '\0'})
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+        return _mm256_xor_si256(hits, _mm256_set1_epi8(-1));
+    }
+};
+
+// Only whole blocks that lie before end are loaded; the tail is finished off
+// by the scalar scan so we never read past the end of the subject
+template<typename matcher>
+__attribute__((target("sse2")))
+parse_position_t scan_sse2(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    while (end - cursor >= 16) {
+        __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&*cursor));
+        unsigned misses = ~_mm_movemask_epi8(matcher::match(v)) & 0xFFFF;
+        if (misses != 0)
+            return cursor + __builtin_ctz(misses);
+        cursor += 16;
+    }
+    return scan_scalar<matcher::cls>(cursor, end);
+}
+
+template<typename matcher>
+__attribute__((target("avx2")))
+parse_position_t scan_avx2(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    while (end - cursor >= 32) {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&*cursor));
+        unsigned misses = ~static_cast<unsigned>(
+            _mm256_movemask_epi8(matcher::match(v)));
+        if (misses != 0)
+            return cursor + __builtin_ctz(misses);
+        cursor += 32;
+    }
+    return scan_sse2<matcher>(cursor, end);
+}
+
+#endif /* SQLTOAST_CHAR_SCAN_X86 */
+
+typedef parse_position_t (*scan_func_t)(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+typedef struct scanners {
+    char_scan_impl_t impl;
+    scan_func_t space;
+    scan_func_t digits;
+    scan_func_t identifier;
+    scan_func_t plain;
+    scan_func_t text;
+} scanners_t;
+
+// Constant-initialized to the scalar implementation so that anything parsed
+// before this translation unit's dynamic initialization runs is still
+// handled correctly
+scanners_t active_scanners = {
+    CHAR_SCAN_SCALAR,
+    &scan_scalar<CC_SPACE>,
+    &scan_scalar<CC_DIGIT>,
+    &scan_scalar<CC_IDENTIFIER>,
+    &scan_scalar<CC_PLAIN>,
+    &scan_scalar<CC_TEXT>
+};
+
+char_scan_impl_t best_char_scan_impl() {
+#ifdef SQLTOAST_CHAR_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return CHAR_SCAN_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return CHAR_SCAN_SSE2;
+#endif
+    return CHAR_SCAN_SCALAR;
+}
+
+const bool initial_impl_selected = set_char_scan_impl(best_char_scan_impl());
+
+} // namespace <anonymous>
+
+char_scan_impl_t char_scan_impl() {
+    return active_scanners.impl;
+}
+
+bool set_char_scan_impl(char_scan_impl_t impl) {
+    switch (impl) {
+        case CHAR_SCAN_SCALAR:
+            active_scanners = {
+                CHAR_SCAN_SCALAR,
+                &scan_scalar<CC_SPACE>,
+                &scan_scalar<CC_DIGIT>,
+                &scan_scalar<CC_IDENTIFIER>,
+                &scan_scalar<CC_PLAIN>,
+                &scan_scalar<CC_TEXT>
+            };
+            return true;
+#ifdef SQLTOAST_CHAR_SCAN_X86
+        case CHAR_SCAN_SSE2:
+            if (! __builtin_cpu_supports("sse2"))
+                return false;
+            active_scanners = {
+                CHAR_SCAN_SSE2,
+                &scan_sse2<space_matcher>,
+                &scan_sse2<digit_matcher>,
+                &scan_sse2<identifier_matcher>,
+                &scan_sse2<plain_matcher>,
+                &scan_sse2<text_matcher>
+            };
+            return true;
+        case CHAR_SCAN_AVX2:
+            if (! __builtin_cpu_supports("avx2"))
+                return false;
+            active_scanners = {
+                CHAR_SCAN_AVX2,
+                &scan_avx2<space_matcher>,
+                &scan_avx2<digit_matcher>,
+                &scan_avx2<identifier_matcher>,
+                &scan_avx2<plain_matcher>,
+                &scan_avx2<text_matcher>
+            };
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+parse_position_t scan_space(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return active_scanners.space(cursor, end);
+}
+
+parse_position_t scan_digits(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return active_scanners.digits(cursor, end);
+}
+
+parse_position_t scan_identifier(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return active_scanners.identifier(cursor, end);
+}
+
+parse_position_t scan_plain(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return active_scanners.plain(cursor, end);
+}
+
+parse_position_t scan_text(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return active_scanners.text(cursor, end);
+}
+
+} // namespace sqltoast
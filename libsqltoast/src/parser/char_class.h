@@ -0,0 +1,153 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_CHAR_CLASS_H
+#define SQLTOAST_PARSER_CHAR_CLASS_H
+
+#include <cstdint>
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+// Classes of characters the tokenizers care about. A character may belong to
+// more than one class. Membership matches the "C" locale's versions of the
+// std::isxxx() functions, regardless of the process' current locale.
+enum char_class {
+    // ' ', '\t', '\n', '\v', '\f' and '\r'
+    CC_SPACE = 1 << 0,
+    // '0' through '9'
+    CC_DIGIT = 1 << 1,
+    // Latin letters
+    CC_ALPHA = 1 << 2,
+    // Digits and 'a' through 'f' in either case
+    CC_XDIGIT = 1 << 3,
+    // Characters that can appear after the first character of a
+    // non-delimited identifier: letters, digits, '_', '.' and '*'
+    CC_IDENTIFIER = 1 << 4,
+    // Characters that can appear in a keyword: letters, digits and '_'
+    CC_WORD = 1 << 5,
+    // Characters that sqltoast::classify() can skip over without looking:
+    // anything that can't start or end a literal, delimited identifier,
+    // comment, parenthesized group or statement, nor start the FROM or JOIN
+    // keywords
+    CC_PLAIN = 1 << 6,
+    // Characters that splitting input into statements can skip over without
+    // looking: anything that can't start a literal, delimited identifier or
+    // comment, nor end a statement or the input, as a NUL byte does
+    CC_TEXT = 1 << 7
+};
+
+typedef struct char_class_table {
+    uint8_t classes[256];
+    constexpr char_class_table() : classes() {
+        for (int c = 0; c < 256; c++) {
+            uint8_t cls = 0;
+            bool alpha = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+            bool digit = (c >= '0' && c <= '9');
+            if (c == ' ' || (c >= '\t' && c <= '\r'))
+                cls |= CC_SPACE;
+            if (digit)
+                cls |= CC_DIGIT | CC_XDIGIT;
+            if (alpha)
+                cls |= CC_ALPHA;
+            if ((c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))
+                cls |= CC_XDIGIT;
+            if (alpha || digit || c == '_')
+                cls |= CC_WORD | CC_IDENTIFIER;
+            if (c == '.' || c == '*')
+                cls |= CC_IDENTIFIER;
+            if (! is_structural(c))
+                cls |= CC_PLAIN;
+            if (! is_delimiter(c) && c != '\0')
+                cls |= CC_TEXT;
+            classes[c] = cls;
+        }
+    }
+    static constexpr bool is_delimiter(int c) {
+        return (c == ';' || c == '\'' || c == '"' || c == '`' ||
+                c == '-' || c == '/');
+    }
+    static constexpr bool is_structural(int c) {
+        return (is_delimiter(c) || c == '(' || c == ')' ||
+                c == 'F' || c == 'f' || c == 'J' || c == 'j');
+    }
+    constexpr uint8_t operator[](char c) const {
+        return classes[static_cast<unsigned char>(c)];
+    }
+} char_class_table_t;
+
+constexpr char_class_table_t char_classes{};
+
+inline bool is_space(char c) {
+    return (char_classes[c] & CC_SPACE) != 0;
+}
+
+inline bool is_digit(char c) {
+    return (char_classes[c] & CC_DIGIT) != 0;
+}
+
+inline bool is_alpha(char c) {
+    return (char_classes[c] & CC_ALPHA) != 0;
+}
+
+inline bool is_xdigit(char c) {
+    return (char_classes[c] & CC_XDIGIT) != 0;
+}
+
+inline bool is_identifier_char(char c) {
+    return (char_classes[c] & CC_IDENTIFIER) != 0;
+}
+
+inline bool is_word_char(char c) {
+    return (char_classes[c] & CC_WORD) != 0;
+}
+
+// The scan_xxx() functions below return the position of the first character
+// at or after the supplied cursor that is NOT a member of the scanned class,
+// or end if all remaining characters are members. Long runs are examined 16
+// or 32 bytes at a time using SSE2 or AVX2 instructions when the CPU
+// supports them.
+parse_position_t scan_space(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+parse_position_t scan_digits(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+parse_position_t scan_identifier(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+parse_position_t scan_plain(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+parse_position_t scan_text(
+        parse_position_t cursor,
+        const parse_position_t end);
+
+// The implementations the scan_xxx() functions can be dispatched to
+typedef enum char_scan_impl {
+    CHAR_SCAN_SCALAR,
+    CHAR_SCAN_SSE2,
+    CHAR_SCAN_AVX2
+} char_scan_impl_t;
+
+// Returns the implementation currently in use by the scan_xxx() functions.
+// By default, this is the fastest implementation the CPU supports.
+char_scan_impl_t char_scan_impl();
+
+// Switches the scan_xxx() functions to the supplied implementation. Returns
+// false, leaving the current implementation in place, if the CPU doesn't
+// support the requested implementation. Not safe to call while other threads
+// are parsing; this is only useful for benchmarking and testing.
+bool set_char_scan_impl(char_scan_impl_t impl);
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_CHAR_CLASS_H */
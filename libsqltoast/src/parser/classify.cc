@@ -0,0 +1,357 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/char_class.h"
+#include "parser/keyword.h"
+#include "parser/split.h"
+#include "parser/token.h"
+
+namespace sqltoast {
+
+namespace {
+
+// Finds the items of a statement that classify() looks at: the words,
+// commas and parenthesized groups that aren't enclosed in parentheses.
+// Everything else is skipped over, tracking only enough of the lexical
+// structure of SQL to know where literals, delimited identifiers, comments
+// and parenthesized groups end, in the same way as statement_stream_t finds
+// the end of a statement. Inside parenthesized groups and once all_words is
+// false, runs of bytes that can't change any of that are skipped with
+// scan_plain() rather than a byte at a time.
+typedef struct statement_scanner {
+    const parse_position_t begin;
+    const parse_position_t end;
+    parse_position_t cursor;
+    // The first byte of the current statement that isn't whitespace or part
+    // of a simple comment, or nullptr if there hasn't been one yet
+    parse_position_t first;
+    // One past the last such byte seen so far
+    parse_position_t last;
+    // When false, the only words returned are FROM and JOIN, which is all
+    // that matters once past a statement's leading keywords and outside of
+    // a FROM clause. Not having to look up every word of a select list or
+    // search condition in the keyword tables saves most of the time spent.
+    bool all_words;
+    statement_scanner(parse_position_t start, parse_position_t end) :
+        begin(start),
+        end(end),
+        cursor(start),
+        first(nullptr),
+        last(start),
+        all_words(true)
+    {}
+    inline void significant(parse_position_t from, parse_position_t to) {
+        if (first == nullptr)
+            first = from;
+        last = to;
+    }
+    // Returns the next item, leaving the cursor after it. A parenthesized
+    // group is returned as a single SYMBOL_LPAREN token. At the end of the
+    // statement, returns a SYMBOL_SEMICOLON token, leaving the cursor on the
+    // semicolon, or a SYMBOL_EOS token.
+    token_t next() {
+        size_t depth = 0;
+        parse_position_t group_start = nullptr;
+        while (cursor < end) {
+            if (depth > 0 || ! all_words) {
+                parse_position_t skipped = cursor;
+                cursor = scan_plain(cursor, end);
+                // Plain bytes never start a simple comment, so the last of
+                // them that isn't whitespace is significant
+                parse_position_t trimmed = cursor;
+                while (trimmed > skipped && is_space(trimmed[-1]))
+                    trimmed--;
+                if (trimmed > skipped)
+                    significant(skipped, trimmed);
+                if (cursor == end)
+                    break;
+            }
+            parse_position_t start = cursor;
+            const char c = *cursor;
+            switch (c) {
+                case ';':
+                    return token_t(SYMBOL_SEMICOLON, cursor, cursor + 1);
+                case ',':
+                    cursor++;
+                    significant(start, cursor);
+                    if (depth == 0)
+                        return token_t(SYMBOL_COMMA, start, cursor);
+                    continue;
+                case '(':
+                    if (depth++ == 0)
+                        group_start = cursor;
+                    cursor++;
+                    significant(start, cursor);
+                    continue;
+                case ')':
+                    cursor++;
+                    significant(start, cursor);
+                    if (depth == 0)
+                        continue;
+                    if (--depth == 0)
+                        return token_t(SYMBOL_LPAREN, group_start, cursor);
+                    continue;
+                case '\'':
+                    cursor = skip_quoted(cursor, end);
+                    significant(start, cursor);
+                    continue;
+                case '"':
+                case '`':
+                    cursor = skip_quoted(cursor, end);
+                    significant(start, cursor);
+                    if (depth == 0 && cursor[-1] == c && cursor - start >= 2)
+                        return token_t(SYMBOL_IDENTIFIER, start + 1, cursor - 1);
+                    continue;
+                case '-':
+                    if (cursor + 1 < end && cursor[1] == '-') {
+                        cursor = skip_simple_comment(cursor, end);
+                        continue;
+                    }
+                    break;
+                case '/':
+                    if (cursor + 1 < end && cursor[1] == '*') {
+                        cursor = skip_bracketed_comment(cursor, end);
+                        significant(start, cursor);
+                        continue;
+                    }
+                    break;
+                default:
+                    // Runs of whitespace and words are mostly short enough
+                    // that scanning them here beats calling scan_space()
+                    // and scan_identifier()
+                    if (is_space(c)) {
+                        do {
+                            cursor++;
+                        } while (cursor < end && is_space(*cursor));
+                        continue;
+                    }
+                    if (is_word_char(c)) {
+                        do {
+                            cursor++;
+                        } while (cursor < end && is_identifier_char(*cursor));
+                        significant(start, cursor);
+                        if (depth > 0 || ! is_alpha(c))
+                            continue;
+                        // scan_plain() stops at an 'F' or 'J' in the middle
+                        // of a word too
+                        if (start > begin && is_identifier_char(start[-1]))
+                            continue;
+                        if (! all_words && ! (cursor - start == 4 &&
+                                (kw_equal(start, "FROM", 4) ||
+                                 kw_equal(start, "JOIN", 4))))
+                            continue;
+                        auto tok_res = token_keyword(start, end);
+                        if (tok_res.code == TOKEN_FOUND) {
+                            cursor = tok_res.token.lexeme.end;
+                            return tok_res.token;
+                        }
+                        return token_t(SYMBOL_IDENTIFIER, start, cursor);
+                    }
+                    break;
+            }
+            cursor++;
+            significant(start, cursor);
+        }
+        return token_t(SYMBOL_EOS, end, end);
+    }
+} statement_scanner_t;
+
+void add_table(
+        statement_class_t& sc,
+        parse_position_t subject,
+        const token_t& tok) {
+    if (sc.num_tables == CLASSIFY_MAX_TABLES)
+        return;
+    sc.tables[sc.num_tables++] = lexeme_t(
+            tok.lexeme.start - subject, tok.lexeme.size());
+}
+
+// Classifies the statement starting at the scanner's cursor, leaving the
+// cursor at its end
+void classify_statement(
+        parse_position_t subject,
+        statement_scanner_t& scan,
+        const token_t& first_tok,
+        statement_class_t& sc) {
+    token_t tok = first_tok;
+    symbol_t cur_sym = tok.symbol;
+    bool in_from = false;
+    bool expect_table = false;
+
+    // Like parse_statement(), pick the kind of statement from the leading
+    // keywords, then find the name of the object it is about
+    sc.recognized = true;
+    switch (cur_sym) {
+        case SYMBOL_SELECT:
+            sc.type = STATEMENT_TYPE_SELECT;
+            goto next_item;
+        case SYMBOL_DELETE:
+            sc.type = STATEMENT_TYPE_DELETE;
+            goto next_item;
+        case SYMBOL_COMMIT:
+            sc.type = STATEMENT_TYPE_COMMIT;
+            goto next_item;
+        case SYMBOL_ROLLBACK:
+            sc.type = STATEMENT_TYPE_ROLLBACK;
+            goto next_item;
+        case SYMBOL_INSERT:
+            sc.type = STATEMENT_TYPE_INSERT;
+            tok = scan.next();
+            if (tok.symbol != SYMBOL_INTO)
+                goto check_item;
+            goto expect_name;
+        case SYMBOL_UPDATE:
+            sc.type = STATEMENT_TYPE_UPDATE;
+            goto expect_name;
+        case SYMBOL_GRANT:
+            sc.type = STATEMENT_TYPE_GRANT;
+            goto expect_on;
+        case SYMBOL_ALTER:
+            tok = scan.next();
+            if (tok.symbol != SYMBOL_TABLE)
+                goto unrecognized;
+            sc.type = STATEMENT_TYPE_ALTER_TABLE;
+            goto expect_name;
+        case SYMBOL_CREATE:
+            tok = scan.next();
+            if (tok.symbol == SYMBOL_GLOBAL || tok.symbol == SYMBOL_LOCAL)
+                tok = scan.next();
+            if (tok.symbol == SYMBOL_TEMPORARY)
+                tok = scan.next();
+            switch (tok.symbol) {
+                case SYMBOL_TABLE:
+                    sc.type = STATEMENT_TYPE_CREATE_TABLE;
+                    goto expect_name;
+                case SYMBOL_VIEW:
+                    sc.type = STATEMENT_TYPE_CREATE_VIEW;
+                    goto expect_name;
+                case SYMBOL_SCHEMA:
+                    sc.type = STATEMENT_TYPE_CREATE_SCHEMA;
+                    goto expect_name;
+                default:
+                    goto unrecognized;
+            }
+        case SYMBOL_DROP:
+            tok = scan.next();
+            switch (tok.symbol) {
+                case SYMBOL_TABLE:
+                    sc.type = STATEMENT_TYPE_DROP_TABLE;
+                    goto expect_name;
+                case SYMBOL_VIEW:
+                    sc.type = STATEMENT_TYPE_DROP_VIEW;
+                    goto expect_name;
+                case SYMBOL_SCHEMA:
+                    sc.type = STATEMENT_TYPE_DROP_SCHEMA;
+                    goto expect_name;
+                default:
+                    goto unrecognized;
+            }
+        default:
+            goto unrecognized;
+    }
+expect_on:
+    // The privileges granted come before the ON <object name> clause, and
+    // any column lists in them are skipped as parenthesized groups
+    tok = scan.next();
+    cur_sym = tok.symbol;
+    if (cur_sym == SYMBOL_SEMICOLON || cur_sym == SYMBOL_EOS)
+        return;
+    if (cur_sym != SYMBOL_ON)
+        goto expect_on;
+    // Only tables are named without a keyword saying what kind of object
+    // they are
+    goto expect_name;
+expect_name:
+    tok = scan.next();
+    if (tok.symbol != SYMBOL_IDENTIFIER)
+        goto check_item;
+    add_table(sc, subject, tok);
+    goto next_item;
+next_item:
+    scan.all_words = (in_from || expect_table);
+    tok = scan.next();
+    goto check_item;
+check_item:
+    // Past the leading keywords, the only tables of interest follow FROM and
+    // JOIN and the commas separating the table references of a FROM clause
+    cur_sym = tok.symbol;
+    switch (cur_sym) {
+        case SYMBOL_SEMICOLON:
+        case SYMBOL_EOS:
+            return;
+        case SYMBOL_FROM:
+            in_from = true;
+            expect_table = true;
+            goto next_item;
+        case SYMBOL_JOIN:
+            expect_table = true;
+            goto next_item;
+        case SYMBOL_COMMA:
+            expect_table = in_from;
+            goto next_item;
+        case SYMBOL_IDENTIFIER:
+            if (expect_table)
+                add_table(sc, subject, tok);
+            expect_table = false;
+            goto next_item;
+        case SYMBOL_AS:
+        case SYMBOL_NATURAL:
+        case SYMBOL_CROSS:
+        case SYMBOL_INNER:
+        case SYMBOL_LEFT:
+        case SYMBOL_RIGHT:
+        case SYMBOL_FULL:
+        case SYMBOL_OUTER:
+            // Table aliases and join types don't end a FROM clause
+            expect_table = false;
+            goto next_item;
+        default:
+            // A derived table, or a keyword starting the next clause
+            if (cur_sym != SYMBOL_LPAREN)
+                in_from = false;
+            expect_table = false;
+            goto next_item;
+    }
+unrecognized:
+    sc.recognized = false;
+    while (tok.symbol != SYMBOL_SEMICOLON && tok.symbol != SYMBOL_EOS)
+        tok = scan.next();
+}
+
+} // namespace
+
+size_t classify(
+        const char* subject,
+        size_t len,
+        std::vector<statement_class_t>& out) {
+    if (len >= LEXEME_NONE)
+        return 0;
+    const parse_position_t end = subject + len;
+    statement_scanner_t scan(subject, end);
+    size_t num_classified = 0;
+    while (scan.cursor < end) {
+        scan.first = nullptr;
+        scan.all_words = true;
+        token_t tok = scan.next();
+        // Nothing but whitespace, simple comments and semicolons means
+        // there's no statement to classify
+        if (scan.first != nullptr) {
+            statement_class_t sc;
+            classify_statement(subject, scan, tok, sc);
+            sc.span = lexeme_t(scan.first - subject, scan.last - scan.first);
+            out.push_back(sc);
+            num_classified++;
+        }
+        // Move past the terminating semicolon
+        if (scan.cursor < end)
+            scan.cursor++;
+    }
+    return num_classified;
+}
+
+} // namespace sqltoast
@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/parse.h"
@@ -30,10 +28,11 @@ bool parse_column_definition(
     std::unique_ptr<default_descriptor_t> default_descriptor;
     std::unique_ptr<constraint_t> constraint;
     std::vector<std::unique_ptr<constraint_t>> constraints;
+    lexeme_t collation;
 
     if (cur_sym != SYMBOL_IDENTIFIER)
         return false;
-    column_name = cur_tok.lexeme;
+    column_name = ctx.lexeme(cur_tok);
     cur_tok = ctx.lexer.next();
     if (! parse_data_type_descriptor(ctx, cur_tok, data_type))
         return false;
@@ -57,7 +56,8 @@ optional_constraints:
         case SYMBOL_CHECK:
             if (! parse_column_constraint(ctx, cur_tok, constraint))
                 return false;
-            constraints.emplace_back(std::move(constraint));
+            if (! ctx.opts.disable_statement_construction)
+                constraints.emplace_back(std::move(constraint));
             goto optional_constraints; // there may be >1 constraint...
         default:
             goto optional_collate;
@@ -66,7 +66,7 @@ optional_collate:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COLLATE) {
         cur_tok = lex.next();
-        if (! parse_collate_clause(ctx, cur_tok, *out))
+        if (! parse_collate_clause(ctx, cur_tok, collation))
             return false;
     }
     goto push_column_def;
@@ -75,6 +75,7 @@ push_column_def:
         return true;
     out = std::make_unique<column_definition_t>(
             column_name, data_type, default_descriptor, constraints);
+    out->collate = collation;
     return true;
 }
 
@@ -109,59 +110,60 @@ bool parse_default_clause(
     symbol_t cur_sym = cur_tok.symbol;
     default_type_t default_type;
     lexeme_t value;
-    size_t prec;
+    parse_position_t sign_start = nullptr;
+    size_t prec = 0;
 
     switch (cur_sym) {
         case SYMBOL_NULL:
             default_type = DEFAULT_TYPE_NULL;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_USER:
             default_type = DEFAULT_TYPE_USER;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_CURRENT_USER:
             default_type = DEFAULT_TYPE_CURRENT_USER;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_SESSION_USER:
             default_type = DEFAULT_TYPE_SESSION_USER;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_SYSTEM_USER:
             default_type = DEFAULT_TYPE_SYSTEM_USER;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_CURRENT_DATE:
             default_type = DEFAULT_TYPE_CURRENT_DATE;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_descriptor;
         case SYMBOL_CURRENT_TIME:
             default_type = DEFAULT_TYPE_CURRENT_TIME;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto optional_precision;
         case SYMBOL_CURRENT_TIMESTAMP:
             default_type = DEFAULT_TYPE_CURRENT_TIMESTAMP;
-            value = cur_tok.lexeme;
+            value = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto optional_precision;
         case SYMBOL_MINUS:
         case SYMBOL_PLUS:
             default_type = DEFAULT_TYPE_LITERAL;
-            value.start = cur_tok.lexeme.start;
+            sign_start = cur_tok.lexeme.start;
             cur_tok = lex.next();
             goto expect_unsigned_numeric;
         default:
             if (cur_tok.is_literal()) {
                 default_type = DEFAULT_TYPE_LITERAL;
-                value = cur_tok.lexeme;
+                value = ctx.lexeme(cur_tok);
                 cur_tok = lex.next();
                 goto push_descriptor;
             }
@@ -175,7 +177,7 @@ expect_unsigned_numeric:
     if (cur_sym != SYMBOL_LITERAL_UNSIGNED_INTEGER &&
             cur_sym != SYMBOL_LITERAL_UNSIGNED_DECIMAL)
         goto err_expect_unsigned_numeric;
-    value.end = cur_tok.lexeme.end;
+    value = ctx.lexeme(sign_start, cur_tok.lexeme.end);
     cur_tok = lex.next();
     goto push_descriptor;
 err_expect_unsigned_numeric:
@@ -236,7 +238,7 @@ process_name:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    constraint_name = cur_tok.lexeme;
+    constraint_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto process_constraint_type;
 err_expect_identifier:
@@ -250,7 +252,8 @@ process_constraint_type:
             goto process_not_null;
         case SYMBOL_UNIQUE:
             cur_tok = lex.next();
-            out = std::make_unique<unique_constraint_t>(false);
+            if (! ctx.opts.disable_statement_construction)
+                out = std::make_unique<unique_constraint_t>(false);
             goto push_constraint;
         case SYMBOL_PRIMARY:
             cur_tok = lex.next();
@@ -271,7 +274,8 @@ process_not_null:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_NULL)
         goto err_expect_null;
-    out = std::make_unique<not_null_constraint_t>();
+    if (! ctx.opts.disable_statement_construction)
+        out = std::make_unique<not_null_constraint_t>();
     cur_tok = lex.next();
     return true;
 err_expect_null:
@@ -281,7 +285,8 @@ process_primary_key:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_KEY)
         goto err_expect_key;
-    out = std::make_unique<unique_constraint_t>(true);
+    if (! ctx.opts.disable_statement_construction)
+        out = std::make_unique<unique_constraint_t>(true);
     cur_tok = lex.next();
     goto push_constraint;
 err_expect_key:
@@ -332,7 +337,7 @@ bool parse_references_specification(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    ref_table = cur_tok.lexeme;
+    ref_table = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto optional_column_names;
 err_expect_identifier:
@@ -397,19 +402,11 @@ err_expect_update_or_delete:
     expect_any_error(ctx, {SYMBOL_UPDATE, SYMBOL_DELETE});
     return false;
 err_already_found_on_update:
-    {
-        std::stringstream estr;
-        estr << "Already found ON UPDATE constraint." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Already found ON UPDATE constraint.");
+    return false;
 err_already_found_on_delete:
-    {
-        std::stringstream estr;
-        estr << "Already found ON DELETE constraint." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Already found ON DELETE constraint.");
+    return false;
 push_constraint:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -435,7 +432,8 @@ process_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    identifiers.emplace_back(cur_tok.lexeme);
+    if (! ctx.opts.disable_statement_construction)
+        identifiers.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -545,29 +543,21 @@ err_expect_action_trigger:
 bool parse_collate_clause(
         parse_context_t& ctx,
         token_t& cur_tok,
-        column_definition_t& column_def) {
+        lexeme_t& out) {
     lexer_t& lex = ctx.lexer;
     symbol_t cur_sym = cur_tok.symbol;
-    lexeme_t collate_ident;
 
     // We get here after getting the COLLATE symbol while processing the column
     // definition. We expect an identifier (the collation) at this point.
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
 
-    collate_ident = cur_tok.lexeme;
+    out = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
-    goto push_descriptor;
+    return true;
 err_expect_identifier:
     expect_error(ctx, SYMBOL_IDENTIFIER);
     return false;
-push_descriptor:
-    {
-        if (ctx.opts.disable_statement_construction)
-            return true;
-        column_def.collate = collate_ident;
-        return true;
-    }
 }
 
 } // namespace sqltoast
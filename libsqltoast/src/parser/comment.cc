@@ -40,7 +40,7 @@ tokenize_result_t token_comment(
         return tokenize_result_t(TOKEN_NOT_FOUND);
 
     cursor++;
-    if (*cursor != '*')
+    if (cursor == end || *cursor != '*')
         return tokenize_result_t(TOKEN_NOT_FOUND);
 
     // OK, we found the start of a comment. Run through the subject until we
@@ -51,7 +51,7 @@ tokenize_result_t token_comment(
             return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, cursor);
         }
     } while (*cursor != '*' || *(cursor + 1) != '/');
-    return tokenize_result_t(SYMBOL_COMMENT, start, cursor + 1);
+    return tokenize_result_t(SYMBOL_COMMENT, start, cursor + 2);
 }
 
 } // namespace sqltoast
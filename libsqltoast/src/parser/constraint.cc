@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/parse.h"
@@ -37,7 +35,7 @@ expect_constraint_name:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    constraint_name = cur_tok.lexeme;
+    constraint_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_constraint_type;
 err_expect_identifier:
@@ -48,7 +46,8 @@ expect_constraint_type:
     switch (cur_sym) {
         case SYMBOL_UNIQUE:
             cur_tok = ctx.lexer.next();
-            out = std::make_unique<unique_constraint_t>(false);
+            if (! ctx.opts.disable_statement_construction)
+                out = std::make_unique<unique_constraint_t>(false);
             goto expect_col_list;
         case SYMBOL_PRIMARY:
             cur_tok = ctx.lexer.next();
@@ -75,7 +74,8 @@ expect_key:
     if (cur_sym != SYMBOL_KEY)
         goto err_expect_key;
     cur_tok = lex.next();
-    out = std::make_unique<unique_constraint_t>(true);
+    if (! ctx.opts.disable_statement_construction)
+        out = std::make_unique<unique_constraint_t>(true);
     goto expect_col_list;
 err_expect_key:
     expect_error(ctx, SYMBOL_KEY);
@@ -96,7 +96,8 @@ process_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    out->columns.emplace_back(cur_tok.lexeme);
+    if (! ctx.opts.disable_statement_construction)
+        out->columns.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -10,19 +10,102 @@
 #include "sqltoast/sqltoast.h"
 
 #include "parser/lexer.h"
+#include "parser/memo.h"
 #include "parser/token.h"
 
 namespace sqltoast {
 
+// A value expression primary that parse_value_expression() has already
+// parsed in order to see which kind of value expression follows it. The
+// parser for that kind of value expression then starts by parsing the same
+// primary, and takes this one instead of parsing it all over again.
+typedef struct parsed_primary {
+    bool present;
+    // Where the token following the primary starts
+    parse_position_t next_start;
+    std::unique_ptr<value_expression_primary_t> value;
+    parsed_primary() : present(false), next_start(nullptr)
+    {}
+} parsed_primary_t;
+
 typedef struct parse_context {
     parse_result_t& result;
     parse_options_t& opts;
     lexer_t lexer;
-    parse_context(parse_result_t& result, parse_options_t& opts, parse_input_t& subject) :
+    parsed_primary_t parsed_primary;
+    // The outcomes of grammar rules attempted so far, when parsing with
+    // parse_options_t::memoize set
+    std::unique_ptr<memo_table_t> memo;
+    parse_context(
+            parse_result_t& result,
+            parse_options_t& opts,
+            parse_position_t start,
+            parse_position_t end) :
         result(result),
         opts(opts),
-        lexer(subject)
-    {}
+        lexer(start, end)
+    {
+        result.input = start;
+        if (opts.pretokenize)
+            lexer.tokenize();
+        if (opts.memoize)
+            memo.reset(new memo_table_t);
+    }
+    // Constructs a context that parses only the part of the subject between
+    // from and end. Lexemes and error offsets are still relative to start,
+    // as if the whole subject were being parsed.
+    parse_context(
+            parse_result_t& result,
+            parse_options_t& opts,
+            parse_position_t start,
+            parse_position_t from,
+            parse_position_t end) :
+        result(result),
+        opts(opts),
+        lexer(start, from, end)
+    {
+        result.input = start;
+        if (opts.pretokenize)
+            lexer.tokenize();
+        if (opts.memoize)
+            memo.reset(new memo_table_t);
+    }
+    // Constructs a context whose lexer, when pre-tokenizing, stores tokens in
+    // the supplied buffer's memory instead of allocating its own. The buffer
+    // is swapped into the lexer, and the caller may swap it back out once
+    // parsing is done.
+    parse_context(
+            parse_result_t& result,
+            parse_options_t& opts,
+            parse_position_t start,
+            parse_position_t end,
+            std::vector<token_t>& token_buffer) :
+        result(result),
+        opts(opts),
+        lexer(start, end)
+    {
+        result.input = start;
+        if (opts.pretokenize) {
+            lexer.tokens.swap(token_buffer);
+            lexer.tokenize();
+        }
+        if (opts.memoize)
+            memo.reset(new memo_table_t);
+    }
+    // Returns the lexeme_t demarcating the supplied token, or the input
+    // between the supplied positions
+    inline lexeme_t lexeme(const token_t& tok) const {
+        return lexeme(tok.lexeme.start, tok.lexeme.end);
+    }
+    inline lexeme_t lexeme(parse_position_t start, parse_position_t end) const {
+        return lexeme_t(uint32_t(start - lexer.start), uint32_t(end - start));
+    }
+    // Returns true if parse_value_expression() has already parsed the value
+    // expression primary preceding the supplied token
+    inline bool has_parsed_primary(const token_t& tok) const {
+        return parsed_primary.present &&
+               tok.lexeme.start == parsed_primary.next_start;
+    }
 } parse_context_t;
 
 } // namespace sqltoast
@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/parse.h"
@@ -51,13 +49,8 @@ bool parse_data_type_descriptor(
         return false;
     if (parse_interval(ctx, cur_tok, out))
         return true;
-    {
-        std::stringstream estr;
-        estr << "Expected data type after <column name> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected data type after <column name> but found %t");
+    return false;
 }
 
 // <character string type> ::=
@@ -130,7 +123,7 @@ optional_character_set:
         if (! expect_sequence(ctx, exp_sym_seq, 3))
             return false;
         // tack the character set onto the char_string_t data type descriptor
-        charset = cur_tok.lexeme;
+        charset = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         return true;
     }
@@ -434,6 +427,7 @@ process_length:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
+    cur_tok = lex.next();
     goto push_descriptor;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
@@ -614,6 +608,7 @@ process_length:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
+    cur_tok = lex.next();
     goto push_descriptor;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
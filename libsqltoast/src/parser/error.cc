@@ -4,6 +4,7 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <algorithm>
 #include <initializer_list>
 #include <iostream>
 #include <sstream>
@@ -13,48 +14,144 @@
 
 namespace sqltoast {
 
-// TODO(jaypipes): Limit the amount of output to something like 200 characters
-// before the syntax error position...
-void create_syntax_error_marker(parse_context_t& ctx, std::stringstream& es) {
+void syntax_error(parse_context_t& ctx, const char* message) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t err_pos = lex.current_token.lexeme.start;
-    std::string original(lex.start, lex.end);
-    std::string location(original);
-    auto start_pos = err_pos - lex.start;
-    for (auto cur = location.begin(); cur != location.end(); cur++) {
-        auto loc_pos = cur - location.begin() + 1;
-        if (loc_pos < start_pos) {
-            *cur = ' ';
-        } else {
-            *cur = '^';
-        }
-    }
-
-    es << original << std::endl << location;
-    ctx.result.error.assign(es.str());
+    const token_t& found = lex.current_token;
+    parse_error_t& err = ctx.result.error;
+    err.code = PARSE_SYNTAX_ERROR;
+    err.message = message;
+    err.offset = found.lexeme.start - lex.start;
+    err.found_symbol = found.symbol;
+    err.found_length = found.lexeme.size();
+    err.input = lex.start;
+    err.input_end = lex.end;
     ctx.result.code = PARSE_SYNTAX_ERROR;
 }
 
 void expect_error(parse_context_t& ctx, symbol_t expected) {
-    std::stringstream es;
-    es << "Expected to find " << expected
-        << " but found " << ctx.lexer.current_token << std::endl;
-    create_syntax_error_marker(ctx, es);
+    syntax_error(ctx, "Expected to find %e but found %t");
+    parse_error_t& err = ctx.result.error;
+    err.expected[0] = expected;
+    err.num_expected = 1;
 }
 
 void expect_any_error(parse_context_t& ctx, std::initializer_list<symbol_t> expected) {
-    std::stringstream es;
-    es << "Expected to find one of (";
-    size_t num_expected = expected.size();
+    syntax_error(ctx, "Expected to find %e but found %t");
+    parse_error_t& err = ctx.result.error;
     size_t x = 0;
     for (auto exp_sym : expected) {
-        es << exp_sym;
-        if ((x + 1) < num_expected)
-            es << "|";
-        x++;
+        if (x == PARSE_ERROR_MAX_EXPECTED)
+            break;
+        err.expected[x++] = exp_sym;
+    }
+    err.num_expected = x;
+}
+
+void input_error(parse_context_t& ctx, const char* message) {
+    parse_error_t& err = ctx.result.error;
+    err.code = PARSE_INPUT_ERROR;
+    err.message = message;
+    err.offset = 0;
+    err.found_symbol = SYMBOL_NONE;
+    err.found_length = 0;
+    err.input = ctx.lexer.start;
+    err.input_end = ctx.lexer.end;
+    ctx.result.code = PARSE_INPUT_ERROR;
+}
+
+void locate_error(parse_context_t& ctx) {
+    parse_error_t& err = ctx.result.error;
+    parse_position_t err_pos = err.input + err.offset;
+    parse_position_t line_start = err.input;
+    err.line = 1;
+    for (parse_position_t cur = err.input; cur != err_pos; cur++) {
+        if (*cur == '\n') {
+            err.line++;
+            line_start = cur + 1;
+        }
+    }
+    err.column = (err_pos - line_start) + 1;
+}
+
+std::string parse_error::str() const {
+    std::stringstream es;
+    es << *this;
+    return es.str();
+}
+
+static void write_expected(std::ostream& out, const parse_error_t& err) {
+    if (err.num_expected == 1) {
+        out << symbol_t(err.expected[0]);
+        return;
+    }
+    out << "one of (";
+    for (size_t x = 0; x < err.num_expected; x++) {
+        if (x > 0)
+            out << "|";
+        out << symbol_t(err.expected[x]);
+    }
+    out << ")";
+}
+
+// Writes the input around the error followed by a line with markers under
+// the error. At most PARSE_ERROR_CONTEXT bytes either side of the error are
+// shown, with an ellipsis marking input that has been left out.
+static void write_context(std::ostream& out, const parse_error_t& err) {
+    parse_position_t err_pos = err.input + err.offset;
+    size_t before = std::min(size_t(err.offset), PARSE_ERROR_CONTEXT);
+    size_t after = std::min(size_t(err.input_end - err_pos), PARSE_ERROR_CONTEXT);
+    parse_position_t start = err_pos - before;
+    parse_position_t end = err_pos + after;
+    bool elide_start = (start != err.input);
+    bool elide_end = (end != err.input_end);
+
+    if (elide_start)
+        out << "...";
+    out.write(start, end - start);
+    if (elide_end)
+        out << "...";
+    out << std::endl;
+
+    // The markers start at the byte before the error
+    if (elide_start)
+        out << "   ";
+    size_t num_spaces = (before > 0) ? before - 1 : 0;
+    for (size_t x = 0; x < num_spaces; x++)
+        out << ' ';
+    for (size_t x = num_spaces; x < size_t(end - start); x++)
+        out << '^';
+}
+
+std::ostream& operator<< (std::ostream& out, const parse_error_t& err) {
+    if (err.message == nullptr)
+        return out;
+    parse_position_t err_pos = err.input + err.offset;
+    token_t found(symbol_t(err.found_symbol), err_pos, err_pos + err.found_length);
+    for (const char* c = err.message; *c != '\0'; c++) {
+        if (*c != '%' || c[1] == '\0') {
+            out << *c;
+            continue;
+        }
+        c++;
+        switch (*c) {
+            case 't':
+                out << found;
+                break;
+            case 's':
+                out << found.symbol;
+                break;
+            case 'e':
+                write_expected(out, err);
+                break;
+            default:
+                out << '%' << *c;
+        }
     }
-    es << ") but found " << ctx.lexer.current_token << std::endl;
-    create_syntax_error_marker(ctx, es);
+    if (err.code != PARSE_SYNTAX_ERROR)
+        return out;
+    out << std::endl;
+    write_context(out, err);
+    return out;
 }
 
 } // namespace sqltoast
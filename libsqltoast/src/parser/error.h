@@ -8,20 +8,29 @@
 #define SQLTOAST_ERROR_H
 
 #include <initializer_list>
-#include <sstream>
 
 #include "context.h"
 
 namespace sqltoast {
 
-// Populates the parse context's error member with a crafted syntax error that
-// shows where the syntax error occurred
-void create_syntax_error_marker(parse_context_t& ctx, std::stringstream& es);
+// Records a syntax error at the lexer's current token in the parse context's
+// result. The message must be a string literal, and may refer to the token
+// found with "%t" and its symbol with "%s" (see parse_error_t::message).
+// Nothing is allocated or formatted until the error is written out.
+void syntax_error(parse_context_t& ctx, const char* message);
 
-// Helper function to generate a syntax error about expecting to find a
+// Helper function to record a syntax error about expecting to find a
 // particular symbol
 void expect_error(parse_context_t& ctx, symbol_t expected);
 void expect_any_error(parse_context_t& ctx, std::initializer_list<symbol_t> expected);
+
+// Records an error with the input itself, such as there being nothing in it
+void input_error(parse_context_t& ctx, const char* message);
+
+// Fills in the line and column of the parse context's error. This means
+// scanning the input up to the error, so is only done once parsing has
+// stopped rather than for every error recorded while backtracking.
+void locate_error(parse_context_t& ctx);
 } // namespace sqltoast
 
 #endif /* SQLTOAST_ERROR_H */
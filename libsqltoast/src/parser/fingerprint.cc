@@ -0,0 +1,170 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/lexer.h"
+#include "parser/symbol.h"
+#include "parser/token.h"
+
+namespace sqltoast {
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Receives the normalized text a byte at a time, hashing it and, unless
+// only the hash is wanted, appending it to a string
+template<bool keep_text>
+struct fingerprint_sink {
+    std::string* text;
+    uint64_t hash;
+    fingerprint_sink(std::string* text) :
+        text(text),
+        hash(FNV_OFFSET_BASIS)
+    {}
+    inline void put(char c) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * FNV_PRIME;
+        if (keep_text)
+            text->push_back(c);
+    }
+    inline void put(const char* s, size_t len) {
+        for (size_t x = 0; x < len; x++)
+            hash = (hash ^ static_cast<unsigned char>(s[x])) * FNV_PRIME;
+        if (keep_text)
+            text->append(s, len);
+    }
+    inline void put_upper(const char* s, size_t len) {
+        for (size_t x = 0; x < len; x++) {
+            char c = s[x];
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+            put(c);
+        }
+    }
+};
+
+inline bool is_keyword_symbol(symbol_t sym) {
+    return (sym >= SYMBOL_ACTION && sym <= SYMBOL_ZONE);
+}
+
+inline bool is_numeric_literal(symbol_t sym) {
+    return (sym == SYMBOL_LITERAL_APPROXIMATE_NUMBER ||
+            sym >= SYMBOL_LITERAL_SIGNED_DECIMAL);
+}
+
+// Returns true if the parenthesized group the lexer has just returned the
+// opening parenthesis of holds nothing but literals, optionally signed, and
+// commas, leaving the lexer after its closing parenthesis. Otherwise rewinds
+// the lexer to where it was and returns false.
+bool skip_literal_list(lexer_t& lex) {
+    const parse_position_t start = lex.cursor;
+    bool expect_literal = true;
+    while (true) {
+        const token_t& tok = lex.next();
+        symbol_t sym = tok.symbol;
+        if (expect_literal) {
+            if (sym == SYMBOL_MINUS || sym == SYMBOL_PLUS)
+                sym = lex.next().symbol;
+            if (sym >= SYMBOL_LITERAL_APPROXIMATE_NUMBER) {
+                expect_literal = false;
+                continue;
+            }
+        } else if (sym == SYMBOL_COMMA) {
+            expect_literal = true;
+            continue;
+        } else if (sym == SYMBOL_RPAREN) {
+            return true;
+        }
+        lex.cursor = start;
+        return false;
+    }
+}
+
+template<bool keep_text>
+bool fingerprint_tokens(
+        const char* subject,
+        size_t len,
+        fingerprint_sink<keep_text>& out) {
+    lexer_t lex(subject, subject + len);
+    symbol_t prev = SYMBOL_SOS;
+    // Semicolons are only written between statements, so that trailing
+    // ones don't make otherwise identical statements differ
+    bool pending_semicolon = false;
+    while (true) {
+        const token_t& tok = lex.next();
+        symbol_t sym = tok.symbol;
+        switch (sym) {
+            case SYMBOL_EOS:
+                return true;
+            case SYMBOL_ERROR:
+                return false;
+            case SYMBOL_COMMENT:
+                continue;
+            case SYMBOL_SEMICOLON:
+                pending_semicolon = (prev != SYMBOL_SOS);
+                continue;
+            default:
+                break;
+        }
+        if (pending_semicolon) {
+            out.put(';');
+            pending_semicolon = false;
+        }
+        if (prev != SYMBOL_SOS && prev != SYMBOL_LPAREN &&
+                sym != SYMBOL_RPAREN && sym != SYMBOL_COMMA)
+            out.put(' ');
+
+        // A sign directly in front of a number is part of the literal unless
+        // it follows something it could be subtracted from or added to
+        if ((sym == SYMBOL_MINUS || sym == SYMBOL_PLUS) &&
+                prev != SYMBOL_IDENTIFIER && prev != SYMBOL_RPAREN &&
+                prev != SYMBOL_QUESTION_MARK &&
+                is_numeric_literal(lex.peek()))
+            sym = lex.next().symbol;
+
+        if (sym >= SYMBOL_LITERAL_APPROXIMATE_NUMBER) {
+            out.put('?');
+            prev = SYMBOL_QUESTION_MARK;
+            continue;
+        }
+        if (sym == SYMBOL_LPAREN && prev == SYMBOL_IN &&
+                skip_literal_list(lex)) {
+            // However many values an IN predicate lists, it has the same
+            // shape
+            out.put("(...)", 5);
+            prev = SYMBOL_RPAREN;
+            continue;
+        }
+        if (is_keyword_symbol(sym))
+            out.put_upper(tok.lexeme.start, tok.lexeme.size());
+        else
+            out.put(tok.lexeme.start, tok.lexeme.size());
+        // Literals already written as placeholders are remembered as
+        // SYMBOL_QUESTION_MARK, so a real parameter marker looks the same
+        prev = sym;
+    }
+}
+
+} // namespace <anonymous>
+
+bool fingerprint(const char* subject, size_t len, fingerprint_t& out) {
+    out.normalized.clear();
+    fingerprint_sink<true> sink(&out.normalized);
+    bool ok = fingerprint_tokens(subject, len, sink);
+    out.hash = sink.hash;
+    return ok;
+}
+
+bool fingerprint_hash(const char* subject, size_t len, uint64_t& hash) {
+    fingerprint_sink<false> sink(nullptr);
+    bool ok = fingerprint_tokens(subject, len, sink);
+    hash = sink.hash;
+    return ok;
+}
+
+} // namespace sqltoast
@@ -6,6 +6,7 @@
 
 #include "sqltoast/sqltoast.h"
 
+#include "parser/char_class.h"
 #include "parser/identifier.h"
 
 namespace sqltoast {
@@ -53,13 +54,12 @@ tokenize_result_t token_identifier(
         return token_delimited_identifier(cursor, end, current_escape);
 
     // The first character of a non-delimited identifier must be a latin1 alpha
-    if (! std::isalpha(*cursor++))
+    if (! is_alpha(*cursor++))
         return tokenize_result_t(TOKEN_NOT_FOUND);
 
     // If we're not a delimited identifier, then consume all non-space characters
     // until the end of the parse subject or the next whitespace character
-    while (cursor != end && (std::isalnum(*cursor) || *cursor == '.' || *cursor == '_' || *cursor == '*'))
-        cursor++;
+    cursor = scan_identifier(cursor, end);
 
     // if we went more than a single character, that's an identifier...
     if (start != cursor)
@@ -84,11 +84,10 @@ tokenize_result_t token_delimited_identifier(
         default:
             return tokenize_result_t(TOKEN_NOT_FOUND);
     }
-    char c;
     while (cursor != end) {
-        cursor++;
-        c = *cursor;
-        if (c == closer) {
+        if (++cursor == end)
+            break;
+        if (*cursor == closer) {
             return tokenize_result_t(SYMBOL_IDENTIFIER, start, cursor);
         }
     }
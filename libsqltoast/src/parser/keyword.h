@@ -7,49 +7,55 @@
 #ifndef SQLTOAST_PARSER_KEYWORD_H
 #define SQLTOAST_PARSER_KEYWORD_H
 
+#include <cstdint>
+
 #include "parser/lexer.h"
 #include "parser/symbol.h"
 
 namespace sqltoast {
 
-typedef struct kw_jump_table_entry {
+// A keyword table entry associates a keyword symbol with its upper-cased
+// string and that string's length. Entries are generated from symbols.def
+// into a static read-only array that is laid out at compile time, so looking
+// up a keyword never allocates.
+typedef struct kw_table_entry {
     symbol_t symbol;
-    const std::string kw_str;
-    kw_jump_table_entry(symbol_t sym, const char *kw_str) :
-        symbol(sym), kw_str(kw_str)
-    {}
-} kw_jump_table_entry_t;
-typedef std::vector<kw_jump_table_entry_t> kw_jump_table_t;
-
-struct kw_jump_tables {
-    // There is a separate list of jump table entries for each lead character
-    static kw_jump_table_t a;
-    static kw_jump_table_t b;
-    static kw_jump_table_t c;
-    static kw_jump_table_t d;
-    static kw_jump_table_t e;
-    static kw_jump_table_t f;
-    static kw_jump_table_t g;
-    static kw_jump_table_t h;
-    static kw_jump_table_t i;
-    static kw_jump_table_t j;
-    static kw_jump_table_t k;
-    static kw_jump_table_t l;
-    static kw_jump_table_t m;
-    static kw_jump_table_t n;
-    static kw_jump_table_t o;
-    static kw_jump_table_t p;
-    static kw_jump_table_t r;
-    static kw_jump_table_t s;
-    static kw_jump_table_t t;
-    static kw_jump_table_t u;
-    static kw_jump_table_t v;
-    static kw_jump_table_t w;
-    static kw_jump_table_t y;
-    static kw_jump_table_t z;
-};
-
-kw_jump_table_t _init_kw_jump_table(const char c);
+    const char *kw_str;
+    size_t kw_len;
+} kw_table_entry_t;
+
+// The number of slots in the keyword hash table, a power of two. Keywords
+// are hashed on their length and first two characters, so a word is compared
+// against little more than the keywords that share all three with it.
+const size_t KW_HASH_BITS = 9;
+const size_t KW_HASH_SIZE = size_t(1) << KW_HASH_BITS;
+
+// Multiplicative hash of a word's length and its first two characters,
+// folded onto upper-case, giving a slot in the keyword hash table
+constexpr size_t kw_hash(size_t len, unsigned char c0, unsigned char c1) {
+    return (uint32_t((c0 | (c1 << 8) | (len << 16)) * 0xC2B2AE35u)
+            >> (32 - KW_HASH_BITS));
+}
+
+// The lengths of the shortest and longest keywords. Any word with a length
+// outside of this range cannot be a keyword and is rejected without consulting
+// the hash table.
+const size_t KW_MIN_LEN = 2;
+const size_t KW_MAX_LEN = 17;
+
+// Returns true if the len characters starting at the supplied cursor match
+// the supplied upper-case keyword string, ignoring ASCII case.
+inline bool kw_equal(parse_position_t cursor, const char *kw_str, size_t len) {
+    // Keywords contain only upper-case latin letters and the underscore.
+    // Clearing the 0x20 bit folds lower-case letters onto upper-case ones,
+    // leaves the underscore alone and moves digits out of the range of any
+    // keyword character, so a single mask replaces a locale-aware toupper().
+    for (size_t x = 0; x < len; x++) {
+        if ((cursor[x] & 0xDF) != kw_str[x])
+            return false;
+    }
+    return true;
+}
 
 // Moves the supplied parse context's cursor to the next keyword found in the
 // context's input stream and sets the context's current symbol to the found
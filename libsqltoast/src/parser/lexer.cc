@@ -4,10 +4,13 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <algorithm>
+
 #include "sqltoast/sqltoast.h"
 
 #include "context.h"
 #include "error.h"
+#include "parser/char_class.h"
 #include "parser/comment.h"
 #include "parser/identifier.h"
 #include "parser/lexer.h"
@@ -18,84 +21,244 @@
 
 namespace sqltoast {
 
-parse_position_t skip_simple_comments(parse_position_t cursor) {
+parse_position_t skip_simple_comments(
+        parse_position_t cursor,
+        const parse_position_t end) {
     parse_position_t start = cursor;
-    if (*cursor != '-')
+    if (cursor == end || *cursor != '-')
         return start;
 
     cursor++;
-    if (*cursor != '-') {
+    if (cursor == end || *cursor != '-') {
         return start;
     }
 
     // The comment content is from the cursor until we find a newline or EOS
     do {
         cursor++;
-    } while (*cursor != '\0' && *cursor != '\n');
+    } while (cursor != end && *cursor != '\0' && *cursor != '\n');
     return cursor;
 }
 
-parse_position_t skip(parse_position_t cur) {
-    // Advance the lexer's cursor over any whitespace or simple comments
-    while (std::isspace(*cur))
-        cur++;
-    cur = skip_simple_comments(cur);
-    return cur;
+parse_position_t skip(parse_position_t cur, const parse_position_t end) {
+    // Advance the lexer's cursor over any whitespace or simple comments,
+    // including any whitespace following a comment and any number of
+    // consecutive comment lines
+    while (true) {
+        cur = scan_space(cur, end);
+        parse_position_t after_comment = skip_simple_comments(cur, end);
+        if (after_comment == cur)
+            return cur;
+        cur = after_comment;
+    }
+}
+
+// The tokenizers below are used for lead characters that more than one of
+// the primary tokenizers might accept. Each tries the candidate tokenizers
+// in the same order as the lexer originally tried every tokenizer, so the
+// first one to find a token (or an error) wins just as it did before.
+
+// Letters start either keywords or identifiers
+static tokenize_result_t token_word(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    auto tok_res = token_keyword(cursor, end);
+    if (tok_res.code != TOKEN_NOT_FOUND)
+        return tok_res;
+    return token_identifier(cursor, end);
+}
+
+// 'N', 'B' and 'X' followed by a single quote start national character,
+// bit and hex string literals. Otherwise they start a keyword or identifier
+// like any other letter.
+static tokenize_result_t token_word_or_literal(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    auto tok_res = token_keyword(cursor, end);
+    if (tok_res.code != TOKEN_NOT_FOUND)
+        return tok_res;
+    tok_res = token_literal(cursor, end);
+    if (tok_res.code != TOKEN_NOT_FOUND)
+        return tok_res;
+    return token_identifier(cursor, end);
+}
+
+// '/' is either the start of a bracketed comment or the solidus operator
+static tokenize_result_t token_comment_or_special(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    auto tok_res = token_comment(cursor, end);
+    if (tok_res.code != TOKEN_NOT_FOUND)
+        return tok_res;
+    return token_special(cursor, end);
+}
+
+static tokenize_result_t token_not_found(
+        parse_position_t,
+        const parse_position_t) {
+    return tokenize_result_t(TOKEN_NOT_FOUND);
+}
+
+// Maps the first character of a token to the tokenizer that handles tokens
+// starting with that character. Note that '+' and '-' are always the plus
+// and minus operators, as they were when the special symbol tokenizer was
+// tried before the literal tokenizer.
+typedef struct tokenizer_dispatch_table {
+    tokenize_func_t funcs[256];
+    constexpr tokenizer_dispatch_table() : funcs() {
+        for (int c = 0; c < 256; c++)
+            funcs[c] = &token_not_found;
+        for (const char c : "\0,=()*<>!+-|;?:")
+            funcs[static_cast<unsigned char>(c)] = &token_special;
+        funcs['/'] = &token_comment_or_special;
+        for (int c = 'A'; c <= 'Z'; c++) {
+            funcs[c] = &token_word;
+            funcs[c + ('a' - 'A')] = &token_word;
+        }
+        funcs['N'] = &token_word_or_literal;
+        funcs['B'] = &token_word_or_literal;
+        funcs['X'] = &token_word_or_literal;
+        for (int c = '0'; c <= '9'; c++)
+            funcs[c] = &token_literal;
+        funcs['\''] = &token_literal;
+        funcs['"'] = &token_identifier;
+        funcs['`'] = &token_identifier;
+    }
+} tokenizer_dispatch_table_t;
+
+static constexpr tokenizer_dispatch_table_t tokenizers{};
+
+tokenize_result_t lexer_t::tokenize_at(parse_position_t cur) const {
+    num_tokenize_calls++;
+    return tokenizers.funcs[static_cast<unsigned char>(*cur)](cur, end);
+}
+
+void lexer_t::tokenize() {
+    tokens.clear();
+    // Tokens in typical SQL average a little over four bytes including the
+    // whitespace between them, so this avoids most regrowth of the vector
+    tokens.reserve((end - cursor) / 4 + 1);
+    token_idx = 0;
+    parse_position_t cur = cursor;
+    while (true) {
+        parse_position_t tok_start = skip(cur, end);
+        if (tok_start >= end) {
+            cur = tok_start;
+            break;
+        }
+        auto tok_res = tokenize_at(tok_start);
+        // Stop at anything that isn't a plain token. The parser will see
+        // the same error (or lack of a token) when it tokenizes that
+        // position on demand.
+        if (tok_res.code != TOKEN_FOUND)
+            break;
+        tokens.push_back(tok_res.token);
+        cur = tok_res.token.lexeme.end;
+    }
+    tokenized_end = cur;
+    pretokenized = true;
 }
 
-static size_t NUM_TOKENIZERS = 5;
-static tokenize_func_t tokenizers[5] = {
-    &token_comment,
-    &token_special,
-    &token_keyword,
-    &token_literal,
-    &token_identifier
-};
+ssize_t lexer_t::find_token(parse_position_t cur) const {
+    if (tokenized_end < end) {
+        if (cur >= tokenized_end)
+            return -1;
+    } else if (tokens.empty() || cur >= tokens.back().lexeme.end)
+        return tokens.size();
+
+    // Tokenizing from cur finds token x if cur is at or after the end of the
+    // token before it and at or before the start of token x. Anything else
+    // means cur is in the middle of a token and must be tokenized on demand.
+    auto matches = [&](size_t x) {
+        return (x < tokens.size() &&
+                tokens[x].lexeme.start >= cur &&
+                (x == 0 || tokens[x - 1].lexeme.end <= cur));
+    };
+    // The cursor is almost always either at the hint or one token past it
+    // (peek_from() called with the position returned from a previous peek)
+    if (matches(token_idx))
+        return token_idx;
+    if (matches(token_idx + 1))
+        return token_idx + 1;
+
+    auto it = std::lower_bound(tokens.cbegin(), tokens.cend(), cur,
+            [](const token_t& tok, parse_position_t pos) {
+                return tok.lexeme.start < pos;
+            });
+    size_t x = it - tokens.cbegin();
+    if (matches(x))
+        return x;
+    return -1;
+}
 
 parse_position_t lexer_t::peek_from(parse_position_t cur, symbol_t* found) const {
-    // Advance the lexer's cursor over any whitespace or simple comments
     *found = SYMBOL_EOS;
-    cur = skip(cur);
+    if (pretokenized) {
+        ssize_t x = find_token(cur);
+        if (x == ssize_t(tokens.size()))
+            return tokenized_end;
+        if (x >= 0) {
+            *found = tokens[x].symbol;
+            return tokens[x].lexeme.end;
+        }
+    }
+
+    // Advance the lexer's cursor over any whitespace or simple comments
+    cur = skip(cur, end);
     if (cur >= end)
         return cur;
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        if (tok_res.code == TOKEN_NOT_FOUND)
-            continue;
-        if (tok_res.code == TOKEN_FOUND) {
-            *found = tok_res.token.symbol;
-            cur = tok_res.token.lexeme.end;
-            break;
-        }
-        // There was an error in tokenizing... return some error marker?
-        break;
+    auto tok_res = tokenize_at(cur);
+    if (tok_res.code == TOKEN_FOUND) {
+        *found = tok_res.token.symbol;
+        cur = tok_res.token.lexeme.end;
     }
+    // There was an error in tokenizing... return some error marker?
     return cur;
 }
 
 symbol_t lexer_t::peek() const {
+    if (pretokenized) {
+        ssize_t x = find_token(cursor);
+        if (x == ssize_t(tokens.size()))
+            return SYMBOL_EOS;
+        if (x >= 0)
+            return tokens[x].symbol;
+    }
+
     parse_position_t cur = cursor;
-    cur = skip(cur);
+    cur = skip(cur, end);
     if (cur >= end)
         return SYMBOL_EOS;
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        if (tok_res.code == TOKEN_NOT_FOUND)
-            continue;
-        if (tok_res.code == TOKEN_FOUND)
-            return tok_res.token.symbol;
-        // There was an error in tokenizing... return some error marker?
-        return SYMBOL_EOS;
-    }
-    // No more tokens
+    auto tok_res = tokenize_at(cur);
+    if (tok_res.code == TOKEN_FOUND)
+        return tok_res.token.symbol;
+    // There was an error in tokenizing or no more tokens
     return SYMBOL_EOS;
 }
 
 token_t& lexer_t::next() {
+    if (pretokenized) {
+        ssize_t x = find_token(cursor);
+        if (x == ssize_t(tokens.size())) {
+            current_token.symbol = SYMBOL_EOS;
+            current_token.lexeme.start = end;
+            current_token.lexeme.end = end;
+            cursor = tokenized_end;
+            token_idx = x;
+            return current_token;
+        }
+        if (x >= 0) {
+            current_token = tokens[x];
+            cursor = current_token.lexeme.end;
+            token_idx = x + 1;
+            return current_token;
+        }
+    }
+
     parse_position_t cur = cursor;
-    cur = skip(cur);
+    cur = skip(cur, end);
     if (cur >= end) {
         current_token.symbol = SYMBOL_EOS;
         current_token.lexeme.start = end;
@@ -104,17 +267,25 @@ token_t& lexer_t::next() {
         return current_token;
     }
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        tokenize_result_code_t res_code = tok_res.code;
-        if (res_code == TOKEN_NOT_FOUND)
-            continue;
+    auto tok_res = tokenize_at(cur);
+    if (tok_res.code != TOKEN_NOT_FOUND) {
         // If there was an error in finding the next token, then tok_res.token
         // will contain SYMBOL_ERROR and the lexeme will point to the place
         // where the lexing error occurring.
         current_token = tok_res.token;
         cur = tok_res.token.lexeme.end;
-        break;
+    } else {
+        // Nothing recognizes the character at cur. Returning the previous
+        // token again would have rules that loop on a token, like the
+        // parenthesized value expression, recurse on it forever. The error
+        // token's lexeme is the unrecognized character, including any UTF-8
+        // continuation bytes, so that syntax errors can show it.
+        parse_position_t char_end = cur + 1;
+        while (char_end < end && (*char_end & 0xC0) == 0x80)
+            char_end++;
+        current_token.symbol = SYMBOL_ERROR;
+        current_token.lexeme.start = cur;
+        current_token.lexeme.end = char_end;
     }
     cursor = cur;
     return current_token;
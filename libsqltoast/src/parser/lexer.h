@@ -7,6 +7,8 @@
 #ifndef SQLTOAST_PARSER_LEXER_H
 #define SQLTOAST_PARSER_LEXER_H
 
+#include <vector>
+
 #include "parser/token.h"
 
 namespace sqltoast {
@@ -20,17 +22,49 @@ enum escape_mode {
     ESCAPE_UNICODE_AMPERSAND = 4
 };
 
+typedef struct tokenize_result tokenize_result_t;
+
 typedef struct lexer {
     parse_position_t start;
     parse_position_t end;
     parse_position_t cursor;
     token_t current_token;
-    lexer(parse_input_t& subject) :
-        start(subject.cbegin()),
-        end(subject.cend()),
-        cursor(subject.cbegin()),
-        current_token(SYMBOL_SOS, subject.cbegin(), subject.cbegin())
+    // When the lexer has been pre-tokenized, tokens contains every token
+    // found in the subject, in order. Looking up the token after some cursor
+    // position then becomes a search of this vector instead of a run of the
+    // tokenizers. If the whole subject was tokenized, tokenized_end is the
+    // position of the end-of-subject marker (at or past end). Otherwise,
+    // tokenizing stopped early on unrecognized or malformed input, and
+    // positions at or past tokenized_end are always tokenized on demand.
+    bool pretokenized;
+    std::vector<token_t> tokens;
+    parse_position_t tokenized_end;
+    // Index into tokens of the token following the cursor, used as a hint to
+    // make the common case of next() a constant-time operation
+    size_t token_idx;
+    // The number of times the chain of tokenizer functions has been run
+    // against the subject. Useful for seeing how much lookahead and
+    // backtracking costs for a particular statement.
+    mutable size_t num_tokenize_calls;
+    lexer(parse_position_t start, parse_position_t end) :
+        lexer(start, start, end)
+    {}
+    // Constructs a lexer that starts at from, somewhere within the subject
+    // beginning at start
+    lexer(parse_position_t start, parse_position_t from, parse_position_t end) :
+        start(start),
+        end(end),
+        cursor(from),
+        current_token(SYMBOL_SOS, from, from),
+        pretokenized(false),
+        tokenized_end(from),
+        token_idx(0),
+        num_tokenize_calls(0)
     {}
+    // Tokenizes the entire subject from the cursor onwards up front, storing
+    // each found token in the lexer's tokens vector, after which peek(),
+    // peek_from() and next() are served from that vector
+    void tokenize();
     // Returns the next symbol after the lexer's current cursor.
     symbol_t peek() const;
     // Populates a supplied symbol pointer with the value of the symbol found
@@ -42,6 +76,14 @@ typedef struct lexer {
     // Attempts to find the next token. If a token was found, returns a pointer
     // to that token, else NULL.
     token_t& next();
+private:
+    // Runs the tokenizer for the character at the supplied (already
+    // whitespace-skipped) cursor position and returns its result
+    tokenize_result_t tokenize_at(parse_position_t cur) const;
+    // Returns the index of the pre-tokenized token that tokenizing from the
+    // supplied position would find, tokens.size() if the end of the subject
+    // would be found, or -1 if the position must be tokenized on demand
+    ssize_t find_token(parse_position_t cur) const;
 } lexer_t;
 
 typedef enum tokenize_result_code {
@@ -78,10 +120,7 @@ typedef tokenize_result_t (*tokenize_func_t) (
 
 // Advances the supplied cursor past any whitespace and simple SQL comments and
 // returns the location of the cursor after skipping
-parse_position_t skip(parse_position_t cur);
-// Advances the supplied cursor past any simple SQL comments and returns the
-// location of the cursor after skipping
-parse_position_t skip_simple_comments(parse_position_t cursor);
+parse_position_t skip(parse_position_t cur, const parse_position_t end);
 
 } // namespace sqltoast
 
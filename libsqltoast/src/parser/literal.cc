@@ -6,6 +6,7 @@
 
 #include "sqltoast/sqltoast.h"
 
+#include "parser/char_class.h"
 #include "parser/literal.h"
 
 namespace sqltoast {
@@ -17,7 +18,7 @@ tokenize_result_t token_literal(
     switch (*cursor) {
         case '+':
         case '-':
-            if (! std::isdigit(*(cursor + 1)))
+            if (! is_digit(*(cursor + 1)))
                 return tokenize_result_t(TOKEN_NOT_FOUND);
             return token_numeric_literal(cursor, end, true);
         case '0':
@@ -74,18 +75,18 @@ tokenize_result_t token_numeric_literal(
     if (found_sign)
         found_sym = SYMBOL_LITERAL_SIGNED_INTEGER;
     while (cursor != end) {
-        if (std::isspace(*cursor)) {
+        if (is_space(*cursor)) {
             if (found_e) {
                 // Make sure the exponent has at least one number
-                if (! std::isdigit(*(cursor - 1)))
+                if (! is_digit(*(cursor - 1)))
                     goto not_found;
                 found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
             }
             goto push_literal;
         }
         c = *cursor;
-        if (std::isdigit(c)) {
-            cursor++;
+        if (is_digit(c)) {
+            cursor = scan_digits(cursor + 1, end);
             continue;
         }
         switch (c) {
@@ -93,13 +94,20 @@ tokenize_result_t token_numeric_literal(
             case ')':
             case '(':
             case ';':
+            case '*':
+            case '/':
+            case '=':
+            case '<':
+            case '>':
+            case '|':
+            end_literal:
                 // Make sure if we got a single . that we followed it with
                 // at least one number...
                 if (found_decimal && *(cursor - 1) == '.')
                     goto not_found;
                 if (found_e) {
                     // Make sure the exponent has at least one number
-                    if (! std::isdigit(*(cursor - 1)))
+                    if (! is_digit(*(cursor - 1)))
                         goto not_found;
                     found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
                 }
@@ -124,18 +132,20 @@ tokenize_result_t token_numeric_literal(
                 // <exact numeric literal>E<signed integer> grammar
                 found_e = true;
                 // Make sure we have found at least a digit before the 'E'
-                if (! std::isdigit(*(cursor - 2)))
+                if (! is_digit(*(cursor - 1)) && *(cursor - 1) != '.')
                     goto not_found;
                 cursor++;
                 continue;
             case '+':
             case '-':
-                // We should ONLY get here if there is an approximate number
-                // (e.g. 3.667E-10).
-                if (! found_e)
-                    goto not_found;
-                cursor++;
-                continue;
+                // Directly after the "E" of an approximate number (e.g.
+                // 3.667E-10) this is the sign of the exponent. Anywhere else
+                // it's a plus or minus operator following the number.
+                if (found_e && *(cursor - 1) == 'E') {
+                    cursor++;
+                    continue;
+                }
+                goto end_literal;
             default:
                 goto not_found;
         }
@@ -149,7 +159,7 @@ tokenize_result_t token_numeric_literal(
             goto not_found;
         // Make sure the exponent has at least one number
         if (found_e) {
-            if (! std::isdigit(last_char))
+            if (! is_digit(last_char))
                 goto not_found;
             found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
         }
@@ -193,10 +203,13 @@ tokenize_result_t token_bit_string_literal(
     char last_c = c;
     while (cursor != end) {
         c = *cursor;
-        if (std::isspace(c))
-            break;
-        if (c != '0' && c != '1' && c != '\'')
+        if (c != '0' && c != '1' && c != '\'') {
+            // Anything but whitespace, such as the comma or parenthesis
+            // following the literal, also ends it after the closing quote
+            if (is_space(c) || last_c == '\'')
+                break;
             return tokenize_result_t(TOKEN_NOT_FOUND);
+        }
         last_c = c;
         ++cursor;
     }
@@ -216,10 +229,13 @@ tokenize_result_t token_hex_string_literal(
     char last_c = c;
     while (cursor != end) {
         c = *cursor;
-        if (std::isspace(c))
-            break;
-        if (! std::isxdigit(c) && c != '\'')
+        if (! is_xdigit(c) && c != '\'') {
+            // Anything but whitespace, such as the comma or parenthesis
+            // following the literal, also ends it after the closing quote
+            if (is_space(c) || last_c == '\'')
+                break;
             return tokenize_result_t(TOKEN_NOT_FOUND);
+        }
         last_c = c;
         ++cursor;
     }
@@ -0,0 +1,48 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_MEMO_H
+#define SQLTOAST_PARSER_MEMO_H
+
+#include <unordered_map>
+
+#include "parser/token.h"
+
+namespace sqltoast {
+
+// The grammar rules whose results are memoized when parsing with
+// parse_options_t::memoize set. These are the rules that the parser may
+// attempt more than once at the same position while backtracking.
+typedef enum memo_rule {
+    MEMO_RULE_VALUE_EXPRESSION,
+    MEMO_RULE_ROW_VALUE_CONSTRUCTOR,
+    MEMO_RULE_PREDICATE,
+    MEMO_RULE_TABLE_REFERENCE,
+    MEMO_RULE_QUERY_EXPRESSION
+} memo_rule_t;
+
+// The outcome of attempting a rule at some position, along with the state
+// the attempt left the lexer in
+typedef struct memo_entry {
+    bool found;
+    parse_position_t cursor;
+    token_t cur_tok;
+    token_t current_token;
+} memo_entry_t;
+
+typedef struct memo_table {
+    // Keyed by the rule in the top byte and the offset of the token the rule
+    // was attempted at in the rest
+    std::unordered_map<uint64_t, memo_entry_t> entries;
+    size_t hits;
+    size_t misses;
+    memo_table() : hits(0), misses(0)
+    {}
+} memo_table_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_MEMO_H */
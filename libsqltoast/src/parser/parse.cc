@@ -4,9 +4,7 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <cctype>
-#include <sstream>
-
+#include "parser/arena.h"
 #include "parser/context.h"
 #include "parser/error.h"
 #include "parser/lexer.h"
@@ -16,25 +14,38 @@
 namespace sqltoast {
 
 parse_result_t parse(parse_input_t& subject) {
+    return parse(subject.data(), subject.size());
+}
+
+parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
+    return parse(subject.data(), subject.size(), opts);
+}
+
+parse_result_t parse(const char* subject, size_t len) {
     parse_options_t opts = {
         SQL_DIALECT_ANSI_1992,
+        false,
+        false,
+        false,
+        false,
         false
     };
 
-    return parse(subject, opts);
+    return parse(subject, len, opts);
 }
 
-parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
-    parse_result_t res;
-    res.code = PARSE_OK;
-    parse_context_t ctx(res, opts, subject);
+void parse_statements(parse_context_t& ctx) {
+    parse_result_t& res = ctx.result;
     lexer_t& lex = ctx.lexer;
     token_t& cur_tok = lex.current_token;
 
     if (lex.cursor == lex.end) {
-        res.code = PARSE_INPUT_ERROR;
-        res.error.assign("Nothing to parse.");
-        return res;
+        input_error(ctx, "Nothing to parse.");
+        return;
+    }
+    if (size_t(lex.end - lex.start) >= LEXEME_NONE) {
+        input_error(ctx, "Input is too large to parse.");
+        return;
     }
     cur_tok = lex.next();
 
@@ -49,15 +60,25 @@ parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
             parse_statement(ctx);
             continue;
         }
-        {
-            std::stringstream estr;
-            estr << "SQL statements begin with a keyword and end with a "
-                    "semicolon, but found " << cur_tok << "." << std::endl;
-            create_syntax_error_marker(ctx, estr);
-            continue;
-        }
+        syntax_error(ctx, "SQL statements begin with a keyword and end "
+                          "with a semicolon, but found %t.");
+        continue;
     }
+    if (res.code != PARSE_OK)
+        locate_error(ctx);
+    if (ctx.memo) {
+        res.memo_hits = ctx.memo->hits;
+        res.memo_misses = ctx.memo->misses;
+    }
+}
 
+parse_result_t parse(const char* subject, size_t len, parse_options_t& opts) {
+    parse_result_t res;
+    if (opts.use_arena)
+        res.arena.reset(new arena_t);
+    arena_scope_t scope(res.arena.get());
+    parse_context_t ctx(res, opts, subject, subject + len);
+    parse_statements(ctx);
     return res;
 }
 
@@ -19,6 +19,60 @@ typedef bool (*parse_func_t) (
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out);
 
+// Parses every statement in the context's subject into the context's
+// result, stopping at the end of the subject or the first syntax error. This
+// is the primary parse() loop over found tokens.
+void parse_statements(parse_context_t& ctx);
+
+// Attempts the supplied rule, or replays the outcome of an earlier attempt
+// at the same position if there was one.
+//
+// Failures are replayed no matter what, since whether a rule matches only
+// depends on the tokens following the position. Successes are only replayed
+// when statement construction is disabled, because otherwise the caller
+// needs the AST nodes built by the rule, and those went to whoever made the
+// earlier attempt. Attempts that end in a syntax error are never recorded.
+template<typename T>
+inline bool memoized(
+        parse_context_t& ctx,
+        memo_rule_t rule,
+        token_t& cur_tok,
+        std::unique_ptr<T>& out,
+        bool (*parse_rule)(
+            parse_context_t& ctx,
+            token_t& cur_tok,
+            std::unique_ptr<T>& out)) {
+    memo_table_t* memo = ctx.memo.get();
+    // A rule attempted right after a primary that parse_value_expression()
+    // has already parsed starts with that primary instead of the token, so
+    // its outcome isn't just a function of the position
+    if (memo == nullptr || ctx.has_parsed_primary(cur_tok))
+        return parse_rule(ctx, cur_tok, out);
+
+    lexer_t& lex = ctx.lexer;
+    uint64_t key = (uint64_t(rule) << 56) |
+                   uint64_t(cur_tok.lexeme.start - lex.start);
+    auto found = memo->entries.find(key);
+    if (found != memo->entries.end()) {
+        const memo_entry_t& entry = found->second;
+        if (! entry.found || ctx.opts.disable_statement_construction) {
+            memo->hits++;
+            lex.cursor = entry.cursor;
+            lex.current_token = entry.current_token;
+            cur_tok = entry.cur_tok;
+            return entry.found;
+        }
+    }
+    memo->misses++;
+    bool res = parse_rule(ctx, cur_tok, out);
+    if (ctx.result.code != PARSE_OK)
+        return res;
+    if (res && ! ctx.opts.disable_statement_construction)
+        return res;
+    memo->entries[key] = {res, lex.cursor, cur_tok, lex.current_token};
+    return res;
+}
+
 // Top-level statement parser that is called from within the primary parse()
 // loop over found tokens.
 void parse_statement(parse_context_t& ctx);
@@ -181,16 +235,6 @@ bool parse_search_condition(
         token_t& cur_tok,
         std::unique_ptr<search_condition_t>& out);
 
-bool parse_boolean_term(
-        parse_context_t& ctx,
-        token_t& cur_tok,
-        std::unique_ptr<boolean_term_t>& out);
-
-bool parse_boolean_factor(
-        parse_context_t& ctx,
-        token_t& cur_tok,
-        std::unique_ptr<boolean_factor_t>& out);
-
 // Returns true if a oredicate could be parsed. If true, the out
 // argument will have a new pointer to a boolean_factor_t subclass that
 // represents a prdicate added to it.
@@ -474,12 +518,12 @@ bool parse_referential_action(
         referential_action_t* action);
 
 // Returns true if a collate clause can be parsed from the supplied
-// token iterator. If the function returns true, column_def will have a its
-// collate member populated.
+// token iterator. If the function returns true, out will be set to the
+// collation's name.
 bool parse_collate_clause(
         parse_context_t& ctx,
         token_t& cur_tok,
-        column_definition_t& column_def);
+        lexeme_t& out);
 
 // Returns true if a data type descriptor clause can be parsed from the supplied
 // token iterator. If the function returns true, the out argument will
@@ -0,0 +1,58 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "parser/arena.h"
+#include "parser/context.h"
+#include "parser/parse.h"
+
+namespace sqltoast {
+
+// The buffers a parser keeps between calls that aren't part of the parse
+// result, and so aren't visible in the public headers
+typedef struct parser_buffers {
+    std::vector<token_t> tokens;
+} parser_buffers_t;
+
+parser::parser(parse_options_t& opts) :
+    opts(opts),
+    buffers(std::make_unique<parser_buffers_t>())
+{}
+
+parser::~parser() {
+    // The statements may live in the arena, so they need to go first
+    res.statements.clear();
+}
+
+parse_result_t& parser::parse(parse_input_t& subject) {
+    return parse(subject.data(), subject.size());
+}
+
+parse_result_t& parser::parse(const char* subject, size_t len) {
+    // Reset the previous result without giving up any of its memory
+    res.statements.clear();
+    res.code = PARSE_OK;
+    res.error.clear();
+    res.memo_hits = 0;
+    res.memo_misses = 0;
+    res.flat.clear();
+    if (opts.use_arena) {
+        if (res.arena)
+            res.arena->reset();
+        else
+            res.arena.reset(new arena_t);
+    } else
+        res.arena.reset();
+
+    arena_scope_t scope(res.arena.get());
+    parse_context_t ctx(res, opts, subject, subject + len, buffers->tokens);
+    parse_statements(ctx);
+    // Hang on to the token buffer for the next call
+    if (opts.pretokenize)
+        ctx.lexer.tokens.swap(buffers->tokens);
+    return res;
+}
+
+} // namespace sqltoast
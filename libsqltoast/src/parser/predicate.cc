@@ -9,135 +9,153 @@
 
 namespace sqltoast {
 
-// <search condition> ::=
-//     <boolean term>
-//     | <search condition> OR <boolean term>
-bool parse_search_condition(
-        parse_context_t& ctx,
-        token_t& cur_tok,
-        std::unique_ptr<search_condition_t>& out) {
-    lexer_t& lex = ctx.lexer;
-    symbol_t cur_sym = cur_tok.symbol;
+namespace {
+
+// A search condition that has been opened but not yet closed: either the
+// outermost one or one enclosed in parentheses. Holds the OR'd terms found so
+// far and the term whose AND'd factors are currently being collected.
+typedef struct open_condition {
+    // true when NOT precedes the left parenthesis enclosing the condition
+    bool reverse_op;
+    std::unique_ptr<search_condition_t> cond;
     std::unique_ptr<boolean_term_t> term;
-
-    // We get here after getting one of the symbols that precede a search
-    // condition's definition, which include the WHERE and HAVING symbols, as
-    // well as the AND and OR symbols when constructing compound predicates
-
-    if (! parse_boolean_term(ctx, cur_tok, term))
-        return false;
-    goto ensure_search_condition;
-optional_or:
-    cur_sym = cur_tok.symbol;
-    if (cur_sym == SYMBOL_OR) {
-        cur_tok = lex.next();
-        if (! parse_boolean_term(ctx, cur_tok, term))
-            return false;
-        if (ctx.opts.disable_statement_construction)
-            goto optional_or;
-        out->terms.emplace_back(std::move(term));
-        goto optional_or;
+    // The last factor in term's chain, to which the next AND'd factor is
+    // appended
+    boolean_term_t* last;
+    open_condition(bool reverse_op) :
+        reverse_op(reverse_op),
+        last(nullptr)
+    {}
+} open_condition_t;
+
+inline void append_factor(
+        open_condition_t& open,
+        std::unique_ptr<boolean_factor_t>& factor) {
+    if (open.last) {
+        open.last->and_(factor);
+        open.last = open.last->and_operand.get();
+        return;
     }
-    return true;
-ensure_search_condition:
-    if (ctx.opts.disable_statement_construction)
-        goto optional_or;
-    out = std::make_unique<search_condition_t>();
-    out->terms.emplace_back(std::move(term));
-    goto optional_or;
+    open.term = std::make_unique<boolean_term_t>(factor);
+    open.last = open.term.get();
 }
 
+inline void end_term(open_condition_t& open) {
+    if (! open.cond)
+        open.cond = std::make_unique<search_condition_t>();
+    open.cond->terms.emplace_back(std::move(open.term));
+    open.last = nullptr;
+}
+
+} // namespace
+
+// <search condition> ::=
+//     <boolean term>
+//     | <search condition> OR <boolean term>
+//
 // <boolean term> ::=
 //     <boolean factor>
 //     | <boolean term> AND <boolean factor>
-bool parse_boolean_term(
-        parse_context_t& ctx,
-        token_t& cur_tok,
-        std::unique_ptr<boolean_term_t>& out) {
-    lexer_t& lex = ctx.lexer;
-    symbol_t cur_sym = cur_tok.symbol;
-    std::unique_ptr<boolean_factor_t> factor;
-
-    if (! parse_boolean_factor(ctx, cur_tok, factor))
-        return false;
-    goto ensure_term;
-optional_and:
-    cur_sym = cur_tok.symbol;
-    if (cur_sym == SYMBOL_AND) {
-        cur_tok = lex.next();
-        if (! parse_boolean_factor(ctx, cur_tok, factor))
-            return false;
-        if (! ctx.opts.disable_statement_construction)
-            out->and_(factor);
-        goto optional_and;
-    }
-    return true;
-ensure_term:
-    if (ctx.opts.disable_statement_construction)
-        goto optional_and;
-    out = std::make_unique<boolean_term_t>(factor);
-    goto optional_and;
-}
-
+//
 // <boolean factor> ::= [ NOT ] <boolean test>
 //
 // <boolean test> ::= <boolean primary> [ IS [ NOT ] <truth value> ]
 //
 // <boolean primary> ::= <predicate> | <left paren> <search condition> <right paren>
-bool parse_boolean_factor(
+//
+// Rather than recursing from search condition to boolean term to boolean
+// factor and back into a search condition for every parenthesized group, all
+// three are parsed here by precedence climbing: OR binds loosest, then AND,
+// then NOT, which applies to a single boolean primary. Parenthesized groups
+// are kept on an explicit stack of open conditions, so neither long chains of
+// AND'd and OR'd predicates nor deeply nested groups grow the native stack,
+// and each AND'd factor is appended to its term in constant time.
+bool parse_search_condition(
         parse_context_t& ctx,
         token_t& cur_tok,
-        std::unique_ptr<boolean_factor_t>& out) {
+        std::unique_ptr<search_condition_t>& out) {
     lexer_t& lex = ctx.lexer;
-    token_t start_tok = cur_tok;
-    parse_position_t start = lex.cursor;
-    symbol_t cur_sym = cur_tok.symbol;
+    symbol_t cur_sym;
+    token_t start_tok;
+    parse_position_t start;
     std::unique_ptr<predicate_t> predicate;
-    std::unique_ptr<search_condition_t> search_cond;
     std::unique_ptr<boolean_primary_t> primary;
-    bool reverse_op = false; // true when NOT precedes the boolean test
+    std::unique_ptr<boolean_factor_t> factor;
+    bool reverse_op;
+    // The open conditions are only needed to build the tree. When all we're
+    // doing is validating, counting them is enough.
+    std::vector<open_condition_t> open;
+    size_t depth = 1;
 
-    if (cur_sym == SYMBOL_NOT) {
+    // We get here after getting one of the symbols that precede a search
+    // condition's definition, which include the WHERE, HAVING and ON symbols
+    if (! ctx.opts.disable_statement_construction)
+        open.emplace_back(false);
+    goto expect_factor;
+expect_factor:
+    reverse_op = false;
+    if (cur_tok.symbol == SYMBOL_NOT) {
         cur_tok = lex.next();
         reverse_op = true;
     }
-    goto try_predicate;
-try_predicate:
+    start_tok = cur_tok;
+    start = lex.cursor;
     if (parse_predicate(ctx, cur_tok, predicate))
-        goto push_factor;
-    // rewind and try the nested search condition
+        goto push_predicate;
+    // rewind and try a nested search condition
     ctx.result.code = PARSE_OK;
-    ctx.result.error.assign("");
+    ctx.result.error.clear();
     cur_tok = start_tok;
     lex.cursor = start;
-    goto try_nested_search_condition;
-try_nested_search_condition:
+    if (cur_tok.symbol != SYMBOL_LPAREN)
+        return false;
+    cur_tok = lex.next();
+    depth++;
+    if (! ctx.opts.disable_statement_construction)
+        open.emplace_back(reverse_op);
+    goto expect_factor;
+push_predicate:
+    if (ctx.opts.disable_statement_construction)
+        goto optional_and_or;
+    primary = std::make_unique<boolean_primary_t>(predicate);
+    goto push_factor;
+push_factor:
+    factor = std::make_unique<boolean_factor_t>(primary, reverse_op);
+    append_factor(open.back(), factor);
+    goto optional_and_or;
+optional_and_or:
     cur_sym = cur_tok.symbol;
-    if (cur_sym == SYMBOL_LPAREN) {
+    if (cur_sym == SYMBOL_AND) {
         cur_tok = lex.next();
-        if (! parse_search_condition(ctx, cur_tok, search_cond))
-            return false;
-        goto expect_rparen;
+        goto expect_factor;
     }
-    return false;
+    if (! ctx.opts.disable_statement_construction)
+        end_term(open.back());
+    if (cur_sym == SYMBOL_OR) {
+        cur_tok = lex.next();
+        goto expect_factor;
+    }
+    if (depth == 1)
+        goto push_condition;
+    goto expect_rparen;
 expect_rparen:
-    cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
     cur_tok = lex.next();
+    depth--;
+    if (ctx.opts.disable_statement_construction)
+        goto optional_and_or;
+    reverse_op = open.back().reverse_op;
+    primary = std::make_unique<boolean_primary_t>(open.back().cond);
+    open.pop_back();
     goto push_factor;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
     return false;
-push_factor:
+push_condition:
     if (ctx.opts.disable_statement_construction)
         return true;
-
-    if (predicate)
-        primary = std::make_unique<boolean_primary_t>(predicate);
-    else
-        primary = std::make_unique<boolean_primary_t>(search_cond);
-    out = std::make_unique<boolean_factor_t>(primary, reverse_op);
+    out = std::move(open.back().cond);
     return true;
 }
 
@@ -151,7 +169,7 @@ push_factor:
 //     | <exists predicate>
 //     | <match predicate>
 //     | <overlaps predicate>
-bool parse_predicate(
+static bool parse_predicate_rule(
         parse_context_t& ctx,
         token_t& cur_tok,
         std::unique_ptr<predicate_t>& out) {
@@ -227,6 +245,20 @@ err_expected_between_in_or_like:
     return false;
 }
 
+// Attempts the rule above, or replays an earlier attempt at the same position
+// when parsing with parse_options_t::memoize set
+bool parse_predicate(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::unique_ptr<predicate_t>& out) {
+    return memoized(
+            ctx,
+            MEMO_RULE_PREDICATE,
+            cur_tok,
+            out,
+            &parse_predicate_rule);
+}
+
 // <comparison predicate> ::=
 //     <row value constructor> <comp op> <row value constructor>
 //
@@ -314,13 +346,9 @@ expect_right:
 err_expect_right:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the right side of the comparison predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a << row value constructor >> for "
+                      "the right side of the comparison predicate.");
+    return false;
 expect_subquery:
     // We get here after successfully parsing the left side of the predicate,
     // the operator, a quantifier and now expect to find a table subquery.
@@ -344,14 +372,9 @@ err_expect_rparen:
 err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a << table subquery >> for "
-                "the right side of the quantified comparison predicate."
-             << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a << table subquery >> for the "
+                      "right side of the quantified comparison predicate.");
+    return false;
 push_condition:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -396,23 +419,15 @@ err_expect_and:
 err_expect_left_comp:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the left comparison side of the between predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a << row value constructor >> for "
+                      "the left comparison side of the between predicate.");
+    return false;
 err_expect_right_comp:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the right comparison side of the between predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a << row value constructor >> for "
+                      "the right comparison side of the between predicate.");
+    return false;
 push_condition:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -539,7 +554,8 @@ process_subquery:
 process_value_list_item:
     if (! parse_value_expression(ctx, cur_tok, value))
         goto err_expect_value_expression;
-    values.emplace_back(std::move(value));
+    if (! ctx.opts.disable_statement_construction)
+        values.emplace_back(std::move(value));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -549,14 +565,9 @@ process_value_list_item:
 err_expect_value_expression:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a <value expression> as "
-                "an element of the IN operator but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a <value expression> as an element "
+                      "of the IN operator but found %t");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -604,13 +615,9 @@ err_expect_lparen:
 err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a <subquery> after EXISTS "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a <subquery> after EXISTS but "
+                      "found %t");
+    return false;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
     return false;
@@ -649,13 +656,9 @@ err_expect_lparen:
 err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find a <subquery> after UNIQUE "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a <subquery> after UNIQUE but "
+                      "found %t");
+    return false;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
     return false;
@@ -746,13 +749,9 @@ bool parse_overlaps_predicate(
         goto err_expect_rvc;
     goto push_predicate;
 err_expect_rvc:
-    {
-        std::stringstream estr;
-        estr << "Expected to find a <row value constructor> after OVERLAPS "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find a <row value constructor> after "
+                      "OVERLAPS but found %t");
+    return false;
 push_predicate:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -20,7 +20,7 @@ namespace sqltoast {
 // <query primary> ::=
 //     <non-join query primary>
 //     | <joined table>
-bool parse_query_expression(
+static bool parse_query_expression_rule(
         parse_context_t& ctx,
         token_t& cur_tok,
         std::unique_ptr<query_expression_t>& out) {
@@ -45,6 +45,20 @@ bool parse_query_expression(
     return true;
 }
 
+// Attempts the rule above, or replays an earlier attempt at the same position
+// when parsing with parse_options_t::memoize set
+bool parse_query_expression(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::unique_ptr<query_expression_t>& out) {
+    return memoized(
+            ctx,
+            MEMO_RULE_QUERY_EXPRESSION,
+            cur_tok,
+            out,
+            &parse_query_expression_rule);
+}
+
 // <non-join query expression> ::=
 //     <non-join query term>
 //     | <query expression> UNION
@@ -146,7 +160,8 @@ bool parse_table_value_constructor(
 process_value_list_item:
     if (! parse_row_value_constructor(ctx, cur_tok, val_list_item))
         goto err_expect_value_item;
-    val_list.emplace_back(std::move(val_list_item));
+    if (! ctx.opts.disable_statement_construction)
+        val_list.emplace_back(std::move(val_list_item));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -154,12 +169,8 @@ process_value_list_item:
     }
     goto push_tvc;
 err_expect_value_item:
-    {
-        std::stringstream estr;
-        estr << "Expected a value item, but got " << cur_tok << "." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected a value item, but got %t.");
+    return false;
 push_tvc:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -262,13 +273,8 @@ err_expect_join:
     expect_error(ctx, SYMBOL_JOIN);
     return false;
 err_expect_table_reference:
-    {
-        std::stringstream estr;
-        estr << "Expected <table reference> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <table reference> but found %t");
+    return false;
 optional_join_specification:
     // We get here after successfully parsing an INNER or OUTER symbol followed
     // by a JOIN symbol and a <table reference>. We now must check for the
@@ -291,13 +297,8 @@ process_join_condition:
         goto err_expect_join_condition;
     goto push_joined_table;
 err_expect_join_condition:
-    {
-        std::stringstream estr;
-        estr << "Expected <join condition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <join condition> but found %t");
+    return false;
 process_named_columns:
     // We get here after parsing a USING symbol, which must be followed by a
     // parens-enclosed list of column identifiers
@@ -313,7 +314,8 @@ process_named_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    named_columns.emplace_back(cur_tok.lexeme);
+    if (! ctx.opts.disable_statement_construction)
+        named_columns.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -392,7 +394,8 @@ bool parse_query_specification(
 expect_derived_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_ASTERISK) {
-        selected_columns.emplace_back(derived_column_t());
+        if (! ctx.opts.disable_statement_construction)
+            selected_columns.emplace_back(derived_column_t());
         cur_tok = lex.next();
         goto comma_or_from;
     }
@@ -400,7 +403,8 @@ expect_derived_column:
     // expression...
     if (! parse_value_expression(ctx, cur_tok, selected_col))
         goto err_expect_derived_column;
-    selected_columns.emplace_back(derived_column_t(selected_col));
+    if (! ctx.opts.disable_statement_construction)
+        selected_columns.emplace_back(derived_column_t(selected_col));
     goto optional_column_alias;
 err_expect_derived_column:
     expect_any_error(ctx, {SYMBOL_ASTERISK, SYMBOL_IDENTIFIER});
@@ -418,8 +422,8 @@ optional_column_alias:
             goto err_expect_identifier;
     }
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        derived_column_t& dc = selected_columns.back();
-        dc.alias = cur_tok.lexeme;
+        if (! ctx.opts.disable_statement_construction)
+            selected_columns.back().alias = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
     }
     goto comma_or_from;
@@ -478,7 +482,8 @@ bool parse_table_expression(
 expect_table_reference:
     if (! parse_table_reference(ctx, cur_tok, table_ref))
         return false;
-    referenced_tables.emplace_back(std::move(table_ref));
+    if (! ctx.opts.disable_statement_construction)
+        referenced_tables.emplace_back(std::move(table_ref));
     goto comma_or_where_group_having;
 comma_or_where_group_having:
     // We get here after consuming a table reference and now we expect to find
@@ -537,7 +542,8 @@ process_group_by_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    group_by_columns.emplace_back(grouping_column_reference_t(cur_tok.lexeme));
+    if (! ctx.opts.disable_statement_construction)
+        group_by_columns.emplace_back(grouping_column_reference_t(ctx.lexeme(cur_tok)));
     cur_tok = lex.next();
     goto optional_collation;
 err_expect_identifier:
@@ -555,8 +561,8 @@ optional_collation:
             goto err_expect_identifier;
     }
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        grouping_column_reference_t& gcr = group_by_columns.back();
-        gcr.collation = cur_tok.lexeme;
+        if (! ctx.opts.disable_statement_construction)
+            group_by_columns.back().collation = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
     }
     cur_sym = cur_tok.symbol;
@@ -5,8 +5,6 @@
  */
 
 #include <iostream>
-#include <cctype>
-#include <sstream>
 
 #include "parser/error.h"
 #include "parser/sequence.h"
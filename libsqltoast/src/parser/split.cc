@@ -0,0 +1,242 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/arena.h"
+#include "parser/char_class.h"
+#include "parser/context.h"
+#include "parser/parse.h"
+#include "parser/split.h"
+
+namespace sqltoast {
+
+namespace {
+
+// The runs of statements handed out to each thread by parse_parallel(). More
+// runs than threads keeps the threads busy when some statements take much
+// longer to parse than others.
+const size_t RUNS_PER_THREAD = 4;
+
+void add_statement(
+        parse_position_t subject,
+        parse_position_t first,
+        parse_position_t end,
+        std::vector<lexeme_t>& out) {
+    while (end > first && is_space(end[-1]))
+        end--;
+    out.emplace_back(uint32_t(first - subject), uint32_t(end - first));
+}
+
+// The statements [begin, end) of the input, parsed on their own into result
+typedef struct statement_run {
+    size_t begin;
+    size_t end;
+    parse_result_t result;
+} statement_run_t;
+
+typedef struct parallel_parse {
+    parse_position_t subject;
+    parse_position_t subject_end;
+    parse_options_t& opts;
+    const std::vector<lexeme_t>& statements;
+    std::vector<statement_run_t>& runs;
+    std::atomic<size_t> next_run;
+    parallel_parse(
+            parse_position_t subject,
+            size_t len,
+            parse_options_t& opts,
+            const std::vector<lexeme_t>& statements,
+            std::vector<statement_run_t>& runs) :
+        subject(subject),
+        subject_end(subject + len),
+        opts(opts),
+        statements(statements),
+        runs(runs),
+        next_run(0)
+    {}
+    // Each run is parsed from the start of its first statement up to the
+    // start of the next run's first statement, so the parser sees the same
+    // terminating semicolon and comments as it would parsing the whole input
+    void parse_run(statement_run_t& run) {
+        parse_position_t from = subject + statements[run.begin].offset;
+        parse_position_t to = subject_end;
+        if (run.end < statements.size())
+            to = subject + statements[run.end].offset;
+        parse_result_t& res = run.result;
+        if (opts.use_arena)
+            res.arena.reset(new arena_t);
+        arena_scope_t scope(res.arena.get());
+        parse_context_t ctx(res, opts, subject, from, to);
+        parse_statements(ctx);
+    }
+    void run() {
+        size_t x;
+        while ((x = next_run.fetch_add(1)) < runs.size()) {
+            // Once a run has failed, the parse result ends with it, so later
+            // runs needn't be parsed at all
+            parse_run(runs[x]);
+            if (runs[x].result.code != PARSE_OK) {
+                next_run.store(runs.size());
+                return;
+            }
+        }
+    }
+} parallel_parse_t;
+
+} // namespace <anonymous>
+
+// Only the bytes that can start a literal, delimited identifier or comment,
+// or end a statement or the input, are looked at one at a time. scan_text()
+// skips everything else in blocks of 16 or 32 bytes.
+size_t split_statements(
+        const char* subject,
+        size_t len,
+        std::vector<lexeme_t>& out) {
+    if (len >= LEXEME_NONE)
+        return 0;
+    // Moved back to the first NUL byte outside a literal, delimited
+    // identifier or bracketed comment, which the lexer takes as the end of
+    // the input
+    parse_position_t end = subject + len;
+    parse_position_t cursor = subject;
+    // The start of the current statement, or nullptr if nothing but
+    // whitespace, simple comments and semicolons has been seen since the
+    // last one ended
+    parse_position_t first = nullptr;
+    size_t num_found = 0;
+    while (cursor < end) {
+        if (first == nullptr) {
+            cursor = scan_space(cursor, end);
+            if (cursor == end || *cursor == '\0')
+                break;
+            if (*cursor == ';') {
+                cursor++;
+                continue;
+            }
+            if (*cursor == '-' && cursor + 1 < end && cursor[1] == '-') {
+                cursor = skip_simple_comment(cursor, end);
+                continue;
+            }
+            first = cursor;
+        }
+        cursor = scan_text(cursor, end);
+        if (cursor == end)
+            break;
+        switch (*cursor) {
+            case ';':
+                add_statement(subject, first, cursor, out);
+                num_found++;
+                first = nullptr;
+                cursor++;
+                break;
+            case '\'':
+            case '"':
+            case '`':
+                cursor = skip_quoted(cursor, end);
+                break;
+            case '-':
+                if (cursor + 1 < end && cursor[1] == '-')
+                    cursor = skip_simple_comment(cursor, end);
+                else
+                    cursor++;
+                break;
+            case '/':
+                if (cursor + 1 < end && cursor[1] == '*')
+                    cursor = skip_bracketed_comment(cursor, end);
+                else
+                    cursor++;
+                break;
+            case '\0':
+                end = cursor;
+                break;
+        }
+    }
+    // The final statement doesn't need a terminating semicolon
+    if (first != nullptr) {
+        add_statement(subject, first, end, out);
+        num_found++;
+    }
+    return num_found;
+}
+
+parse_result_t parse_parallel(
+        const char* subject,
+        size_t len,
+        parse_options_t& opts,
+        size_t num_threads) {
+    std::vector<lexeme_t> statements;
+    split_statements(subject, len, statements);
+    // A flat AST's node indexes can't simply be concatenated, and anything
+    // with fewer than two statements has nothing to parse in parallel.
+    // Inputs with no statements at all get sqltoast::parse()'s error.
+    if (opts.flat || statements.size() < 2)
+        return parse(subject, len, opts);
+
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min(num_threads, statements.size());
+
+    // Split the statements into runs of roughly equal numbers of bytes
+    size_t num_runs = std::min(num_threads * RUNS_PER_THREAD, statements.size());
+    std::vector<statement_run_t> runs(num_runs);
+    size_t stmt = 0;
+    for (size_t x = 0; x < num_runs; x++) {
+        runs[x].begin = stmt;
+        size_t target = (len * (x + 1)) / num_runs;
+        // Leave at least one statement for each of the remaining runs
+        size_t last = statements.size() - (num_runs - x);
+        stmt++;
+        while (stmt <= last && statements[stmt].offset < target)
+            stmt++;
+        if (x == num_runs - 1)
+            stmt = statements.size();
+        runs[x].end = stmt;
+    }
+
+    parallel_parse_t pp(subject, len, opts, statements, runs);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t x = 1; x < num_threads; x++)
+        threads.emplace_back(&parallel_parse_t::run, &pp);
+    // The calling thread is the first worker
+    pp.run();
+    for (std::thread& t : threads)
+        t.join();
+
+    parse_result_t res;
+    res.input = subject;
+    if (opts.use_arena)
+        res.arena.reset(new arena_t);
+    for (statement_run_t& run : runs) {
+        parse_result_t& run_res = run.result;
+        // A run that was never parsed follows one that failed
+        if (run_res.input == nullptr)
+            break;
+        std::move(run_res.statements.begin(), run_res.statements.end(),
+                  std::back_inserter(res.statements));
+        run_res.statements.clear();
+        if (run_res.arena)
+            res.arena->adopt(*run_res.arena);
+        res.memo_hits += run_res.memo_hits;
+        res.memo_misses += run_res.memo_misses;
+        if (run_res.code != PARSE_OK) {
+            res.code = run_res.code;
+            res.error = run_res.error;
+            // Context shown around the error may run on past the run
+            res.error.input_end = subject + len;
+            break;
+        }
+    }
+    return res;
+}
+
+} // namespace sqltoast
@@ -0,0 +1,68 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_SPLIT_H
+#define SQLTOAST_PARSER_SPLIT_H
+
+#include <cstring>
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+// Helpers for finding the ends of the parts of SQL that can hide a
+// semicolon, for the passes that split input into statements without
+// tokenizing it. They mirror how the tokenizers find the ends of string
+// literals, delimited identifiers and comments, and each returns end if the
+// input runs out first.
+
+// Returns the position following the literal or delimited identifier whose
+// opening quote is at the supplied position
+inline parse_position_t skip_quoted(
+        parse_position_t cur,
+        const parse_position_t end) {
+    const char closer = *cur;
+    while (true) {
+        cur = static_cast<parse_position_t>(
+                std::memchr(cur + 1, closer, end - cur - 1));
+        if (cur == nullptr)
+            return end;
+        // A backslash-escaped quote doesn't end a literal
+        if (closer != '\'' || cur[-1] != '\\')
+            return cur + 1;
+    }
+}
+
+// Returns the position of the newline, or the NUL byte ending the input,
+// that ends the simple comment starting at the supplied position
+inline parse_position_t skip_simple_comment(
+        parse_position_t cur,
+        const parse_position_t end) {
+    parse_position_t nl = static_cast<parse_position_t>(
+            std::memchr(cur, '\n', end - cur));
+    if (nl == nullptr)
+        nl = end;
+    cur = static_cast<parse_position_t>(std::memchr(cur, '\0', nl - cur));
+    return (cur == nullptr ? nl : cur);
+}
+
+// Returns the position following the bracketed comment starting at the
+// supplied position
+inline parse_position_t skip_bracketed_comment(
+        parse_position_t cur,
+        const parse_position_t end) {
+    cur += 2;
+    while (cur < end - 1) {
+        if (cur[0] == '*' && cur[1] == '/')
+            return cur + 2;
+        cur++;
+    }
+    return end;
+}
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_SPLIT_H */
@@ -5,8 +5,6 @@
  */
 
 #include <iostream>
-#include <cctype>
-#include <sstream>
 
 #include "parser/error.h"
 #include "parser/parse.h"
@@ -106,9 +104,7 @@ void parse_statement(parse_context_t& ctx) {
             break;
         default:
         {
-            std::stringstream estr;
-            estr << "Failed to recognize any valid SQL statement." << std::endl;
-            create_syntax_error_marker(ctx, estr);
+            syntax_error(ctx, "Failed to recognize any valid SQL statement.");
             return;
         }
     }
@@ -122,13 +118,17 @@ void parse_statement(parse_context_t& ctx) {
         // Already have a nicely-formatted error, so just return
         return;
     } else {
-        std::stringstream estr;
-        estr << "Failed to recognize any valid SQL statement." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        syntax_error(ctx, "Failed to recognize any valid SQL statement.");
+        return;
     }
 push_statement:
     if (ctx.opts.disable_statement_construction)
         return;
+    if (ctx.opts.flat) {
+        // The tree is only needed long enough to copy it into the flat AST
+        flatten(*stmt_p, ctx.lexer.start, ctx.result.flat);
+        return;
+    }
     ctx.result.statements.emplace_back(std::move(stmt_p));
 }
 
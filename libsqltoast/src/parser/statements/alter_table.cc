@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/parse.h"
@@ -73,7 +71,7 @@ bool parse_alter_table(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_action;
 err_expect_identifier:
@@ -115,43 +113,29 @@ process_add_actions:
             goto err_expect_add_column_or_constraint;
     }
 err_expect_add_column_or_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected either an add column action or an add "
-                "constraint action but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected either an add column action or an add "
+                      "constraint action but found %t");
+    return false;
 process_add_column:
-    if (ctx.opts.disable_statement_construction)
-        goto statement_ending;
     if (! parse_column_definition(ctx, cur_tok, column_def))
         goto err_expect_column_definition;
+    if (ctx.opts.disable_statement_construction)
+        goto statement_ending;
     action = std::make_unique<add_column_action_t>(column_def);
     goto statement_ending;
 err_expect_column_definition:
-    {
-        std::stringstream estr;
-        estr << "Expected <column definition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <column definition> but found %t");
+    return false;
 process_add_constraint:
-    if (ctx.opts.disable_statement_construction)
-        goto statement_ending;
     if (! parse_constraint(ctx, cur_tok, constraint))
         goto err_expect_constraint;
+    if (ctx.opts.disable_statement_construction)
+        goto statement_ending;
     action = std::make_unique<add_constraint_action_t>(constraint);
     goto statement_ending;
 err_expect_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected <constraint definition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <constraint definition> but found %t");
+    return false;
 process_drop_actions:
     cur_sym = cur_tok.symbol;
     switch (cur_sym) {
@@ -167,13 +151,9 @@ process_drop_actions:
             goto err_expect_drop_column_or_constraint;
     }
 err_expect_drop_column_or_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected either a drop column action or a drop "
-                "constraint action but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected either a drop column action or a drop "
+                      "constraint action but found %t");
+    return false;
 process_drop_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COLUMN)
@@ -181,7 +161,7 @@ process_drop_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    column_name = cur_tok.lexeme;
+    column_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_CASCADE || cur_sym == SYMBOL_RESTRICT) {
@@ -198,7 +178,7 @@ process_drop_constraint:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    constraint_name = cur_tok.lexeme;
+    constraint_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_CASCADE || cur_sym == SYMBOL_RESTRICT) {
@@ -218,7 +198,7 @@ process_alter_action:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    column_name = cur_tok.lexeme;
+    column_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_SET) {
@@ -248,12 +228,8 @@ err_expect_default:
     expect_error(ctx, SYMBOL_DEFAULT);
     return false;
 err_expect_default_clause:
-    {
-        std::stringstream estr;
-        estr << "Expected <default clause> but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <default clause> but found %t");
+    return false;
 process_alter_column_drop_default_action:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_DEFAULT)
@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -73,7 +71,7 @@ identifier_or_authorization_clause:
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        schema_name = cur_tok.lexeme;
+        schema_name = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto authz_or_statement_ending;
     }
@@ -87,7 +85,7 @@ default_charset_clause:
     };
     if (! expect_sequence(ctx, exp_sym_seq, 3))
         return false;
-    default_charset = cur_tok.lexeme;
+    default_charset = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto statement_ending;
 }
@@ -96,7 +94,7 @@ authorization_clause:
     // AUTHORIZATION clause
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        authz_ident = cur_tok.lexeme;
+        authz_ident = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto default_charset_or_statement_ending;
     }
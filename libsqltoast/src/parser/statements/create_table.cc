@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/parse.h"
@@ -101,7 +99,7 @@ expect_table_name:
     // need to find an identifier
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        table_name = cur_tok.lexeme;
+        table_name = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto expect_table_list_open;
     }
@@ -127,7 +125,8 @@ expect_table_list_element:
     // list> clause. Now we expect to find one or more column or constraint
     // definitions
     if (parse_column_definition(ctx, cur_tok, column_def)) {
-        column_defs.emplace_back(std::move(column_def));
+        if (! ctx.opts.disable_statement_construction)
+            column_defs.emplace_back(std::move(column_def));
         goto expect_table_list_close;
     }
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
@@ -139,10 +138,8 @@ err_expect_column_def_or_constraint:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     else {
-        std::stringstream estr;
-        estr << "Expected either a column definition or a "
-                "constraint but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        syntax_error(ctx, "Expected either a column definition or a "
+                          "constraint but found %t");
         return false;
     }
 expect_table_list_close:
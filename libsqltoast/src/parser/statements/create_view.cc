@@ -39,7 +39,7 @@ bool parse_create_view(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto optional_column_list;
 err_expect_identifier:
@@ -56,7 +56,8 @@ process_column_list_element:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    columns.emplace_back(lexeme_t(cur_tok.lexeme));
+    if (! ctx.opts.disable_statement_construction)
+        columns.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -122,13 +123,8 @@ err_expect_option:
     expect_error(ctx, SYMBOL_OPTION);
     return false;
 err_expect_query_expression:
-    {
-        std::stringstream estr;
-        estr << "Expected to find <query expression> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find <query expression> but found %t");
+    return false;
 statement_ending:
     // We get here after successfully parsing the statement and now expect
     // either the end of parse content or a semicolon to indicate end of
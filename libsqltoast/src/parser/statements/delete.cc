@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -52,7 +50,7 @@ expect_identifier:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto opt_search_condition;
 err_expect_identifier:
@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -47,7 +45,7 @@ expect_identifier:
     // now need to find the schema identifier
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        schema_name = cur_tok.lexeme;
+        schema_name = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto drop_behaviour_or_statement_ending;
     }
@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -42,7 +40,7 @@ bool parse_drop_table(
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        table_name = cur_tok.lexeme;
+        table_name = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto drop_behaviour_or_statement_ending;
     }
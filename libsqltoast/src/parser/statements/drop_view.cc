@@ -32,7 +32,7 @@ bool parse_drop_view(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto drop_behaviour_or_statement_ending;
 err_expect_identifier:
@@ -42,15 +42,18 @@ process_privilege:
     switch (cur_sym) {
         case SYMBOL_SELECT:
             cur_tok = lex.next();
-            privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_SELECT));
+            if (! ctx.opts.disable_statement_construction)
+                privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_SELECT));
             break;
         case SYMBOL_DELETE:
             cur_tok = lex.next();
-            privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_DELETE));
+            if (! ctx.opts.disable_statement_construction)
+                privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_DELETE));
             break;
         case SYMBOL_USAGE:
             cur_tok = lex.next();
-            privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_USAGE));
+            if (! ctx.opts.disable_statement_construction)
+                privileges.emplace_back(std::make_unique<grant_action_t>(GRANT_ACTION_TYPE_USAGE));
             break;
         case SYMBOL_INSERT:
         case SYMBOL_UPDATE:
@@ -93,14 +96,16 @@ process_columnar_action:
         cur_tok = lex.next();
         goto process_privilege;
     }
-    privileges.emplace_back(
-        std::make_unique<column_list_grant_action_t>(action_type, columns));
+    if (! ctx.opts.disable_statement_construction)
+        privileges.emplace_back(
+            std::make_unique<column_list_grant_action_t>(action_type, columns));
     goto expect_on;
 process_column_list_element:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    columns.emplace_back(lexeme_t(cur_tok.lexeme));
+    if (! ctx.opts.disable_statement_construction)
+        columns.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -113,8 +118,9 @@ expect_rparen:
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
     cur_tok = lex.next();
-    privileges.emplace_back(
-        std::make_unique<column_list_grant_action_t>(action_type, columns));
+    if (! ctx.opts.disable_statement_construction)
+        privileges.emplace_back(
+            std::make_unique<column_list_grant_action_t>(action_type, columns));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -159,7 +165,7 @@ expect_on:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    on = cur_tok.lexeme;
+    on = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_to;
 err_expect_set:
@@ -182,7 +188,7 @@ expect_to:
     if (cur_sym != SYMBOL_IDENTIFIER && cur_sym != SYMBOL_PUBLIC)
         goto err_expect_identifier_or_public;
     if (cur_sym != SYMBOL_PUBLIC)
-        to = cur_tok.lexeme;
+        to = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto optional_with_clause;
 err_expect_to:
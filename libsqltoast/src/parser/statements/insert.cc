@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -55,7 +53,7 @@ expect_identifier:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto opt_col_list_or_default_values;
 err_expect_identifier:
@@ -86,7 +84,8 @@ process_column_list_item:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    col_list.emplace_back(cur_tok.lexeme);
+    if (! ctx.opts.disable_statement_construction)
+        col_list.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -105,12 +104,8 @@ expect_query_expression:
         goto err_expect_query_expression;
     goto statement_ending;
 err_expect_query_expression:
-    {
-        std::stringstream estr;
-        estr << "Expected a value item, but got " << cur_tok << "." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected a value item, but got %t.");
+    return false;
 statement_ending:
     // We get here after successfully parsing the statement and now expect
     // either the end of parse content or a semicolon to indicate end of
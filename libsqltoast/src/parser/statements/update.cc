@@ -4,8 +4,6 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
-
 #include "sqltoast/sqltoast.h"
 
 #include "parser/error.h"
@@ -49,7 +47,7 @@ expect_identifier:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    table_name = cur_tok.lexeme;
+    table_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_set;
 err_expect_identifier:
@@ -72,7 +70,7 @@ process_set_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    column_name = cur_tok.lexeme;
+    column_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_EQUAL)
@@ -81,14 +79,17 @@ process_set_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_NULL) {
         cur_tok = lex.next();
-        set_columns.emplace_back(set_column_t(SET_COLUMN_TYPE_NULL, column_name));
+        if (! ctx.opts.disable_statement_construction)
+            set_columns.emplace_back(set_column_t(SET_COLUMN_TYPE_NULL, column_name));
     } else if (cur_sym == SYMBOL_DEFAULT) {
         cur_tok = lex.next();
-        set_columns.emplace_back(set_column_t(SET_COLUMN_TYPE_DEFAULT, column_name));
+        if (! ctx.opts.disable_statement_construction)
+            set_columns.emplace_back(set_column_t(SET_COLUMN_TYPE_DEFAULT, column_name));
     } else {
         if (! parse_value_expression(ctx, cur_tok, value))
             goto err_expect_value_null_or_default;
-        set_columns.emplace_back(set_column_t(column_name, value));
+        if (! ctx.opts.disable_statement_construction)
+            set_columns.emplace_back(set_column_t(column_name, value));
     }
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -102,13 +103,9 @@ err_expect_equal:
 err_expect_value_null_or_default:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
-    {
-        std::stringstream estr;
-        estr << "Expected to find NULL, DEFAULT or a << value expression >> for "
-                "WHERE clause." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected to find NULL, DEFAULT or a "
+                      "<< value expression >> for WHERE clause.");
+    return false;
 optional_where:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_WHERE) {
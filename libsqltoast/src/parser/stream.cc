@@ -0,0 +1,177 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/char_class.h"
+
+namespace sqltoast {
+
+statement_stream::statement_stream(parse_options_t& opts) :
+    opts(opts),
+    stmt_start(0),
+    scan_pos(0),
+    discarded(0),
+    last_offset(0),
+    state(SCAN_NORMAL),
+    prev('\0'),
+    significant(false),
+    finished(false)
+{}
+
+void statement_stream::feed(const char* chunk, size_t len) {
+    // Statements that have already been returned from next() are no longer
+    // needed, so drop them before appending the new chunk
+    if (stmt_start > 0) {
+        buffer.erase(buffer.begin(), buffer.begin() + stmt_start);
+        scan_pos -= stmt_start;
+        discarded += stmt_start;
+        stmt_start = 0;
+    }
+    buffer.insert(buffer.end(), chunk, chunk + len);
+}
+
+void statement_stream::finish() {
+    finished = true;
+}
+
+void statement_stream::parse_statement(parse_result_t& res, size_t end) {
+    last_offset = discarded + stmt_start;
+    res = parse(buffer.data() + stmt_start, end - stmt_start, opts);
+    stmt_start = end;
+    significant = false;
+}
+
+// Scanning only needs to track enough of the lexical structure of SQL to know
+// whether a semicolon is a statement terminator, so it mirrors how the
+// tokenizers find the ends of string literals, delimited identifiers and
+// comments. The scan position and state are kept between calls, so every
+// byte of input is scanned exactly once no matter how it is chunked.
+stream_status_t statement_stream::next(parse_result_t& res) {
+    const size_t size = buffer.size();
+    while (scan_pos < size) {
+        const char c = buffer[scan_pos];
+        switch (state) {
+            case SCAN_NORMAL:
+                switch (c) {
+                    case ';':
+                        scan_pos++;
+                        if (! significant) {
+                            // Nothing but whitespace, simple comments and
+                            // semicolons so far, so there's no statement
+                            // to parse
+                            stmt_start = scan_pos;
+                            continue;
+                        }
+                        parse_statement(res, scan_pos);
+                        return STREAM_STATEMENT;
+                    case '\'':
+                        state = SCAN_SINGLE_QUOTE;
+                        significant = true;
+                        break;
+                    case '"':
+                        state = SCAN_DOUBLE_QUOTE;
+                        significant = true;
+                        break;
+                    case '`':
+                        state = SCAN_BACKTICK;
+                        significant = true;
+                        break;
+                    case '-':
+                    case '/':
+                        // Could be the start of a comment, which we can only
+                        // tell from the following character
+                        if (scan_pos + 1 == size) {
+                            if (! finished)
+                                return STREAM_NEED_INPUT;
+                            significant = true;
+                            break;
+                        }
+                        if (c == '-' && buffer[scan_pos + 1] == '-') {
+                            state = SCAN_SIMPLE_COMMENT;
+                            scan_pos += 2;
+                            continue;
+                        }
+                        // Bracketed comments are tokens as far as the parser
+                        // is concerned, so they make a statement significant
+                        significant = true;
+                        if (c == '/' && buffer[scan_pos + 1] == '*') {
+                            state = SCAN_BRACKETED_COMMENT;
+                            prev = '\0';
+                            scan_pos += 2;
+                            continue;
+                        }
+                        break;
+                    default:
+                        if (! is_space(c))
+                            significant = true;
+                        break;
+                }
+                break;
+            case SCAN_SINGLE_QUOTE:
+                // A backslash-escaped quote doesn't end the literal
+                if (c == '\'' && prev != '\\')
+                    state = SCAN_NORMAL;
+                break;
+            case SCAN_DOUBLE_QUOTE:
+                if (c == '"')
+                    state = SCAN_NORMAL;
+                break;
+            case SCAN_BACKTICK:
+                if (c == '`')
+                    state = SCAN_NORMAL;
+                break;
+            case SCAN_SIMPLE_COMMENT:
+                if (c == '\n')
+                    state = SCAN_NORMAL;
+                break;
+            case SCAN_BRACKETED_COMMENT:
+                if (c == '/' && prev == '*')
+                    state = SCAN_NORMAL;
+                break;
+        }
+        prev = c;
+        scan_pos++;
+    }
+    if (! finished)
+        return STREAM_NEED_INPUT;
+    if (significant) {
+        // The final statement doesn't need a terminating semicolon
+        parse_statement(res, size);
+        return STREAM_STATEMENT;
+    }
+    stmt_start = size;
+    return STREAM_END;
+}
+
+size_t parse_stream(
+        std::istream& in,
+        parse_options_t& opts,
+        const statement_handler_t& handler,
+        size_t chunk_size) {
+    statement_stream_t stream(opts);
+    std::vector<char> chunk(chunk_size);
+    parse_result_t res;
+    size_t num_statements = 0;
+    while (true) {
+        in.read(chunk.data(), chunk.size());
+        size_t len = in.gcount();
+        if (len > 0)
+            stream.feed(chunk.data(), len);
+        if (! in)
+            stream.finish();
+        stream_status_t status;
+        while ((status = stream.next(res)) == STREAM_STATEMENT) {
+            num_statements++;
+            if (! handler(res))
+                return num_statements;
+        }
+        if (status == STREAM_END)
+            return num_statements;
+    }
+}
+
+} // namespace sqltoast
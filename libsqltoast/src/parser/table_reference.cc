@@ -47,7 +47,7 @@ namespace sqltoast {
 //     USING <left paren> <join column list> <right paren>
 //
 // <join column list> ::= <column name list>
-bool parse_table_reference(
+static bool parse_table_reference_rule(
         parse_context_t& ctx,
         token_t& cur_tok,
         std::unique_ptr<table_reference_t>& out) {
@@ -63,7 +63,7 @@ bool parse_table_reference(
     // Used for the USING clause
     std::vector<lexeme_t> named_columns;
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        table_name = cur_tok.lexeme;
+        table_name = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto optional_alias;
     }
@@ -83,7 +83,7 @@ optional_alias:
             goto err_expect_identifier;
     }
     if (cur_sym == SYMBOL_IDENTIFIER) {
-        alias = cur_tok.lexeme;
+        alias = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
     }
     goto ensure_normal_table;
@@ -151,13 +151,8 @@ err_expect_join:
     expect_error(ctx, SYMBOL_JOIN);
     return false;
 err_expect_table_reference:
-    {
-        std::stringstream estr;
-        estr << "Expected <table reference> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <table reference> but found %t");
+    return false;
 optional_join_specification:
     // We get here after successfully parsing an INNER or OUTER symbol followed
     // by a JOIN symbol. We now must check for the optional <join
@@ -182,13 +177,8 @@ process_join_condition:
         goto err_expect_join_condition;
     goto push_join;
 err_expect_join_condition:
-    {
-        std::stringstream estr;
-        estr << "Expected <join condition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <join condition> but found %t");
+    return false;
 process_named_columns:
     // We get here after parsing a USING symbol, which must be followed by a
     // parens-enclosed list of column identifiers
@@ -201,7 +191,8 @@ process_named_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    named_columns.emplace_back(cur_tok.lexeme);
+    if (! ctx.opts.disable_statement_construction)
+        named_columns.emplace_back(ctx.lexeme(cur_tok));
     cur_tok = lex.next();
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -233,7 +224,7 @@ optional_outer:
     goto optional_join_specification;
 ensure_normal_table:
     if (ctx.opts.disable_statement_construction)
-        return true;
+        goto check_join;
     out = std::make_unique<table_t>(table_name, alias);
     goto check_join;
 push_join:
@@ -254,6 +245,20 @@ push_join:
     return true;
 }
 
+// Attempts the rule above, or replays an earlier attempt at the same position
+// when parsing with parse_options_t::memoize set
+bool parse_table_reference(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::unique_ptr<table_reference_t>& out) {
+    return memoized(
+            ctx,
+            MEMO_RULE_TABLE_REFERENCE,
+            cur_tok,
+            out,
+            &parse_table_reference_rule);
+}
+
 // <derived table> ::= <table subquery>
 //
 // <table subquery> ::= <subquery>
@@ -287,7 +292,7 @@ bool parse_derived_table(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    alias = cur_tok.lexeme;
+    alias = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto push_derived_table;
 err_expect_rparen:
@@ -297,13 +302,8 @@ err_expect_identifier:
     expect_error(ctx, SYMBOL_IDENTIFIER);
     return false;
 err_expect_query_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <query expression> but found "
-         << cur_tok << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    syntax_error(ctx, "Expected <query expression> but found %t");
     return false;
-}
 push_derived_table:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -34,6 +34,15 @@ std::ostream& operator<< (std::ostream& out, const token_t& token) {
         }
         return out;
     }
+    if (token.symbol == SYMBOL_ERROR) {
+        size_t tok_len = token.lexeme.size();
+        if (tok_len < 20) {
+            out << "error[" << std::string(token.lexeme.start, token.lexeme.end) << "]";
+        } else {
+            out << "error[length: " << tok_len << "]";
+        }
+        return out;
+    }
     if (token.symbol == SYMBOL_COMMENT) {
         out << "comment[length: " << token.lexeme.size() << "]";
         return out;
@@ -13,9 +13,28 @@
 
 namespace sqltoast {
 
+// Where in the input a token was found. While scanning, the lexer and parser
+// want to get at the input directly, so unlike the lexeme_t stored in AST
+// nodes this points into the input. parse_context_t::lexeme() makes the
+// lexeme_t for a token.
+typedef struct token_lexeme {
+    parse_position_t start;
+    parse_position_t end;
+    token_lexeme() : start(nullptr), end(nullptr)
+    {}
+    token_lexeme(
+        parse_position_t start,
+        parse_position_t end) :
+        start(start), end(end)
+    {}
+    inline size_t size() const {
+        return end - start;
+    }
+} token_lexeme_t;
+
 typedef struct token {
     symbol_t symbol;
-    lexeme_t lexeme;
+    token_lexeme_t lexeme;
     token() :
         symbol(SYMBOL_NONE),
         lexeme()
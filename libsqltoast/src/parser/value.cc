@@ -68,13 +68,9 @@ optional_operator:
     }
     return true;
 err_expect_numeric_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric factor> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <numeric factor> after finding numeric "
+                      "operator but found %t");
+    return false;
 ensure_term:
     if (ctx.opts.disable_statement_construction)
         goto optional_operator;
@@ -97,8 +93,10 @@ bool parse_numeric_factor(
     std::unique_ptr<numeric_primary_t> primary;
     std::unique_ptr<value_expression_primary_t> value;
 
-    // Parse the optional sign...
-    if (cur_sym == SYMBOL_PLUS || cur_sym == SYMBOL_MINUS) {
+    // Parse the optional sign, unless what looks like one is the operator
+    // following an already-parsed primary...
+    if ((cur_sym == SYMBOL_PLUS || cur_sym == SYMBOL_MINUS) &&
+            ! ctx.has_parsed_primary(cur_tok)) {
         if (cur_sym == SYMBOL_PLUS)
             sign = 1;
         else
@@ -142,13 +140,20 @@ bool parse_value_expression_primary(
     lexeme_t vep_lexeme;
     vep_type_t vep_type;
     symbol_t cur_sym = cur_tok.symbol;
+    if (ctx.has_parsed_primary(cur_tok)) {
+        // parse_value_expression() already parsed this primary, and the
+        // lexer is sitting on the token following it
+        ctx.parsed_primary.present = false;
+        out = std::move(ctx.parsed_primary.value);
+        return true;
+    }
     if (parse_unsigned_value_specification(ctx, cur_tok, out))
         return true;
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     if (cur_tok.is_identifier()) {
         vep_type = VEP_TYPE_COLUMN_REFERENCE;
-        vep_lexeme = cur_tok.lexeme;
+        vep_lexeme = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto push_ve;
     }
@@ -190,8 +195,7 @@ process_subquery:
     if (! parse_query_expression(ctx, cur_tok, subq))
         return false;
     parse_position_t subq_end = cur_tok.lexeme.start - 1;
-    vep_lexeme.start = subq_start;
-    vep_lexeme.end = subq_end;
+    vep_lexeme = ctx.lexeme(subq_start, subq_end);
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
@@ -208,8 +212,7 @@ process_parenthesized_value_expression:
     if (! parse_value_expression(ctx, cur_tok, inner_value))
         return false;
     parse_position_t inner_val_end = cur_tok.lexeme.start - 1;
-    vep_lexeme.start = inner_val_start;
-    vep_lexeme.end = inner_val_end;
+    vep_lexeme = ctx.lexeme(inner_val_start, inner_val_end);
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         return false; // Could be a row value constructor list
@@ -261,53 +264,74 @@ bool parse_unsigned_value_specification(
     lexer_t& lex = ctx.lexer;
     lexeme_t uvs_lexeme;
     uvs_type_t uvs_type;
+    parse_position_t typed_start = nullptr;
     symbol_t cur_sym = cur_tok.symbol;
     if (cur_tok.is_literal()) {
-        uvs_type = UVS_TYPE_UNSIGNED_NUMERIC;
-        uvs_lexeme = cur_tok.lexeme;
+        switch (cur_sym) {
+            case SYMBOL_LITERAL_CHARACTER_STRING:
+                uvs_type = UVS_TYPE_CHARACTER_STRING;
+                break;
+            case SYMBOL_LITERAL_NATIONAL_CHARACTER_STRING:
+                uvs_type = UVS_TYPE_NATIONAL_CHARACTER_STRING;
+                break;
+            case SYMBOL_LITERAL_BIT_STRING:
+                uvs_type = UVS_TYPE_BIT_STRING;
+                break;
+            case SYMBOL_LITERAL_HEX_STRING:
+                uvs_type = UVS_TYPE_HEX_STRING;
+                break;
+            default:
+                uvs_type = UVS_TYPE_UNSIGNED_NUMERIC;
+                break;
+        }
+        uvs_lexeme = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
         goto push_spec;
     }
     switch (cur_sym) {
         case SYMBOL_DATE:
             uvs_type = UVS_TYPE_DATETIME;
+            typed_start = cur_tok.lexeme.start;
             cur_tok = lex.next();
             goto expect_char_string;
         case SYMBOL_TIME:
             uvs_type = UVS_TYPE_DATETIME;
+            typed_start = cur_tok.lexeme.start;
             cur_tok = lex.next();
             goto expect_char_string;
         case SYMBOL_TIMESTAMP:
             uvs_type = UVS_TYPE_DATETIME;
+            typed_start = cur_tok.lexeme.start;
             cur_tok = lex.next();
             goto expect_char_string;
         case SYMBOL_INTERVAL:
             uvs_type = UVS_TYPE_INTERVAL;
+            typed_start = cur_tok.lexeme.start;
             cur_tok = lex.next();
             goto expect_char_string;
         case SYMBOL_USER:
             uvs_type = UVS_TYPE_USER;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         case SYMBOL_CURRENT_USER:
             uvs_type = UVS_TYPE_CURRENT_USER;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         case SYMBOL_SESSION_USER:
             uvs_type = UVS_TYPE_SESSION_USER;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         case SYMBOL_SYSTEM_USER:
             uvs_type = UVS_TYPE_SYSTEM_USER;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         case SYMBOL_VALUE:
             uvs_type = UVS_TYPE_VALUE;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         case SYMBOL_COLON:
@@ -315,7 +339,7 @@ bool parse_unsigned_value_specification(
             goto expect_parameter;
         case SYMBOL_QUESTION_MARK:
             uvs_type = UVS_TYPE_PARAMETER;
-            uvs_lexeme = cur_tok.lexeme;
+            uvs_lexeme = ctx.lexeme(cur_tok);
             cur_tok = lex.next();
             goto push_spec;
         default:
@@ -327,7 +351,9 @@ expect_char_string:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_LITERAL_CHARACTER_STRING)
         goto err_expect_char_string;
-    uvs_lexeme = cur_tok.lexeme;
+    // The lexeme includes the keyword, since the string alone doesn't say
+    // whether it's a DATE, TIME or TIMESTAMP
+    uvs_lexeme = ctx.lexeme(typed_start, cur_tok.lexeme.end);
     cur_tok = lex.next();
     goto push_spec;
 err_expect_char_string:
@@ -340,7 +366,7 @@ expect_parameter:
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
     uvs_type = UVS_TYPE_PARAMETER;
-    uvs_lexeme = cur_tok.lexeme;
+    uvs_lexeme = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     // TODO(jaypipes): Maybe support the INDICATOR clause?
     goto push_spec;
@@ -424,6 +450,7 @@ process_count_asterisk:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
         goto err_expect_rparen;
+    sf_end = lex.cursor;
     cur_tok = lex.next();
     star = true;
     goto push_set_function;
@@ -464,7 +491,7 @@ push_set_function:
     if (ctx.opts.disable_statement_construction)
         return true;
     out = std::make_unique<set_function_t>(
-            func_type, lexeme_t(sf_start, sf_end), star, distinct, operand);
+            func_type, ctx.lexeme(sf_start, sf_end), star, distinct, operand);
     return true;
 }
 
@@ -516,7 +543,8 @@ err_expect_lparen:
 process_coalesce_argument:
     if (! parse_value_expression(ctx, cur_tok, value))
         goto err_expect_value_expression;
-    values.emplace_back(std::move(value));
+    if (! ctx.opts.disable_statement_construction)
+        values.emplace_back(std::move(value));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -528,13 +556,8 @@ process_coalesce_argument:
     cur_tok = lex.next();
     goto push_coalesce;
 err_expect_value_expression:
-    {
-        std::stringstream estr;
-        estr << "expected <value expression> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "expected <value expression> but found %t");
+    return false;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
     return false;
@@ -573,13 +596,13 @@ push_coalesce:
     if (ctx.opts.disable_statement_construction)
         return true;
     out = std::make_unique<coalesce_function_t>(
-            lexeme_t(case_start, case_end), values);
+            ctx.lexeme(case_start, case_end), values);
     return true;
 push_nullif:
     if (ctx.opts.disable_statement_construction)
         return true;
     out = std::make_unique<nullif_function_t>(
-            lexeme_t(case_start, case_end), left, right);
+            ctx.lexeme(case_start, case_end), left, right);
     return true;
 }
 
@@ -632,9 +655,10 @@ process_simple_when:
     cur_tok = lex.next();
     if (! parse_value_expression(ctx, cur_tok, when_result))
         return false;
-    when_clauses.emplace_back(
-            simple_case_expression_when_clause_t(
-                    when_operand, when_result));
+    if (! ctx.opts.disable_statement_construction)
+        when_clauses.emplace_back(
+                simple_case_expression_when_clause_t(
+                        when_operand, when_result));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_WHEN) {
         cur_tok = lex.next();
@@ -670,10 +694,10 @@ push_simple_case:
         return true;
     if (else_value)
         out = std::make_unique<simple_case_expression_t>(
-                lexeme_t(case_start, case_end), operand, when_clauses, else_value);
+                ctx.lexeme(case_start, case_end), operand, when_clauses, else_value);
     else
         out = std::make_unique<simple_case_expression_t>(
-                lexeme_t(case_start, case_end), operand, when_clauses);
+                ctx.lexeme(case_start, case_end), operand, when_clauses);
     return true;
 }
 
@@ -711,9 +735,10 @@ process_searched_when:
     cur_tok = lex.next();
     if (! parse_value_expression(ctx, cur_tok, when_result))
         return false;
-    when_clauses.emplace_back(
-            searched_case_expression_when_clause_t(
-                    when_cond, when_result));
+    if (! ctx.opts.disable_statement_construction)
+        when_clauses.emplace_back(
+                searched_case_expression_when_clause_t(
+                        when_cond, when_result));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_WHEN) {
         cur_tok = lex.next();
@@ -746,10 +771,10 @@ push_searched_case:
         return true;
     if (else_value)
         out = std::make_unique<searched_case_expression_t>(
-                lexeme_t(case_start, case_end), when_clauses, else_value);
+                ctx.lexeme(case_start, case_end), when_clauses, else_value);
     else
         out = std::make_unique<searched_case_expression_t>(
-                lexeme_t(case_start, case_end), when_clauses);
+                ctx.lexeme(case_start, case_end), when_clauses);
     return true;
 }
 
@@ -859,13 +884,8 @@ err_expect_lparen:
     expect_error(ctx, SYMBOL_LPAREN);
     return false;
 err_expect_character_value_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <character value expression> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    syntax_error(ctx, "Expected <character value expression> but found %t");
     return false;
-}
 err_expect_in:
     expect_error(ctx, SYMBOL_IN);
     return false;
@@ -924,22 +944,12 @@ err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
 err_expect_extract_field:
-{
-    std::stringstream estr;
-    estr << "Expected <extract field> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    syntax_error(ctx, "Expected <extract field> but found %t");
     return false;
-}
 err_expect_extract_source:
-{
-    std::stringstream estr;
-    estr << "Expected <extract source> which can be a datetime or "
-            "interval value expression but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    syntax_error(ctx, "Expected <extract source> which can be a datetime or "
+                      "interval value expression but found %t");
     return false;
-}
 process_length_expression:
     // We get here after getting a one of the CHAR_LENGTH, BIT_LENGTH or
     // OCTET_LENGTH symbols. We now need to process the required string
@@ -956,13 +966,8 @@ process_length_expression:
     cur_tok = lex.next();
     goto push_length_expression;
 err_expect_string_value_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <string value expression> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    syntax_error(ctx, "Expected <string value expression> but found %t");
     return false;
-}
 push_position_expression:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -1001,7 +1006,7 @@ optional_collation:
         cur_sym = cur_tok.symbol;
         if (cur_sym != SYMBOL_IDENTIFIER)
            goto err_expect_identifier;
-        collation = cur_tok.lexeme;
+        collation = ctx.lexeme(cur_tok);
         cur_tok = lex.next();
     }
     goto push_factor;
@@ -1102,13 +1107,9 @@ process_operand:
     }
     goto expect_rparen;
 err_expect_operand:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> as operand but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <character value expression> as operand "
+                      "but found %t");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1170,13 +1171,9 @@ err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
 err_expect_start_position:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric value expression> after FROM but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <numeric value expression> after FROM but "
+                      "found %t");
+    return false;
 optional_for_length:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_FOR) {
@@ -1189,13 +1186,9 @@ optional_for_length:
     }
     goto expect_rparen;
 err_expect_numeric_for_length:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric value expression> after FOR but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <numeric value expression> after FOR but "
+                      "found %t");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1251,7 +1244,7 @@ process_operand:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    conversion_name = cur_tok.lexeme;
+    conversion_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_rparen;
 err_expect_using:
@@ -1310,7 +1303,7 @@ process_operand:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_IDENTIFIER)
         goto err_expect_identifier;
-    translation_name = cur_tok.lexeme;
+    translation_name = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto expect_rparen;
 err_expect_using:
@@ -1400,14 +1393,9 @@ expect_trim_character:
     cur_tok = lex.next();
     goto process_operand;
 err_expect_trim_character:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> after "
-                "<trim specification> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <character value expression> after "
+                      "<trim specification> but found %t");
+    return false;
 err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
@@ -1419,14 +1407,9 @@ process_operand:
     }
     goto expect_rparen;
 err_expect_operand:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> as operand for TRIM "
-                "function but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <character value expression> as operand "
+                      "for TRIM function but found %t");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1512,17 +1495,13 @@ expect_tz_name:
     // as the tz for the datetime factor
     if (! cur_tok.is_literal())
         goto err_expect_tz_name;
-    tz = cur_tok.lexeme;
+    tz = ctx.lexeme(cur_tok);
     cur_tok = lex.next();
     goto push_factor;
 err_expect_tz_name:
-    {
-        std::stringstream estr;
-        estr << "Expected <time zone name> after AT TIME ZONE but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <time zone name> after AT TIME ZONE but "
+                      "found %t");
+    return false;
 push_factor:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -1652,16 +1631,12 @@ optional_operator:
     }
     return true;
 err_expect_numeric_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric factor> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <numeric factor> after finding numeric "
+                      "operator but found %t");
+    return false;
 ensure_term:
     if (ctx.opts.disable_statement_construction)
-        return true;
+        goto optional_operator;
     out = std::make_unique<interval_term_t>(factor);
     goto optional_operator;
 }
@@ -1676,6 +1651,8 @@ bool parse_interval_factor(
     int8_t sign = 0;
     std::unique_ptr<interval_primary_t> primary;
 
+    if (ctx.has_parsed_primary(cur_tok))
+        goto parse_primary;
     if (cur_sym == SYMBOL_PLUS) {
         cur_tok = lex.next();
         sign = 1;
@@ -1683,6 +1660,8 @@ bool parse_interval_factor(
         cur_tok = lex.next();
         sign = -1;
     }
+    goto parse_primary;
+parse_primary:
     if (! parse_interval_primary(ctx, cur_tok, primary))
         return false;
     goto push_factor;
@@ -15,7 +15,7 @@ namespace sqltoast {
 //     <row value constructor element>
 //     | <left paren> <row value constructor list> <right paren>
 //     | <row subquery>
-bool parse_row_value_constructor(
+static bool parse_row_value_constructor_rule(
         parse_context_t& ctx,
         token_t& cur_tok,
         std::unique_ptr<row_value_constructor_t>& out) {
@@ -28,6 +28,8 @@ bool parse_row_value_constructor(
     if (parse_row_value_constructor_element(ctx, cur_tok, out)) {
         return true;
     }
+    if (ctx.result.code == PARSE_SYNTAX_ERROR)
+        return false;
     // Reset cursor to before parsing of element attempt. Remember that a row
     // value constructor element can also start with a LPAREN, which is why we
     // do this.
@@ -45,7 +47,8 @@ bool parse_row_value_constructor(
 process_rvc_list_element:
     if (! parse_row_value_constructor_element(ctx, cur_tok, element))
         goto err_expect_row_value_constructor_element;
-    elements.emplace_back(std::move(element));
+    if (! ctx.opts.disable_statement_construction)
+        elements.emplace_back(std::move(element));
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -53,13 +56,9 @@ process_rvc_list_element:
     }
     goto expect_rparen;
 err_expect_row_value_constructor_element:
-    {
-        std::stringstream estr;
-        estr << "Expected <row value constructor element> "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <row value constructor element> "
+                      "but found %t");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -76,6 +75,20 @@ push_rvc:
     return true;
 }
 
+// Attempts the rule above, or replays an earlier attempt at the same position
+// when parsing with parse_options_t::memoize set
+bool parse_row_value_constructor(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::unique_ptr<row_value_constructor_t>& out) {
+    return memoized(
+            ctx,
+            MEMO_RULE_ROW_VALUE_CONSTRUCTOR,
+            cur_tok,
+            out,
+            &parse_row_value_constructor_rule);
+}
+
 // <row value constructor element> ::=
 //     <value expression>
 //     | <null specification>
@@ -86,7 +99,8 @@ bool parse_row_value_constructor_element(
         std::unique_ptr<row_value_constructor_t>& out) {
     std::unique_ptr<value_expression_t> value_exp;
     if (parse_value_expression(ctx, cur_tok, value_exp)) {
-        out = std::make_unique<row_value_expression_t>(value_exp);
+        if (! ctx.opts.disable_statement_construction)
+            out = std::make_unique<row_value_expression_t>(value_exp);
         return true;
     }
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
@@ -95,11 +109,13 @@ bool parse_row_value_constructor_element(
         lexer_t& lex = ctx.lexer;
         symbol_t cur_sym = cur_tok.symbol;
         if (cur_sym == SYMBOL_NULL) {
-            out = std::make_unique<row_value_constructor_element_t>(RVC_ELEMENT_TYPE_NULL);
+            if (! ctx.opts.disable_statement_construction)
+                out = std::make_unique<row_value_constructor_element_t>(RVC_ELEMENT_TYPE_NULL);
             cur_tok = lex.next();
             return true;
         } else if (cur_sym == SYMBOL_DEFAULT) {
-            out = std::make_unique<row_value_constructor_element_t>(RVC_ELEMENT_TYPE_DEFAULT);
+            if (! ctx.opts.disable_statement_construction)
+                out = std::make_unique<row_value_constructor_element_t>(RVC_ELEMENT_TYPE_DEFAULT);
             cur_tok = lex.next();
             return true;
         }
@@ -112,13 +128,103 @@ bool parse_row_value_constructor_element(
 //     | <string value expression>
 //     | <datetime value expression>
 //     | <interval value expression>
-bool parse_value_expression(
+//
+// All four kinds of value expression may start with a <value expression
+// primary>, and it is what follows the primary that says which kind we're
+// looking at. So instead of trying to parse each kind in turn, rewinding the
+// lexer and throwing away the partial tree every time one fails, we parse
+// the primary once and use the symbol after it to pick the right kind of
+// value expression, which then picks up the already-parsed primary. The
+// choice is always the one that trying each kind in turn would have
+// arrived at. Value expressions that start with a function are picked by
+// the function's keyword. In the rare cases where the chosen kind fails
+// without a syntax error, we fall back to trying each kind in turn.
+static bool parse_value_expression_rule(
         parse_context_t& ctx,
         token_t& cur_tok,
         std::unique_ptr<value_expression_t>& out) {
     lexer_t& lex = ctx.lexer;
     parse_position_t start = lex.cursor;
     token_t start_tok = cur_tok;
+    symbol_t cur_sym = cur_tok.symbol;
+    parsed_primary_t& parsed = ctx.parsed_primary;
+    std::unique_ptr<value_expression_primary_t> primary;
+    bool found;
+
+    switch (cur_sym) {
+        case SYMBOL_UPPER:
+        case SYMBOL_LOWER:
+        case SYMBOL_SUBSTRING:
+        case SYMBOL_CONVERT:
+        case SYMBOL_TRANSLATE:
+        case SYMBOL_TRIM:
+            found = parse_string_value_expression(ctx, cur_tok, out);
+            goto check_found;
+        case SYMBOL_CURRENT_DATE:
+        case SYMBOL_CURRENT_TIME:
+        case SYMBOL_CURRENT_TIMESTAMP:
+            found = parse_datetime_value_expression(ctx, cur_tok, out);
+            goto check_found;
+        case SYMBOL_PLUS:
+        case SYMBOL_MINUS:
+            // A signed value can only be a numeric or interval factor, and
+            // numeric value expressions are tried first anyway
+            goto try_each;
+        default:
+            break;
+    }
+    if (! parse_value_expression_primary(ctx, cur_tok, primary)) {
+        if (ctx.result.code == PARSE_SYNTAX_ERROR)
+            return false;
+        // Must start with a numeric value function
+        goto try_each;
+    }
+    parsed.present = true;
+    parsed.next_start = cur_tok.lexeme.start;
+    parsed.value = std::move(primary);
+    cur_sym = cur_tok.symbol;
+    switch (cur_sym) {
+        case SYMBOL_PLUS:
+        case SYMBOL_MINUS:
+        case SYMBOL_ASTERISK:
+        case SYMBOL_SOLIDUS:
+            found = parse_numeric_value_expression(ctx, cur_tok, out);
+            break;
+        case SYMBOL_CONCATENATION:
+        case SYMBOL_COLLATE:
+            found = parse_string_value_expression(ctx, cur_tok, out);
+            break;
+        case SYMBOL_AT:
+            found = parse_datetime_value_expression(ctx, cur_tok, out);
+            break;
+        case SYMBOL_YEAR:
+        case SYMBOL_MONTH:
+        case SYMBOL_DAY:
+        case SYMBOL_HOUR:
+        case SYMBOL_MINUTE:
+        case SYMBOL_SECOND:
+            found = parse_interval_value_expression(ctx, cur_tok, out);
+            break;
+        default:
+            if (is_value_expression_terminator(cur_sym))
+                found = parse_numeric_value_expression(ctx, cur_tok, out);
+            else
+                found = false;
+            break;
+    }
+    parsed.present = false;
+    parsed.value.reset();
+    goto check_found;
+check_found:
+    if (found)
+        return true;
+    if (ctx.result.code == PARSE_SYNTAX_ERROR)
+        return false;
+    goto try_each;
+try_each:
+    // Reset our cursor
+    lex.cursor = start;
+    cur_tok = start_tok;
     if (parse_numeric_value_expression(ctx, cur_tok, out))
         return true;
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
@@ -143,6 +249,20 @@ bool parse_value_expression(
     return parse_interval_value_expression(ctx, cur_tok, out);
 }
 
+// Attempts the rule above, or replays an earlier attempt at the same position
+// when parsing with parse_options_t::memoize set
+bool parse_value_expression(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::unique_ptr<value_expression_t>& out) {
+    return memoized(
+            ctx,
+            MEMO_RULE_VALUE_EXPRESSION,
+            cur_tok,
+            out,
+            &parse_value_expression_rule);
+}
+
 // <numeric value expression> ::=
 //     <term>
 //     | <numeric value expression> <plus sign> <term>
@@ -192,16 +312,12 @@ optional_operator:
     }
     return false;
 err_expect_numeric_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <numeric term> after finding numeric "
+                      "operator but found %t");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
-        return true;
+        goto optional_operator;
     out = std::make_unique<numeric_expression_t>(term);
     goto optional_operator;
 }
@@ -235,7 +351,8 @@ bool parse_character_value_expression(
     std::unique_ptr<character_factor_t> factor;
     if (! parse_character_factor(ctx, cur_tok, factor))
         return false;
-    values.emplace_back(std::move(factor));
+    if (! ctx.opts.disable_statement_construction)
+        values.emplace_back(std::move(factor));
     goto optional_concat;
 optional_concat:
     // Look for terminating symbols or the concatenation operator which
@@ -258,13 +375,9 @@ optional_concat:
     }
     return false;
 err_expect_char_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <character factor> after concatenation "
-                "operator but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <character factor> after concatenation "
+                      "operator but found %t");
+    return false;
 push_ve:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -325,16 +438,12 @@ optional_operator:
     }
     return false;
 err_expect_interval_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <interval term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <interval term> after finding numeric "
+                      "operator but found %t");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
-        return true;
+        goto optional_operator;
     out = std::make_unique<datetime_value_expression_t>(left);
     goto optional_operator;
 }
@@ -393,16 +502,12 @@ optional_operator:
     }
     return false;
 err_expect_interval_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <interval term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    syntax_error(ctx, "Expected <interval term> after finding numeric "
+                      "operator but found %t");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
-        return true;
+        goto optional_operator;
     out = std::make_unique<interval_value_expression_t>(left);
     goto optional_operator;
 }
@@ -40,7 +40,7 @@ std::ostream& operator<< (std::ostream& out, const default_descriptor_t& default
                 out << "(" << default_desc.precision << ")";
             break;
         case DEFAULT_TYPE_LITERAL:
-            out << default_desc.lexeme;
+            out << lexeme_text(default_desc.lexeme, out);
             break;
         default:
             break;
@@ -49,7 +49,7 @@ std::ostream& operator<< (std::ostream& out, const default_descriptor_t& default
 }
 
 std::ostream& operator<< (std::ostream& out, const column_definition_t& column_def) {
-    out << column_def.name << " ";
+    out << lexeme_text(column_def.name, out) << " ";
     if (column_def.data_type.get()) {
         out << *column_def.data_type;
     } else {
@@ -61,7 +61,7 @@ std::ostream& operator<< (std::ostream& out, const column_definition_t& column_d
     for (const std::unique_ptr<constraint_t>& c: column_def.constraints)
         out << *c;
     if (column_def.collate) {
-        out << " COLLATE " << column_def.collate;
+        out << " COLLATE " << lexeme_text(column_def.collate, out);
     }
     return out;
 }
@@ -14,14 +14,14 @@ std::ostream& operator<< (std::ostream& out, const derived_column_t& dc) {
     else
         out << "*";
     if (dc.has_alias())
-        out << " AS " << dc.alias;
+        out << " AS " << lexeme_text(dc.alias, out);
     return out;
 }
 
 std::ostream& operator<< (std::ostream& out, const grouping_column_reference_t& gcr) {
-    out << gcr.column;
+    out << lexeme_text(gcr.column, out);
     if (gcr.has_collation())
-        out << " COLLATE " << gcr.collation;
+        out << " COLLATE " << lexeme_text(gcr.collation, out);
     return out;
 }
 
@@ -10,7 +10,7 @@ namespace sqltoast {
 
 std::ostream& operator<< (std::ostream& out, const constraint_t& constraint) {
     if (constraint.name)
-        out << " CONSTRAINT " << constraint.name;
+        out << " CONSTRAINT " << lexeme_text(constraint.name, out);
     switch (constraint.type) {
         case CONSTRAINT_TYPE_NOT_NULL:
             {
@@ -66,7 +66,7 @@ std::ostream& operator<< (std::ostream& out, const unique_constraint_t& constrai
     if (num_columns > 0) {
         out << " (";
         for (auto col : constraint.columns) {
-            out << col;
+            out << lexeme_text(col, out);
             if (x++ < (num_columns - 1)) {
                 out << ",";
             }
@@ -81,17 +81,17 @@ std::ostream& operator<< (std::ostream& out, const foreign_key_constraint_t& con
         size_t x = 0;
         out << " FOREIGN KEY (";
         for (const lexeme_t& col_name : constraint.columns) {
-            out << col_name;
+            out << lexeme_text(col_name, out);
             if (x++ != (num_columns - 1))
                 out << ",";
         }
         size_t num_referenced_columns = constraint.referenced_columns.size();
-        out << ") REFERENCES " << constraint.referenced_table;
+        out << ") REFERENCES " << lexeme_text(constraint.referenced_table, out);
         if (num_referenced_columns > 0) {
             out << " (";
             x = 0;
             for (const lexeme_t& col_name : constraint.referenced_columns) {
-                out << col_name;
+                out << lexeme_text(col_name, out);
                 if (x++ != (num_referenced_columns - 1))
                     out << ",";
             }
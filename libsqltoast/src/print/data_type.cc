@@ -81,7 +81,7 @@ std::ostream& operator<< (std::ostream& out, const char_string_t& cs) {
     if (cs.size > 0)
         out << "(" << cs.size << ")";
     if (cs.charset)
-        out << " CHARACTER SET " << cs.charset;
+        out << " CHARACTER SET " << lexeme_text(cs.charset, out);
     return out;
 }
 
@@ -0,0 +1,273 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/print.h"
+
+namespace sqltoast {
+
+namespace {
+
+// Prints each node on its own line, indented by its depth, with whichever of
+// its role, values, flags and lexeme are set
+typedef struct flat_printer : flat_visitor_t {
+    std::ostream& out;
+    size_t depth;
+    flat_printer(std::ostream& out) :
+        out(out),
+        depth(0)
+    {}
+    bool enter(const flat_ast_t& ast, flat_index_t node) {
+        out << std::string(depth * 2 + 2, ' ') << node << ": "
+            << ast.type(node);
+        if (ast.role(node) != FLAT_ROLE_NONE)
+            out << " " << ast.role(node);
+        if (ast.values[node] != 0)
+            out << " value=" << ast.values[node];
+        if (ast.params[node] != 0)
+            out << " param=" << ast.params[node];
+        if (ast.params2[node] != 0)
+            out << " param2=" << ast.params2[node];
+        if (ast.flags[node] != 0)
+            out << " flags=" << ast.flags[node];
+        lexeme_t lexeme = ast.lexeme(node);
+        if (lexeme)
+            out << " '" << lexeme_text(lexeme, ast.input) << "'";
+        out << std::endl;
+        depth++;
+        return true;
+    }
+    void leave(const flat_ast_t&, flat_index_t) {
+        depth--;
+    }
+} flat_printer_t;
+
+} // namespace
+
+std::ostream& operator<< (std::ostream& out, const flat_ast_t& ast) {
+    flat_printer_t printer(out);
+    for (size_t x = 0; x < ast.statements.size(); x++) {
+        out << "statements[" << x << "]:" << std::endl;
+        walk(ast, ast.statements[x], printer);
+    }
+    return out;
+}
+
+std::ostream& operator<< (std::ostream& out, const flat_node_type_t& type) {
+    switch (type) {
+        case FLAT_NODE_TYPE_STATEMENT:
+            out << "STATEMENT";
+            break;
+        case FLAT_NODE_TYPE_ALTER_TABLE_ACTION:
+            out << "ALTER_TABLE_ACTION";
+            break;
+        case FLAT_NODE_TYPE_COLUMN_DEFINITION:
+            out << "COLUMN_DEFINITION";
+            break;
+        case FLAT_NODE_TYPE_DATA_TYPE:
+            out << "DATA_TYPE";
+            break;
+        case FLAT_NODE_TYPE_DEFAULT:
+            out << "DEFAULT";
+            break;
+        case FLAT_NODE_TYPE_CONSTRAINT:
+            out << "CONSTRAINT";
+            break;
+        case FLAT_NODE_TYPE_REFERENTIAL_ACTION:
+            out << "REFERENTIAL_ACTION";
+            break;
+        case FLAT_NODE_TYPE_GRANT_ACTION:
+            out << "GRANT_ACTION";
+            break;
+        case FLAT_NODE_TYPE_SET_COLUMN:
+            out << "SET_COLUMN";
+            break;
+        case FLAT_NODE_TYPE_QUERY_EXPRESSION:
+            out << "QUERY_EXPRESSION";
+            break;
+        case FLAT_NODE_TYPE_TABLE_VALUE_CONSTRUCTOR:
+            out << "TABLE_VALUE_CONSTRUCTOR";
+            break;
+        case FLAT_NODE_TYPE_QUERY_SPECIFICATION:
+            out << "QUERY_SPECIFICATION";
+            break;
+        case FLAT_NODE_TYPE_DERIVED_COLUMN:
+            out << "DERIVED_COLUMN";
+            break;
+        case FLAT_NODE_TYPE_TABLE_EXPRESSION:
+            out << "TABLE_EXPRESSION";
+            break;
+        case FLAT_NODE_TYPE_GROUPING_COLUMN:
+            out << "GROUPING_COLUMN";
+            break;
+        case FLAT_NODE_TYPE_TABLE_REFERENCE:
+            out << "TABLE_REFERENCE";
+            break;
+        case FLAT_NODE_TYPE_JOIN:
+            out << "JOIN";
+            break;
+        case FLAT_NODE_TYPE_SEARCH_CONDITION:
+            out << "SEARCH_CONDITION";
+            break;
+        case FLAT_NODE_TYPE_BOOLEAN_TERM:
+            out << "BOOLEAN_TERM";
+            break;
+        case FLAT_NODE_TYPE_BOOLEAN_FACTOR:
+            out << "BOOLEAN_FACTOR";
+            break;
+        case FLAT_NODE_TYPE_PREDICATE:
+            out << "PREDICATE";
+            break;
+        case FLAT_NODE_TYPE_ROW_VALUE_CONSTRUCTOR:
+            out << "ROW_VALUE_CONSTRUCTOR";
+            break;
+        case FLAT_NODE_TYPE_VALUE_EXPRESSION:
+            out << "VALUE_EXPRESSION";
+            break;
+        case FLAT_NODE_TYPE_NUMERIC_TERM:
+            out << "NUMERIC_TERM";
+            break;
+        case FLAT_NODE_TYPE_NUMERIC_FACTOR:
+            out << "NUMERIC_FACTOR";
+            break;
+        case FLAT_NODE_TYPE_NUMERIC_FUNCTION:
+            out << "NUMERIC_FUNCTION";
+            break;
+        case FLAT_NODE_TYPE_VALUE_EXPRESSION_PRIMARY:
+            out << "VALUE_EXPRESSION_PRIMARY";
+            break;
+        case FLAT_NODE_TYPE_CASE_WHEN:
+            out << "CASE_WHEN";
+            break;
+        case FLAT_NODE_TYPE_STRING_FUNCTION:
+            out << "STRING_FUNCTION";
+            break;
+        case FLAT_NODE_TYPE_CHARACTER_FACTOR:
+            out << "CHARACTER_FACTOR";
+            break;
+        case FLAT_NODE_TYPE_DATETIME_FACTOR:
+            out << "DATETIME_FACTOR";
+            break;
+        case FLAT_NODE_TYPE_DATETIME_FUNCTION:
+            out << "DATETIME_FUNCTION";
+            break;
+        case FLAT_NODE_TYPE_INTERVAL_TERM:
+            out << "INTERVAL_TERM";
+            break;
+        case FLAT_NODE_TYPE_INTERVAL_FACTOR:
+            out << "INTERVAL_FACTOR";
+            break;
+        case FLAT_NODE_TYPE_INTERVAL_QUALIFIER:
+            out << "INTERVAL_QUALIFIER";
+            break;
+        case FLAT_NODE_TYPE_DATETIME_FIELD:
+            out << "DATETIME_FIELD";
+            break;
+        case FLAT_NODE_TYPE_NAME:
+            out << "NAME";
+            break;
+    }
+    return out;
+}
+
+std::ostream& operator<< (std::ostream& out, const flat_role_t& role) {
+    switch (role) {
+        case FLAT_ROLE_NONE:
+            break;
+        case FLAT_ROLE_LEFT:
+            out << "left";
+            break;
+        case FLAT_ROLE_RIGHT:
+            out << "right";
+            break;
+        case FLAT_ROLE_LOWER:
+            out << "lower";
+            break;
+        case FLAT_ROLE_UPPER:
+            out << "upper";
+            break;
+        case FLAT_ROLE_PATTERN:
+            out << "pattern";
+            break;
+        case FLAT_ROLE_ESCAPE:
+            out << "escape";
+            break;
+        case FLAT_ROLE_OPERAND:
+            out << "operand";
+            break;
+        case FLAT_ROLE_SUBJECT:
+            out << "subject";
+            break;
+        case FLAT_ROLE_VALUE:
+            out << "value";
+            break;
+        case FLAT_ROLE_START:
+            out << "start";
+            break;
+        case FLAT_ROLE_END:
+            out << "end";
+            break;
+        case FLAT_ROLE_LENGTH:
+            out << "length";
+            break;
+        case FLAT_ROLE_TRIM_CHARACTER:
+            out << "trim_character";
+            break;
+        case FLAT_ROLE_WHEN:
+            out << "when";
+            break;
+        case FLAT_ROLE_RESULT:
+            out << "result";
+            break;
+        case FLAT_ROLE_ELSE:
+            out << "else";
+            break;
+        case FLAT_ROLE_WHERE:
+            out << "where";
+            break;
+        case FLAT_ROLE_HAVING:
+            out << "having";
+            break;
+        case FLAT_ROLE_ON:
+            out << "on";
+            break;
+        case FLAT_ROLE_QUERY:
+            out << "query";
+            break;
+        case FLAT_ROLE_ALIAS:
+            out << "alias";
+            break;
+        case FLAT_ROLE_COLUMN:
+            out << "column";
+            break;
+        case FLAT_ROLE_COLLATION:
+            out << "collation";
+            break;
+        case FLAT_ROLE_CHARSET:
+            out << "charset";
+            break;
+        case FLAT_ROLE_AUTHORIZATION:
+            out << "authorization";
+            break;
+        case FLAT_ROLE_GRANTEE:
+            out << "grantee";
+            break;
+        case FLAT_ROLE_REFERENCED_TABLE:
+            out << "referenced_table";
+            break;
+        case FLAT_ROLE_REFERENCED_COLUMN:
+            out << "referenced_column";
+            break;
+        case FLAT_ROLE_ON_UPDATE:
+            out << "on_update";
+            break;
+        case FLAT_ROLE_ON_DELETE:
+            out << "on_delete";
+            break;
+    }
+    return out;
+}
+
+} // namespace sqltoast
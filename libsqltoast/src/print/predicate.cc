@@ -124,8 +124,9 @@ std::ostream& operator<< (std::ostream& out, const boolean_factor_t& bf) {
 
 std::ostream& operator<< (std::ostream& out, const boolean_term_t& bt) {
     out << *bt.factor;
-    if (bt.and_operand)
-        out << " AND " << *bt.and_operand;
+    for (const boolean_term_t* next = bt.and_operand.get(); next;
+            next = next->and_operand.get())
+        out << " AND " << *next->factor;
     return out;
 }
 
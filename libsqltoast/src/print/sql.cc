@@ -0,0 +1,1512 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+namespace {
+
+// Appends SQL to the caller's string, laying it out according to the
+// requested format
+typedef struct sql_writer {
+    std::string& out;
+    parse_position_t input;
+    sql_format_t format;
+    // How many subqueries deep the writer is. Only the clauses of the
+    // outermost query go on lines of their own.
+    size_t depth;
+    sql_writer(std::string& out, parse_position_t input, sql_format_t format) :
+        out(out),
+        input(input),
+        format(format),
+        depth(0)
+    {}
+    inline void put(char c) {
+        out.push_back(c);
+    }
+    inline void put(const char* s) {
+        out.append(s);
+    }
+    inline void put(const lexeme_t& lex) {
+        out.append(lex.start(input), lex.size());
+    }
+    void put(size_t n) {
+        char digits[20];
+        size_t len = 0;
+        do {
+            digits[len++] = char('0' + n % 10);
+            n /= 10;
+        } while (n > 0);
+        while (len > 0)
+            out.push_back(digits[--len]);
+    }
+    // Separates the items of a list
+    inline void comma() {
+        if (format == SQL_FORMAT_CANONICAL)
+            out.append(", ", 2);
+        else
+            out.push_back(',');
+    }
+    // Writes an operator that needs no whitespace around it to be told apart
+    // from its operands
+    inline void op(const char* s) {
+        if (format == SQL_FORMAT_CANONICAL) {
+            out.push_back(' ');
+            out.append(s);
+            out.push_back(' ');
+        } else
+            out.append(s);
+    }
+    // Separates a keyword or name from the parenthesized list or subquery
+    // following it
+    inline void before_paren() {
+        if (format == SQL_FORMAT_CANONICAL)
+            out.push_back(' ');
+    }
+    // Starts a clause of the statement, such as FROM or WHERE
+    inline void clause(const char* keyword) {
+        if (format == SQL_FORMAT_CANONICAL && depth == 0)
+            out.push_back('\n');
+        else
+            out.push_back(' ');
+        out.append(keyword);
+    }
+} sql_writer_t;
+
+void write(sql_writer_t& w, const statement_t& stmt);
+void write(sql_writer_t& w, const query_expression_t& qe);
+void write(sql_writer_t& w, const search_condition_t& sc);
+void write(sql_writer_t& w, const row_value_constructor_t& rvc);
+void write(sql_writer_t& w, const value_expression_t& ve);
+void write(sql_writer_t& w, const value_expression_primary_t& vep);
+void write(sql_writer_t& w, const numeric_factor_t& factor);
+void write(sql_writer_t& w, const table_reference_t& tr);
+
+void write_names(sql_writer_t& w, const std::vector<lexeme_t>& names) {
+    w.put('(');
+    size_t x = 0;
+    for (const lexeme_t& name : names) {
+        if (x++ > 0)
+            w.comma();
+        w.put(name);
+    }
+    w.put(')');
+}
+
+void write_subquery(sql_writer_t& w, const query_expression_t& qe) {
+    w.put('(');
+    w.depth++;
+    write(w, qe);
+    w.depth--;
+    w.put(')');
+}
+
+void write(sql_writer_t& w, const interval_unit_t& unit) {
+    switch (unit) {
+        case INTERVAL_UNIT_YEAR:
+            w.put("YEAR");
+            break;
+        case INTERVAL_UNIT_MONTH:
+            w.put("MONTH");
+            break;
+        case INTERVAL_UNIT_DAY:
+            w.put("DAY");
+            break;
+        case INTERVAL_UNIT_HOUR:
+            w.put("HOUR");
+            break;
+        case INTERVAL_UNIT_MINUTE:
+            w.put("MINUTE");
+            break;
+        case INTERVAL_UNIT_SECOND:
+            w.put("SECOND");
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const data_type_descriptor_t& dt) {
+    switch (dt.type) {
+        case DATA_TYPE_CHAR:
+        case DATA_TYPE_VARCHAR:
+        case DATA_TYPE_NCHAR:
+        case DATA_TYPE_NVARCHAR:
+            {
+                const char_string_t& cs = static_cast<const char_string_t&>(dt);
+                if (dt.type == DATA_TYPE_CHAR)
+                    w.put("CHAR");
+                else if (dt.type == DATA_TYPE_VARCHAR)
+                    w.put("VARCHAR");
+                else if (dt.type == DATA_TYPE_NCHAR)
+                    w.put("NCHAR");
+                else
+                    w.put("NCHAR VARYING");
+                if (cs.size > 0) {
+                    w.put('(');
+                    w.put(cs.size);
+                    w.put(')');
+                }
+                if (cs.charset) {
+                    w.put(" CHARACTER SET ");
+                    w.put(cs.charset);
+                }
+            }
+            break;
+        case DATA_TYPE_BIT:
+        case DATA_TYPE_VARBIT:
+            {
+                const bit_string_t& bs = static_cast<const bit_string_t&>(dt);
+                if (dt.type == DATA_TYPE_BIT)
+                    w.put("BIT");
+                else
+                    w.put("BIT VARYING");
+                if (bs.size > 0) {
+                    w.put('(');
+                    w.put(bs.size);
+                    w.put(')');
+                }
+            }
+            break;
+        case DATA_TYPE_INT:
+            w.put("INT");
+            break;
+        case DATA_TYPE_SMALLINT:
+            w.put("SMALLINT");
+            break;
+        case DATA_TYPE_NUMERIC:
+            {
+                const exact_numeric_t& num = static_cast<const exact_numeric_t&>(dt);
+                w.put("NUMERIC");
+                if (num.precision > 0) {
+                    w.put('(');
+                    w.put(num.precision);
+                    if (num.scale > 0) {
+                        w.comma();
+                        w.put(num.scale);
+                    }
+                    w.put(')');
+                }
+            }
+            break;
+        case DATA_TYPE_FLOAT:
+            {
+                const approximate_numeric_t& num =
+                    static_cast<const approximate_numeric_t&>(dt);
+                w.put("FLOAT");
+                if (num.precision > 0) {
+                    w.put('(');
+                    w.put(num.precision);
+                    w.put(')');
+                }
+            }
+            break;
+        case DATA_TYPE_DOUBLE:
+            w.put("DOUBLE PRECISION");
+            break;
+        case DATA_TYPE_DATE:
+        case DATA_TYPE_TIME:
+        case DATA_TYPE_TIMESTAMP:
+            {
+                const datetime_t& dtt = static_cast<const datetime_t&>(dt);
+                if (dt.type == DATA_TYPE_DATE)
+                    w.put("DATE");
+                else if (dt.type == DATA_TYPE_TIME)
+                    w.put("TIME");
+                else
+                    w.put("TIMESTAMP");
+                if (dtt.precision > 0) {
+                    w.put('(');
+                    w.put(dtt.precision);
+                    w.put(')');
+                }
+                if (dtt.with_tz)
+                    w.put(" WITH TIME ZONE");
+            }
+            break;
+        case DATA_TYPE_INTERVAL:
+            {
+                const interval_t& interval = static_cast<const interval_t&>(dt);
+                w.put("INTERVAL ");
+                write(w, interval.unit);
+                if (interval.unit == INTERVAL_UNIT_SECOND && interval.precision > 0) {
+                    w.put('(');
+                    w.put(interval.precision);
+                    w.put(')');
+                }
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const default_descriptor_t& dd) {
+    w.put("DEFAULT ");
+    switch (dd.type) {
+        case DEFAULT_TYPE_LITERAL:
+            w.put(dd.lexeme);
+            break;
+        case DEFAULT_TYPE_USER:
+            w.put("USER");
+            break;
+        case DEFAULT_TYPE_CURRENT_USER:
+            w.put("CURRENT_USER");
+            break;
+        case DEFAULT_TYPE_SESSION_USER:
+            w.put("SESSION_USER");
+            break;
+        case DEFAULT_TYPE_SYSTEM_USER:
+            w.put("SYSTEM_USER");
+            break;
+        case DEFAULT_TYPE_CURRENT_DATE:
+            w.put("CURRENT_DATE");
+            break;
+        case DEFAULT_TYPE_CURRENT_TIME:
+        case DEFAULT_TYPE_CURRENT_TIMESTAMP:
+            if (dd.type == DEFAULT_TYPE_CURRENT_TIME)
+                w.put("CURRENT_TIME");
+            else
+                w.put("CURRENT_TIMESTAMP");
+            if (dd.precision > 0) {
+                w.put('(');
+                w.put(dd.precision);
+                w.put(')');
+            }
+            break;
+        case DEFAULT_TYPE_NULL:
+            w.put("NULL");
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const referential_action_t& action) {
+    switch (action) {
+        case REFERENTIAL_ACTION_CASCADE:
+            w.put("CASCADE");
+            break;
+        case REFERENTIAL_ACTION_SET_NULL:
+            w.put("SET NULL");
+            break;
+        case REFERENTIAL_ACTION_SET_DEFAULT:
+            w.put("SET DEFAULT");
+            break;
+        default:
+            break;
+    }
+}
+
+// Column constraints have no columns of their own, so only table
+// constraints get a column list
+void write(sql_writer_t& w, const constraint_t& constraint) {
+    if (constraint.name) {
+        w.put("CONSTRAINT ");
+        w.put(constraint.name);
+        w.put(' ');
+    }
+    switch (constraint.type) {
+        case CONSTRAINT_TYPE_NOT_NULL:
+            w.put("NOT NULL");
+            break;
+        case CONSTRAINT_TYPE_UNIQUE:
+        case CONSTRAINT_TYPE_PRIMARY_KEY:
+            if (constraint.type == CONSTRAINT_TYPE_UNIQUE)
+                w.put("UNIQUE");
+            else
+                w.put("PRIMARY KEY");
+            if (! constraint.columns.empty()) {
+                w.before_paren();
+                write_names(w, constraint.columns);
+            }
+            break;
+        case CONSTRAINT_TYPE_FOREIGN_KEY:
+            {
+                const foreign_key_constraint_t& fk =
+                    static_cast<const foreign_key_constraint_t&>(constraint);
+                if (! fk.columns.empty()) {
+                    w.put("FOREIGN KEY");
+                    w.before_paren();
+                    write_names(w, fk.columns);
+                    w.put(' ');
+                }
+                w.put("REFERENCES ");
+                w.put(fk.referenced_table);
+                if (! fk.referenced_columns.empty()) {
+                    w.before_paren();
+                    write_names(w, fk.referenced_columns);
+                }
+                if (fk.match_type == MATCH_TYPE_FULL)
+                    w.put(" MATCH FULL");
+                else if (fk.match_type == MATCH_TYPE_PARTIAL)
+                    w.put(" MATCH PARTIAL");
+                if (fk.on_update != REFERENTIAL_ACTION_NONE) {
+                    w.put(" ON UPDATE ");
+                    write(w, fk.on_update);
+                }
+                if (fk.on_delete != REFERENTIAL_ACTION_NONE) {
+                    w.put(" ON DELETE ");
+                    write(w, fk.on_delete);
+                }
+            }
+            break;
+        case CONSTRAINT_TYPE_CHECK:
+            // CHECK constraints aren't parsed yet, so there's nothing to write
+            break;
+        case CONSTRAINT_TYPE_UNKNOWN:
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const column_definition_t& cd) {
+    w.put(cd.name);
+    if (cd.data_type) {
+        w.put(' ');
+        write(w, *cd.data_type);
+    }
+    if (cd.default_descriptor) {
+        w.put(' ');
+        write(w, *cd.default_descriptor);
+    }
+    for (const std::unique_ptr<constraint_t>& c : cd.constraints) {
+        w.put(' ');
+        write(w, *c);
+    }
+    if (cd.collate) {
+        w.put(" COLLATE ");
+        w.put(cd.collate);
+    }
+}
+
+void write(sql_writer_t& w, const comp_op_t& op) {
+    switch (op) {
+        case COMP_OP_EQUAL:
+            w.op("=");
+            break;
+        case COMP_OP_NOT_EQUAL:
+            w.op("<>");
+            break;
+        case COMP_OP_LESS:
+            w.op("<");
+            break;
+        case COMP_OP_GREATER:
+            w.op(">");
+            break;
+        case COMP_OP_LESS_EQUAL:
+            w.op("<=");
+            break;
+        case COMP_OP_GREATER_EQUAL:
+            w.op(">=");
+            break;
+    }
+}
+
+// Addition and subtraction always get spaces around them so that a minus
+// sign following a minus operator can't start a comment
+void write_additive_op(sql_writer_t& w, numeric_op_t op) {
+    if (op == NUMERIC_OP_ADD)
+        w.put(" + ");
+    else
+        w.put(" - ");
+}
+
+void write_multiplicative_op(sql_writer_t& w, numeric_op_t op) {
+    if (op == NUMERIC_OP_MULTIPLY)
+        w.op("*");
+    else
+        w.op("/");
+}
+
+void write(sql_writer_t& w, const predicate_t& pred) {
+    switch (pred.predicate_type) {
+        case PREDICATE_TYPE_COMPARISON:
+            {
+                const comp_predicate_t& p =
+                    static_cast<const comp_predicate_t&>(pred);
+                write(w, *p.left);
+                write(w, p.op);
+                write(w, *p.right);
+            }
+            break;
+        case PREDICATE_TYPE_BETWEEN:
+            {
+                const between_predicate_t& p =
+                    static_cast<const between_predicate_t&>(pred);
+                write(w, *p.left);
+                if (p.reverse_op)
+                    w.put(" NOT");
+                w.put(" BETWEEN ");
+                write(w, *p.comp_left);
+                w.put(" AND ");
+                write(w, *p.comp_right);
+            }
+            break;
+        case PREDICATE_TYPE_IN_VALUES:
+            {
+                const in_values_predicate_t& p =
+                    static_cast<const in_values_predicate_t&>(pred);
+                write(w, *p.left);
+                if (p.reverse_op)
+                    w.put(" NOT");
+                w.put(" IN");
+                w.before_paren();
+                w.put('(');
+                size_t x = 0;
+                for (const std::unique_ptr<value_expression_t>& ve : p.values) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *ve);
+                }
+                w.put(')');
+            }
+            break;
+        case PREDICATE_TYPE_IN_SUBQUERY:
+            {
+                const in_subquery_predicate_t& p =
+                    static_cast<const in_subquery_predicate_t&>(pred);
+                write(w, *p.left);
+                if (p.reverse_op)
+                    w.put(" NOT");
+                w.put(" IN");
+                w.before_paren();
+                write_subquery(w, *p.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_LIKE:
+            {
+                const like_predicate_t& p =
+                    static_cast<const like_predicate_t&>(pred);
+                write(w, *p.match);
+                if (p.reverse_op)
+                    w.put(" NOT");
+                w.put(" LIKE ");
+                write(w, *p.pattern);
+                if (p.escape_char) {
+                    w.put(" ESCAPE ");
+                    write(w, *p.escape_char);
+                }
+            }
+            break;
+        case PREDICATE_TYPE_NULL:
+            {
+                const null_predicate_t& p =
+                    static_cast<const null_predicate_t&>(pred);
+                write(w, *p.left);
+                if (p.reverse_op)
+                    w.put(" IS NOT NULL");
+                else
+                    w.put(" IS NULL");
+            }
+            break;
+        case PREDICATE_TYPE_QUANTIFIED_COMPARISON:
+            {
+                const quantified_comparison_predicate_t& p =
+                    static_cast<const quantified_comparison_predicate_t&>(pred);
+                write(w, *p.left);
+                write(w, p.op);
+                if (p.quantifier == QUANTIFIER_ALL)
+                    w.put("ALL");
+                else
+                    w.put("ANY");
+                w.before_paren();
+                write_subquery(w, *p.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_EXISTS:
+            {
+                const exists_predicate_t& p =
+                    static_cast<const exists_predicate_t&>(pred);
+                w.put("EXISTS");
+                w.before_paren();
+                write_subquery(w, *p.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_UNIQUE:
+            {
+                const unique_predicate_t& p =
+                    static_cast<const unique_predicate_t&>(pred);
+                w.put("UNIQUE");
+                w.before_paren();
+                write_subquery(w, *p.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_MATCH:
+            {
+                const match_predicate_t& p =
+                    static_cast<const match_predicate_t&>(pred);
+                write(w, *p.left);
+                w.put(" MATCH");
+                if (p.match_unique)
+                    w.put(" UNIQUE");
+                if (p.match_partial)
+                    w.put(" PARTIAL");
+                else
+                    w.put(" FULL");
+                w.before_paren();
+                write_subquery(w, *p.subquery);
+            }
+            break;
+        case PREDICATE_TYPE_OVERLAPS:
+            {
+                const overlaps_predicate_t& p =
+                    static_cast<const overlaps_predicate_t&>(pred);
+                write(w, *p.left);
+                w.put(" OVERLAPS ");
+                write(w, *p.right);
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const boolean_factor_t& factor) {
+    if (factor.reverse_op)
+        w.put("NOT ");
+    const boolean_primary_t& primary = *factor.primary;
+    if (primary.predicate) {
+        write(w, *primary.predicate);
+    } else {
+        w.put('(');
+        write(w, *primary.search_condition);
+        w.put(')');
+    }
+}
+
+void write(sql_writer_t& w, const search_condition_t& sc) {
+    size_t x = 0;
+    for (const std::unique_ptr<boolean_term_t>& term : sc.terms) {
+        if (x++ > 0)
+            w.put(" OR ");
+        write(w, *term->factor);
+        for (const boolean_term_t* next = term->and_operand.get(); next;
+                next = next->and_operand.get()) {
+            w.put(" AND ");
+            write(w, *next->factor);
+        }
+    }
+}
+
+void write(sql_writer_t& w, const row_value_constructor_t& rvc) {
+    switch (rvc.rvc_type) {
+        case RVC_TYPE_ELEMENT:
+            {
+                const row_value_constructor_element_t& el =
+                    static_cast<const row_value_constructor_element_t&>(rvc);
+                switch (el.rvc_element_type) {
+                    case RVC_ELEMENT_TYPE_VALUE_EXPRESSION:
+                        write(w, *static_cast<const row_value_expression_t&>(el).value);
+                        break;
+                    case RVC_ELEMENT_TYPE_NULL:
+                        w.put("NULL");
+                        break;
+                    case RVC_ELEMENT_TYPE_DEFAULT:
+                        w.put("DEFAULT");
+                        break;
+                }
+            }
+            break;
+        case RVC_TYPE_LIST:
+            {
+                const row_value_constructor_list_t& list =
+                    static_cast<const row_value_constructor_list_t&>(rvc);
+                w.put('(');
+                size_t x = 0;
+                for (const std::unique_ptr<row_value_constructor_t>& el : list.elements) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *el);
+                }
+                w.put(')');
+            }
+            break;
+        case RVC_TYPE_SUBQUERY:
+            // Row value constructor subqueries aren't parsed yet
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const case_expression_t& ce) {
+    switch (ce.case_type) {
+        case CASE_EXPRESSION_TYPE_COALESCE_FUNCTION:
+            {
+                const coalesce_function_t& cf =
+                    static_cast<const coalesce_function_t&>(ce);
+                w.put("COALESCE(");
+                size_t x = 0;
+                for (const std::unique_ptr<value_expression_t>& val : cf.values) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *val);
+                }
+                w.put(')');
+            }
+            break;
+        case CASE_EXPRESSION_TYPE_NULLIF_FUNCTION:
+            {
+                const nullif_function_t& nf =
+                    static_cast<const nullif_function_t&>(ce);
+                w.put("NULLIF(");
+                write(w, *nf.left);
+                w.comma();
+                write(w, *nf.right);
+                w.put(')');
+            }
+            break;
+        case CASE_EXPRESSION_TYPE_SIMPLE_CASE:
+            {
+                const simple_case_expression_t& sce =
+                    static_cast<const simple_case_expression_t&>(ce);
+                w.put("CASE ");
+                write(w, *sce.operand);
+                for (const simple_case_expression_when_clause_t& when : sce.when_clauses) {
+                    w.put(" WHEN ");
+                    write(w, *when.operand);
+                    w.put(" THEN ");
+                    write(w, *when.result);
+                }
+                if (sce.else_value) {
+                    w.put(" ELSE ");
+                    write(w, *sce.else_value);
+                }
+                w.put(" END");
+            }
+            break;
+        case CASE_EXPRESSION_TYPE_SEARCHED_CASE:
+            {
+                const searched_case_expression_t& sce =
+                    static_cast<const searched_case_expression_t&>(ce);
+                w.put("CASE");
+                for (const searched_case_expression_when_clause_t& when : sce.when_clauses) {
+                    w.put(" WHEN ");
+                    write(w, *when.condition);
+                    w.put(" THEN ");
+                    write(w, *when.result);
+                }
+                if (sce.else_value) {
+                    w.put(" ELSE ");
+                    write(w, *sce.else_value);
+                }
+                w.put(" END");
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const unsigned_value_specification_t& uvs) {
+    switch (uvs.uvs_type) {
+        case UVS_TYPE_USER:
+            w.put("USER");
+            break;
+        case UVS_TYPE_CURRENT_USER:
+            w.put("CURRENT_USER");
+            break;
+        case UVS_TYPE_SESSION_USER:
+            w.put("SESSION_USER");
+            break;
+        case UVS_TYPE_SYSTEM_USER:
+            w.put("SYSTEM_USER");
+            break;
+        case UVS_TYPE_VALUE:
+            w.put("VALUE");
+            break;
+        case UVS_TYPE_PARAMETER:
+            // The lexeme of a named parameter leaves out its colon
+            if (uvs.lexeme.size() != 1 || *uvs.lexeme.start(w.input) != '?')
+                w.put(':');
+            w.put(uvs.lexeme);
+            break;
+        // The lexemes of these string literals start at the opening quote,
+        // leaving out the prefix that tells them apart from a plain string
+        case UVS_TYPE_NATIONAL_CHARACTER_STRING:
+            w.put('N');
+            w.put(uvs.lexeme);
+            break;
+        case UVS_TYPE_BIT_STRING:
+            w.put('B');
+            w.put(uvs.lexeme);
+            break;
+        case UVS_TYPE_HEX_STRING:
+            w.put('X');
+            w.put(uvs.lexeme);
+            break;
+        default:
+            w.put(uvs.lexeme);
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const value_expression_primary_t& vep) {
+    switch (vep.vep_type) {
+        case VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION:
+            write(w, static_cast<const unsigned_value_specification_t&>(vep));
+            break;
+        case VEP_TYPE_COLUMN_REFERENCE:
+            w.put(vep.lexeme);
+            break;
+        case VEP_TYPE_SET_FUNCTION_SPECIFICATION:
+            {
+                const set_function_t& sf = static_cast<const set_function_t&>(vep);
+                switch (sf.func_type) {
+                    case SET_FUNCTION_TYPE_COUNT:
+                        w.put("COUNT(");
+                        break;
+                    case SET_FUNCTION_TYPE_AVG:
+                        w.put("AVG(");
+                        break;
+                    case SET_FUNCTION_TYPE_MIN:
+                        w.put("MIN(");
+                        break;
+                    case SET_FUNCTION_TYPE_MAX:
+                        w.put("MAX(");
+                        break;
+                    case SET_FUNCTION_TYPE_SUM:
+                        w.put("SUM(");
+                        break;
+                }
+                if (sf.star) {
+                    w.put('*');
+                } else {
+                    if (sf.distinct)
+                        w.put("DISTINCT ");
+                    write(w, *sf.value);
+                }
+                w.put(')');
+            }
+            break;
+        case VEP_TYPE_SCALAR_SUBQUERY:
+            write_subquery(w, *static_cast<const scalar_subquery_t&>(vep).query);
+            break;
+        case VEP_TYPE_CASE_EXPRESSION:
+            write(w, static_cast<const case_expression_t&>(vep));
+            break;
+        case VEP_TYPE_PARENTHESIZED_VALUE_EXPRESSION:
+            w.put('(');
+            write(w, *static_cast<const parenthesized_value_expression_t&>(vep).value);
+            w.put(')');
+            break;
+        case VEP_TYPE_CAST_SPECIFICATION:
+            // CAST isn't parsed yet
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const numeric_function_t& nf) {
+    switch (nf.type) {
+        case NUMERIC_FUNCTION_TYPE_POSITION:
+            {
+                const position_expression_t& pe =
+                    static_cast<const position_expression_t&>(nf);
+                w.put("POSITION(");
+                write(w, *pe.to_find);
+                w.put(" IN ");
+                write(w, *pe.subject);
+                w.put(')');
+            }
+            break;
+        case NUMERIC_FUNCTION_TYPE_EXTRACT:
+            {
+                const extract_expression_t& ee =
+                    static_cast<const extract_expression_t&>(nf);
+                w.put("EXTRACT(");
+                write(w, ee.extract_field);
+                w.put(" FROM ");
+                write(w, *ee.extract_source);
+                w.put(')');
+            }
+            break;
+        case NUMERIC_FUNCTION_TYPE_CHAR_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_OCTET_LENGTH:
+        case NUMERIC_FUNCTION_TYPE_BIT_LENGTH:
+            {
+                const length_expression_t& le =
+                    static_cast<const length_expression_t&>(nf);
+                if (nf.type == NUMERIC_FUNCTION_TYPE_CHAR_LENGTH)
+                    w.put("CHAR_LENGTH(");
+                else if (nf.type == NUMERIC_FUNCTION_TYPE_OCTET_LENGTH)
+                    w.put("OCTET_LENGTH(");
+                else
+                    w.put("BIT_LENGTH(");
+                write(w, *le.operand);
+                w.put(')');
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const numeric_factor_t& factor) {
+    if (factor.sign < 0)
+        w.put('-');
+    else if (factor.sign > 0)
+        w.put('+');
+    const numeric_primary_t& primary = *factor.primary;
+    if (primary.type == NUMERIC_PRIMARY_TYPE_VALUE)
+        write(w, *static_cast<const numeric_value_t&>(primary).primary);
+    else
+        write(w, static_cast<const numeric_function_t&>(primary));
+}
+
+void write(sql_writer_t& w, const numeric_term_t& term) {
+    write(w, *term.left);
+    if (term.right) {
+        write_multiplicative_op(w, term.op);
+        write(w, *term.right);
+    }
+}
+
+void write(sql_writer_t& w, const string_function_t& sf) {
+    switch (sf.type) {
+        case STRING_FUNCTION_TYPE_SUBSTRING:
+            {
+                const substring_function_t& subs =
+                    static_cast<const substring_function_t&>(sf);
+                w.put("SUBSTRING(");
+                write(w, *subs.operand);
+                w.put(" FROM ");
+                write(w, *subs.start_position_value);
+                if (subs.for_length_value) {
+                    w.put(" FOR ");
+                    write(w, *subs.for_length_value);
+                }
+                w.put(')');
+            }
+            break;
+        case STRING_FUNCTION_TYPE_UPPER:
+        case STRING_FUNCTION_TYPE_LOWER:
+            if (sf.type == STRING_FUNCTION_TYPE_UPPER)
+                w.put("UPPER(");
+            else
+                w.put("LOWER(");
+            write(w, *sf.operand);
+            w.put(')');
+            break;
+        case STRING_FUNCTION_TYPE_CONVERT:
+            w.put("CONVERT(");
+            write(w, *sf.operand);
+            w.put(" USING ");
+            w.put(static_cast<const convert_function_t&>(sf).conversion_name);
+            w.put(')');
+            break;
+        case STRING_FUNCTION_TYPE_TRANSLATE:
+            w.put("TRANSLATE(");
+            write(w, *sf.operand);
+            w.put(" USING ");
+            w.put(static_cast<const translate_function_t&>(sf).translation_name);
+            w.put(')');
+            break;
+        case STRING_FUNCTION_TYPE_TRIM:
+            {
+                const trim_function_t& tf = static_cast<const trim_function_t&>(sf);
+                w.put("TRIM(");
+                if (tf.trim_character || tf.specification != TRIM_SPECIFICATION_BOTH) {
+                    switch (tf.specification) {
+                        case TRIM_SPECIFICATION_LEADING:
+                            w.put("LEADING ");
+                            break;
+                        case TRIM_SPECIFICATION_TRAILING:
+                            w.put("TRAILING ");
+                            break;
+                        case TRIM_SPECIFICATION_BOTH:
+                            w.put("BOTH ");
+                            break;
+                    }
+                    if (tf.trim_character) {
+                        write(w, *tf.trim_character);
+                        w.put(' ');
+                    }
+                    w.put("FROM ");
+                }
+                write(w, *tf.operand);
+                w.put(')');
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const character_factor_t& factor) {
+    const character_primary_t& primary = *factor.primary;
+    if (primary.value)
+        write(w, *primary.value);
+    else
+        write(w, *primary.string_function);
+    if (factor.collation) {
+        w.put(" COLLATE ");
+        w.put(factor.collation);
+    }
+}
+
+void write(sql_writer_t& w, const datetime_term_t& term) {
+    const datetime_factor_t& factor = *term.value;
+    const datetime_primary_t& primary = *factor.primary;
+    if (primary.type == DATETIME_PRIMARY_TYPE_VALUE) {
+        write(w, *static_cast<const datetime_value_t&>(primary).primary);
+    } else {
+        const current_datetime_function_t& df =
+            static_cast<const current_datetime_function_t&>(primary);
+        switch (df.func_type) {
+            case DATETIME_FUNCTION_TYPE_CURRENT_DATE:
+                w.put("CURRENT_DATE");
+                break;
+            case DATETIME_FUNCTION_TYPE_CURRENT_TIME:
+                w.put("CURRENT_TIME");
+                break;
+            case DATETIME_FUNCTION_TYPE_CURRENT_TIMESTAMP:
+                w.put("CURRENT_TIMESTAMP");
+                break;
+        }
+        if (df.precision > 0) {
+            w.put('(');
+            w.put(df.precision);
+            w.put(')');
+        }
+    }
+    // A plain value is only a datetime factor because of its time zone, so
+    // keeps its AT LOCAL, but the datetime functions don't need one
+    if (factor.tz) {
+        w.put(" AT TIME ZONE ");
+        w.put(factor.tz);
+    } else if (primary.type == DATETIME_PRIMARY_TYPE_VALUE) {
+        w.put(" AT LOCAL");
+    }
+}
+
+void write(sql_writer_t& w, const datetime_field_t& field, bool leading) {
+    write(w, field.interval);
+    if (field.interval != INTERVAL_UNIT_SECOND) {
+        if (field.precision > 0) {
+            w.put('(');
+            w.put(field.precision);
+            w.put(')');
+        }
+    } else if (! leading) {
+        // The end field of a qualifier only has a fractional precision
+        if (field.fractional_precision > 0) {
+            w.put('(');
+            w.put(field.fractional_precision);
+            w.put(')');
+        }
+    } else if (field.precision > 0 || field.fractional_precision > 0) {
+        w.put('(');
+        w.put(field.precision);
+        if (field.fractional_precision > 0) {
+            w.comma();
+            w.put(field.fractional_precision);
+        }
+        w.put(')');
+    }
+}
+
+void write(sql_writer_t& w, const interval_term_t& term) {
+    const interval_factor_t& factor = *term.left;
+    if (factor.sign < 0)
+        w.put('-');
+    else if (factor.sign > 0)
+        w.put('+');
+    const interval_primary_t& primary = *factor.primary;
+    write(w, *primary.value);
+    if (primary.qualifier) {
+        w.put(' ');
+        write(w, primary.qualifier->start, true);
+        if (primary.qualifier->end) {
+            w.put(" TO ");
+            write(w, *primary.qualifier->end, false);
+        }
+    }
+    if (term.right) {
+        write_multiplicative_op(w, term.op);
+        write(w, *term.right);
+    }
+}
+
+void write(sql_writer_t& w, const value_expression_t& ve) {
+    switch (ve.type) {
+        case VALUE_EXPRESSION_TYPE_NUMERIC_EXPRESSION:
+            {
+                const numeric_expression_t& ne =
+                    static_cast<const numeric_expression_t&>(ve);
+                write(w, *ne.left);
+                if (ne.right) {
+                    write_additive_op(w, ne.op);
+                    write(w, *ne.right);
+                }
+            }
+            break;
+        case VALUE_EXPRESSION_TYPE_STRING_EXPRESSION:
+            {
+                const character_value_expression_t& cve =
+                    static_cast<const character_value_expression_t&>(ve);
+                size_t x = 0;
+                for (const std::unique_ptr<character_factor_t>& factor : cve.values) {
+                    if (x++ > 0)
+                        w.op("||");
+                    write(w, *factor);
+                }
+            }
+            break;
+        case VALUE_EXPRESSION_TYPE_DATETIME_EXPRESSION:
+            {
+                const datetime_value_expression_t& de =
+                    static_cast<const datetime_value_expression_t&>(ve);
+                write(w, *de.left);
+                if (de.right) {
+                    write_additive_op(w, de.op);
+                    write(w, *de.right);
+                }
+            }
+            break;
+        case VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION:
+            {
+                const interval_value_expression_t& ie =
+                    static_cast<const interval_value_expression_t&>(ve);
+                write(w, *ie.left);
+                if (ie.right) {
+                    write_additive_op(w, ie.op);
+                    write(w, *ie.right);
+                }
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const correlation_spec_t& spec) {
+    w.put(" AS ");
+    w.put(spec.alias);
+    if (! spec.columns.empty()) {
+        w.before_paren();
+        write_names(w, spec.columns);
+    }
+}
+
+void write(sql_writer_t& w, const table_reference_t& tr) {
+    if (tr.type == TABLE_REFERENCE_TYPE_TABLE) {
+        const table_t& t = static_cast<const table_t&>(tr);
+        w.put(t.table_name);
+        if (t.has_alias())
+            write(w, *t.correlation_spec);
+    } else {
+        const derived_table_t& dt = static_cast<const derived_table_t&>(tr);
+        write_subquery(w, *dt.query);
+        write(w, dt.correlation_spec);
+    }
+    if (! tr.joined)
+        return;
+    const join_target_t& jt = *tr.joined;
+    switch (jt.join_type) {
+        case JOIN_TYPE_CROSS:
+            w.put(" CROSS JOIN ");
+            break;
+        case JOIN_TYPE_LEFT:
+            w.put(" LEFT JOIN ");
+            break;
+        case JOIN_TYPE_RIGHT:
+            w.put(" RIGHT JOIN ");
+            break;
+        case JOIN_TYPE_FULL:
+            w.put(" FULL JOIN ");
+            break;
+        case JOIN_TYPE_NATURAL:
+            w.put(" NATURAL JOIN ");
+            break;
+        case JOIN_TYPE_UNION:
+            w.put(" UNION JOIN ");
+            break;
+        default:
+            w.put(" INNER JOIN ");
+            break;
+    }
+    write(w, *jt.table_ref);
+    if (! jt.join_spec)
+        return;
+    if (jt.join_spec->condition) {
+        w.put(" ON ");
+        write(w, *jt.join_spec->condition);
+    } else if (! jt.join_spec->named_columns.empty()) {
+        w.put(" USING");
+        w.before_paren();
+        write_names(w, jt.join_spec->named_columns);
+    }
+}
+
+void write(sql_writer_t& w, const query_specification_t& query) {
+    w.put("SELECT ");
+    if (query.distinct)
+        w.put("DISTINCT ");
+    size_t x = 0;
+    for (const derived_column_t& dc : query.selected_columns) {
+        if (x++ > 0)
+            w.comma();
+        if (dc.value)
+            write(w, *dc.value);
+        else
+            w.put('*');
+        if (dc.has_alias()) {
+            w.put(' ');
+            w.put(dc.alias);
+        }
+    }
+    const table_expression_t& te = *query.table_expression;
+    w.clause("FROM ");
+    x = 0;
+    for (const std::unique_ptr<table_reference_t>& tr : te.referenced_tables) {
+        if (x++ > 0)
+            w.comma();
+        write(w, *tr);
+    }
+    if (te.where_condition) {
+        w.clause("WHERE ");
+        write(w, *te.where_condition);
+    }
+    if (! te.group_by_columns.empty()) {
+        w.clause("GROUP BY ");
+        x = 0;
+        for (const grouping_column_reference_t& gcr : te.group_by_columns) {
+            if (x++ > 0)
+                w.comma();
+            w.put(gcr.column);
+            if (gcr.has_collation()) {
+                w.put(" COLLATE ");
+                w.put(gcr.collation);
+            }
+        }
+    }
+    if (te.having_condition) {
+        w.clause("HAVING ");
+        write(w, *te.having_condition);
+    }
+}
+
+void write(sql_writer_t& w, const query_expression_t& qe) {
+    if (qe.query_expression_type == QUERY_EXPRESSION_TYPE_JOINED_TABLE) {
+        write(w, *static_cast<const joined_table_query_expression_t&>(qe).joined_table);
+        return;
+    }
+    const non_join_query_expression_t& njqe =
+        static_cast<const non_join_query_expression_t&>(qe);
+    const non_join_query_primary_t& primary = *njqe.term->primary;
+    switch (primary.primary_type) {
+        case NON_JOIN_QUERY_PRIMARY_TYPE_QUERY_SPECIFICATION:
+            write(w, *static_cast<const query_specification_non_join_query_primary_t&>(primary).query_spec);
+            break;
+        case NON_JOIN_QUERY_PRIMARY_TYPE_TABLE_VALUE_CONSTRUCTOR:
+            {
+                const table_value_constructor_t& tvc =
+                    *static_cast<const table_value_constructor_non_join_query_primary_t&>(primary).table_value;
+                w.put("VALUES ");
+                size_t x = 0;
+                for (const std::unique_ptr<row_value_constructor_t>& value : tvc.values) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *value);
+                }
+            }
+            break;
+        case NON_JOIN_QUERY_PRIMARY_TYPE_EXPLICIT_TABLE:
+        case NON_JOIN_QUERY_PRIMARY_TYPE_SUBEXPRESSION:
+            // Neither is parsed yet
+            break;
+    }
+}
+
+void write_drop_behaviour(sql_writer_t& w, drop_behaviour_t behaviour) {
+    // CASCADE is what's assumed when neither is given
+    if (behaviour == DROP_BEHAVIOUR_RESTRICT)
+        w.put(" RESTRICT");
+}
+
+void write(sql_writer_t& w, const alter_table_action_t& action) {
+    switch (action.type) {
+        case ALTER_TABLE_ACTION_TYPE_ADD_COLUMN:
+            w.put("ADD COLUMN ");
+            write(w, *static_cast<const add_column_action_t&>(action).column_definition);
+            break;
+        case ALTER_TABLE_ACTION_TYPE_ALTER_COLUMN:
+            {
+                const alter_column_action_t& sub =
+                    static_cast<const alter_column_action_t&>(action);
+                w.put("ALTER COLUMN ");
+                w.put(sub.column_name);
+                if (sub.alter_column_action_type == ALTER_COLUMN_ACTION_TYPE_SET_DEFAULT) {
+                    w.put(" SET ");
+                    write(w, *sub.default_descriptor);
+                } else {
+                    w.put(" DROP DEFAULT");
+                }
+            }
+            break;
+        case ALTER_TABLE_ACTION_TYPE_DROP_COLUMN:
+            {
+                const drop_column_action_t& sub =
+                    static_cast<const drop_column_action_t&>(action);
+                w.put("DROP COLUMN ");
+                w.put(sub.column_name);
+                write_drop_behaviour(w, sub.drop_behaviour);
+            }
+            break;
+        case ALTER_TABLE_ACTION_TYPE_ADD_CONSTRAINT:
+            w.put("ADD ");
+            write(w, *static_cast<const add_constraint_action_t&>(action).constraint);
+            break;
+        case ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT:
+            {
+                const drop_constraint_action_t& sub =
+                    static_cast<const drop_constraint_action_t&>(action);
+                w.put("DROP CONSTRAINT ");
+                w.put(sub.constraint_name);
+                write_drop_behaviour(w, sub.drop_behaviour);
+            }
+            break;
+    }
+}
+
+void write(sql_writer_t& w, const grant_statement_t& stmt) {
+    w.put("GRANT ");
+    if (stmt.all_privileges())
+        w.put("ALL PRIVILEGES");
+    size_t x = 0;
+    for (const std::unique_ptr<grant_action_t>& action : stmt.privileges) {
+        if (x++ > 0)
+            w.comma();
+        switch (action->type) {
+            case GRANT_ACTION_TYPE_SELECT:
+                w.put("SELECT");
+                continue;
+            case GRANT_ACTION_TYPE_DELETE:
+                w.put("DELETE");
+                continue;
+            case GRANT_ACTION_TYPE_USAGE:
+                w.put("USAGE");
+                continue;
+            case GRANT_ACTION_TYPE_INSERT:
+                w.put("INSERT");
+                break;
+            case GRANT_ACTION_TYPE_UPDATE:
+                w.put("UPDATE");
+                break;
+            case GRANT_ACTION_TYPE_REFERENCES:
+                w.put("REFERENCES");
+                break;
+        }
+        const column_list_grant_action_t& cla =
+            static_cast<const column_list_grant_action_t&>(*action);
+        if (! cla.columns.empty()) {
+            w.before_paren();
+            write_names(w, cla.columns);
+        }
+    }
+    w.put(" ON ");
+    switch (stmt.object_type) {
+        case GRANT_OBJECT_TYPE_TABLE:
+            break;
+        case GRANT_OBJECT_TYPE_DOMAIN:
+            w.put("DOMAIN ");
+            break;
+        case GRANT_OBJECT_TYPE_COLLATION:
+            w.put("COLLATION ");
+            break;
+        case GRANT_OBJECT_TYPE_CHARACTER_SET:
+            w.put("CHARACTER SET ");
+            break;
+        case GRANT_OBJECT_TYPE_TRANSLATION:
+            w.put("TRANSLATION ");
+            break;
+    }
+    w.put(stmt.on);
+    w.put(" TO ");
+    if (stmt.to_public())
+        w.put("PUBLIC");
+    else
+        w.put(stmt.to);
+    if (stmt.with_grant_option)
+        w.put(" WITH GRANT OPTION");
+}
+
+void write(sql_writer_t& w, const statement_t& stmt) {
+    switch (stmt.type) {
+        case STATEMENT_TYPE_CREATE_SCHEMA:
+            {
+                const create_schema_statement_t& sub =
+                    static_cast<const create_schema_statement_t&>(stmt);
+                w.put("CREATE SCHEMA ");
+                w.put(sub.schema_name);
+                if (sub.authorization_identifier) {
+                    w.put(" AUTHORIZATION ");
+                    w.put(sub.authorization_identifier);
+                }
+                if (sub.default_charset) {
+                    w.put(" DEFAULT CHARACTER SET ");
+                    w.put(sub.default_charset);
+                }
+            }
+            break;
+        case STATEMENT_TYPE_DROP_SCHEMA:
+            {
+                const drop_schema_statement_t& sub =
+                    static_cast<const drop_schema_statement_t&>(stmt);
+                w.put("DROP SCHEMA ");
+                w.put(sub.schema_name);
+                write_drop_behaviour(w, sub.drop_behaviour);
+            }
+            break;
+        case STATEMENT_TYPE_CREATE_TABLE:
+            {
+                const create_table_statement_t& sub =
+                    static_cast<const create_table_statement_t&>(stmt);
+                if (sub.table_type == TABLE_TYPE_TEMPORARY_GLOBAL)
+                    w.put("CREATE GLOBAL TEMPORARY TABLE ");
+                else if (sub.table_type == TABLE_TYPE_TEMPORARY_LOCAL)
+                    w.put("CREATE LOCAL TEMPORARY TABLE ");
+                else
+                    w.put("CREATE TABLE ");
+                w.put(sub.table_name);
+                w.before_paren();
+                w.put('(');
+                size_t x = 0;
+                for (const std::unique_ptr<column_definition_t>& cd : sub.column_definitions) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *cd);
+                }
+                for (const std::unique_ptr<constraint_t>& c : sub.constraints) {
+                    if (x++ > 0)
+                        w.comma();
+                    write(w, *c);
+                }
+                w.put(')');
+            }
+            break;
+        case STATEMENT_TYPE_DROP_TABLE:
+            {
+                const drop_table_statement_t& sub =
+                    static_cast<const drop_table_statement_t&>(stmt);
+                w.put("DROP TABLE ");
+                w.put(sub.table_name);
+                write_drop_behaviour(w, sub.drop_behaviour);
+            }
+            break;
+        case STATEMENT_TYPE_ALTER_TABLE:
+            {
+                const alter_table_statement_t& sub =
+                    static_cast<const alter_table_statement_t&>(stmt);
+                w.put("ALTER TABLE ");
+                w.put(sub.table_name);
+                w.put(' ');
+                write(w, *sub.action);
+            }
+            break;
+        case STATEMENT_TYPE_CREATE_VIEW:
+            {
+                const create_view_statement_t& sub =
+                    static_cast<const create_view_statement_t&>(stmt);
+                w.put("CREATE VIEW ");
+                w.put(sub.table_name);
+                if (! sub.columns.empty()) {
+                    w.before_paren();
+                    write_names(w, sub.columns);
+                }
+                w.clause("AS ");
+                write(w, *sub.query);
+                if (sub.check_option == CHECK_OPTION_LOCAL)
+                    w.clause("WITH LOCAL CHECK OPTION");
+                else if (sub.check_option == CHECK_OPTION_CASCADED)
+                    w.clause("WITH CASCADED CHECK OPTION");
+            }
+            break;
+        case STATEMENT_TYPE_DROP_VIEW:
+            {
+                const drop_view_statement_t& sub =
+                    static_cast<const drop_view_statement_t&>(stmt);
+                w.put("DROP VIEW ");
+                w.put(sub.table_name);
+                write_drop_behaviour(w, sub.drop_behaviour);
+            }
+            break;
+        case STATEMENT_TYPE_SELECT:
+            write(w, *static_cast<const select_statement_t&>(stmt).query);
+            break;
+        case STATEMENT_TYPE_INSERT:
+            {
+                const insert_statement_t& sub =
+                    static_cast<const insert_statement_t&>(stmt);
+                w.put("INSERT INTO ");
+                w.put(sub.table_name);
+                if (! sub.insert_columns.empty()) {
+                    w.before_paren();
+                    write_names(w, sub.insert_columns);
+                }
+                if (sub.query) {
+                    w.clause("");
+                    write(w, *sub.query);
+                } else {
+                    w.put(" DEFAULT VALUES");
+                }
+            }
+            break;
+        case STATEMENT_TYPE_DELETE:
+            {
+                const delete_statement_t& sub =
+                    static_cast<const delete_statement_t&>(stmt);
+                w.put("DELETE FROM ");
+                w.put(sub.table_name);
+                if (sub.where_condition) {
+                    w.clause("WHERE ");
+                    write(w, *sub.where_condition);
+                }
+            }
+            break;
+        case STATEMENT_TYPE_UPDATE:
+            {
+                const update_statement_t& sub =
+                    static_cast<const update_statement_t&>(stmt);
+                w.put("UPDATE ");
+                w.put(sub.table_name);
+                w.clause("SET ");
+                size_t x = 0;
+                for (const set_column_t& set_col : sub.set_columns) {
+                    if (x++ > 0)
+                        w.comma();
+                    w.put(set_col.column_name);
+                    w.op("=");
+                    if (set_col.type == SET_COLUMN_TYPE_NULL)
+                        w.put("NULL");
+                    else if (set_col.type == SET_COLUMN_TYPE_DEFAULT)
+                        w.put("DEFAULT");
+                    else
+                        write(w, *set_col.value);
+                }
+                if (sub.where_condition) {
+                    w.clause("WHERE ");
+                    write(w, *sub.where_condition);
+                }
+            }
+            break;
+        case STATEMENT_TYPE_COMMIT:
+            w.put("COMMIT");
+            break;
+        case STATEMENT_TYPE_ROLLBACK:
+            w.put("ROLLBACK");
+            break;
+        case STATEMENT_TYPE_GRANT:
+            write(w, static_cast<const grant_statement_t&>(stmt));
+            break;
+    }
+}
+
+} // namespace <anonymous>
+
+void to_sql(
+        const statement_t& stmt,
+        parse_position_t input,
+        std::string& out,
+        sql_format_t format) {
+    sql_writer_t w(out, input, format);
+    write(w, stmt);
+}
+
+void to_sql(const parse_result_t& res, std::string& out, sql_format_t format) {
+    sql_writer_t w(out, res.input, format);
+    for (const std::unique_ptr<statement_t>& stmt : res.statements) {
+        write(w, *stmt);
+        w.put(';');
+        if (format == SQL_FORMAT_CANONICAL)
+            w.put('\n');
+    }
+}
+
+} // namespace sqltoast
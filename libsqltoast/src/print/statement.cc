@@ -105,18 +105,21 @@ std::ostream& operator<< (std::ostream& out, const statement_t& stmt) {
 
 std::ostream& operator<< (std::ostream& out, const create_schema_statement_t& stmt) {
     out << "<statement: CREATE SCHEMA" << std::endl
-        << "   schema name: " << stmt.schema_name;
+        << "   schema name: " << lexeme_text(stmt.schema_name, out);
     if (stmt.authorization_identifier)
-       out << std::endl << "   authorization identifier: " << stmt.authorization_identifier;
+       out << std::endl << "   authorization identifier: "
+           << lexeme_text(stmt.authorization_identifier, out);
     if (stmt.default_charset)
-       out << std::endl << "   default charset: " << stmt.default_charset;
+       out << std::endl << "   default charset: "
+           << lexeme_text(stmt.default_charset, out);
     out << ">";
     return out;
 }
 
 std::ostream& operator<< (std::ostream& out, const drop_schema_statement_t& stmt) {
     out << "<statement: DROP SCHEMA" << std::endl
-        << "   schema name: " << stmt.schema_name << std::endl;
+        << "   schema name: " << lexeme_text(stmt.schema_name, out)
+        << std::endl;
     if (stmt.drop_behaviour == DROP_BEHAVIOUR_CASCADE)
        out << "   behaviour: CASCADE";
     else
@@ -128,7 +131,7 @@ std::ostream& operator<< (std::ostream& out, const drop_schema_statement_t& stmt
 
 std::ostream& operator<< (std::ostream& out, const create_table_statement_t& stmt) {
     out << "<statement: CREATE TABLE" << std::endl
-        << "    table name: " << stmt.table_name;
+        << "    table name: " << lexeme_text(stmt.table_name, out);
     if (stmt.table_type != TABLE_TYPE_NORMAL) {
         out << std::endl << "    temporary: true (";
         if (stmt.table_type == TABLE_TYPE_TEMPORARY_GLOBAL)
@@ -157,7 +160,7 @@ std::ostream& operator<< (std::ostream& out, const create_table_statement_t& stm
 
 std::ostream& operator<< (std::ostream& out, const drop_table_statement_t& stmt) {
     out << "<statement: DROP TABLE" << std::endl
-        << "   table name: " << stmt.table_name << std::endl;
+        << "   table name: " << lexeme_text(stmt.table_name, out) << std::endl;
     if (stmt.drop_behaviour == DROP_BEHAVIOUR_CASCADE)
        out << "   behaviour: CASCADE";
     else
@@ -174,16 +177,16 @@ std::ostream& operator<< (std::ostream& out, const add_column_action_t& action)
 
 std::ostream& operator<< (std::ostream& out, const alter_column_action_t& action) {
     if (action.alter_column_action_type == ALTER_COLUMN_ACTION_TYPE_SET_DEFAULT)
-        out << "ALTER COLUMN " << action.column_name
+        out << "ALTER COLUMN " << lexeme_text(action.column_name, out)
             << " SET " << *action.default_descriptor;
     else
-        out << "ALTER COLUMN " << action.column_name
+        out << "ALTER COLUMN " << lexeme_text(action.column_name, out)
             << " DROP DEFAULT";
     return out;
 }
 
 std::ostream& operator<< (std::ostream& out, const drop_column_action_t& action) {
-    out << "DROP COLUMN " << action.column_name;
+    out << "DROP COLUMN " << lexeme_text(action.column_name, out);
     if (action.drop_behaviour == DROP_BEHAVIOUR_CASCADE)
         out << " CASCADE";
     else
@@ -197,7 +200,7 @@ std::ostream& operator<< (std::ostream& out, const add_constraint_action_t& acti
 }
 
 std::ostream& operator<< (std::ostream& out, const drop_constraint_action_t& action) {
-    out << "DROP CONSTRAINT " << action.constraint_name;
+    out << "DROP CONSTRAINT " << lexeme_text(action.constraint_name, out);
     if (action.drop_behaviour == DROP_BEHAVIOUR_CASCADE)
         out << " CASCADE";
     else
@@ -248,7 +251,7 @@ std::ostream& operator<< (std::ostream& out, const alter_table_action_t& action)
 
 std::ostream& operator<< (std::ostream& out, const alter_table_statement_t& stmt) {
     out << "<statement: ALTER TABLE" << std::endl
-        << "   table name: " << stmt.table_name << std::endl;
+        << "   table name: " << lexeme_text(stmt.table_name, out) << std::endl;
     out << "   action: " << *stmt.action;
     out << ">";
 
@@ -257,12 +260,13 @@ std::ostream& operator<< (std::ostream& out, const alter_table_statement_t& stmt
 
 std::ostream& operator<< (std::ostream& out, const create_view_statement_t& stmt) {
     out << "<statement: CREATE VIEW" << std::endl
-        << "   table name: " << stmt.table_name;
+        << "   table name: " << lexeme_text(stmt.table_name, out);
     if (! stmt.columns.empty()) {
        out << std::endl << "   columns:";
        size_t x = 0;
        for (const auto& column : stmt.columns)
-           out << std::endl << "     " << x++ << ": " << column;
+           out << std::endl << "     " << x++ << ": "
+               << lexeme_text(column, out);
     }
     if (stmt.check_option != CHECK_OPTION_NONE) {
         if (stmt.check_option == CHECK_OPTION_LOCAL)
@@ -276,7 +280,7 @@ std::ostream& operator<< (std::ostream& out, const create_view_statement_t& stmt
 
 std::ostream& operator<< (std::ostream& out, const drop_view_statement_t& stmt) {
     out << "<statement: DROP VIEW" << std::endl
-        << "   view name: " << stmt.table_name << std::endl;
+        << "   view name: " << lexeme_text(stmt.table_name, out) << std::endl;
     if (stmt.drop_behaviour == DROP_BEHAVIOUR_CASCADE)
        out << "   behaviour: CASCADE";
     else
@@ -297,13 +301,13 @@ std::ostream& operator<< (std::ostream& out, const select_statement_t& stmt) {
 
 std::ostream& operator<< (std::ostream& out, const insert_statement_t& stmt) {
     out << "<statement: INSERT" << std::endl
-        << "   table name: " << stmt.table_name;
+        << "   table name: " << lexeme_text(stmt.table_name, out);
 
     if (! stmt.insert_columns.empty()) {
         out << std::endl << "   columns:";
         size_t x = 0;
         for (const lexeme_t& col : stmt.insert_columns) {
-            out << std::endl << "     " << x++ << ": " << col;
+            out << std::endl << "     " << x++ << ": " << lexeme_text(col, out);
         }
     }
     if (stmt.query)
@@ -317,7 +321,7 @@ std::ostream& operator<< (std::ostream& out, const insert_statement_t& stmt) {
 
 std::ostream& operator<< (std::ostream& out, const delete_statement_t& stmt) {
     out << "<statement: DELETE" << std::endl
-        << "   table name: " << stmt.table_name;
+        << "   table name: " << lexeme_text(stmt.table_name, out);
 
     if (stmt.where_condition)
         out << std::endl << "   where:" << std::endl << "     " << *stmt.where_condition;
@@ -328,11 +332,12 @@ std::ostream& operator<< (std::ostream& out, const delete_statement_t& stmt) {
 
 std::ostream& operator<< (std::ostream& out, const update_statement_t& stmt) {
     out << "<statement: UPDATE" << std::endl
-        << "   table name: " << stmt.table_name;
+        << "   table name: " << lexeme_text(stmt.table_name, out);
 
     out << std::endl << "   set columns:";
     for (const set_column_t& set_col : stmt.set_columns) {
-        out << std::endl << "     " << set_col.column_name << " = ";
+        out << std::endl << "     "
+            << lexeme_text(set_col.column_name, out) << " = ";
         if (set_col.type == SET_COLUMN_TYPE_NULL)
             out << "NULL";
         else if (set_col.type == SET_COLUMN_TYPE_DEFAULT)
@@ -378,7 +383,7 @@ std::ostream& operator<< (std::ostream& out, const grant_action_t& action) {
     for (const lexeme_t& col : cla.columns) {
         if (x++ > 0)
             out << ',';
-        out << col;
+        out << lexeme_text(col, out);
     }
     out << ')';
     return out;
@@ -403,11 +408,11 @@ std::ostream& operator<< (std::ostream& out, const grant_statement_t& stmt) {
             out << "TRANSLATION ";
             break;
     }
-    out << stmt.on << std::endl;
+    out << lexeme_text(stmt.on, out) << std::endl;
     if (stmt.to_public())
         out << "   to: PUBLIC" << std::endl;
     else
-        out << "   to: " << stmt.to << std::endl;
+        out << "   to: " << lexeme_text(stmt.to, out) << std::endl;
     if (stmt.with_grant_option)
         out << "   with grant option: YES" << std::endl;
     if (stmt.all_privileges())
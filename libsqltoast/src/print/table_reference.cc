@@ -30,14 +30,14 @@ std::ostream& operator<< (std::ostream& out, const table_reference_t& tr) {
 }
 
 std::ostream& operator<< (std::ostream& out, const table_t& t) {
-    out << std::string(t.table_name.start, t.table_name.end);
+    out << lexeme_text(t.table_name, out);
     if (t.has_alias())
-        out << " AS " << t.correlation_spec->alias;
+        out << " AS " << lexeme_text(t.correlation_spec->alias, out);
     return out;
 }
 
 std::ostream& operator<< (std::ostream& out, const derived_table_t& dt) {
-    out << "<derived table> AS " << dt.correlation_spec.alias;
+    out << "<derived table> AS " << lexeme_text(dt.correlation_spec.alias, out);
     return out;
 }
 
@@ -83,7 +83,7 @@ std::ostream& operator<< (std::ostream& out, const join_specification_t& js) {
         for (const lexeme_t& col : js.named_columns) {
             if (x++ > 0)
                 out << ',';
-            out << col;
+            out << lexeme_text(col, out);
         }
         out << ']';
     }
@@ -127,7 +127,7 @@ std::ostream& operator<< (std::ostream& out, const value_expression_primary_t& v
             }
             break;
         case VEP_TYPE_COLUMN_REFERENCE:
-            out << "column-reference[" << std::string(vep.lexeme.start, vep.lexeme.end) << ']';
+            out << "column-reference[" << lexeme_text(vep.lexeme, out) << ']';
             break;
         case VEP_TYPE_SET_FUNCTION_SPECIFICATION:
             {
@@ -169,7 +169,7 @@ std::ostream& operator<< (std::ostream& out, const unsigned_value_specification_
         case UVS_TYPE_HEX_STRING:
         case UVS_TYPE_DATETIME:
         case UVS_TYPE_INTERVAL:
-            out << "literal[" << std::string(uvs.lexeme.start, uvs.lexeme.end) << ']';
+            out << "literal[" << lexeme_text(uvs.lexeme, out) << ']';
             break;
         case UVS_TYPE_USER:
             out << "USER";
@@ -187,7 +187,7 @@ std::ostream& operator<< (std::ostream& out, const unsigned_value_specification_
             out << "VALUE";
             break;
         case UVS_TYPE_PARAMETER:
-            out << "parameter[" << std::string(uvs.lexeme.start, uvs.lexeme.end) << ']';
+            out << "parameter[" << lexeme_text(uvs.lexeme, out) << ']';
             break;
         default:
             out << "unknown-unsigned-value-expression";
@@ -286,7 +286,7 @@ std::ostream& operator<< (std::ostream& out, const numeric_primary_t& np) {
 
 std::ostream& operator<< (std::ostream& out, const numeric_factor_t& nf) {
     if (nf.sign != 0)
-        out << nf.sign << ' ';
+        out << (nf.sign < 0 ? '-' : '+') << ' ';
     out << *nf.primary;
     return out;
 }
@@ -350,12 +350,14 @@ std::ostream& operator<< (std::ostream& out, const substring_function_t& sf) {
 }
 
 std::ostream& operator<< (std::ostream& out, const convert_function_t& cf) {
-    out << "convert[" << *cf.operand << " USING " << cf.conversion_name << "]";
+    out << "convert[" << *cf.operand << " USING "
+        << lexeme_text(cf.conversion_name, out) << "]";
     return out;
 }
 
 std::ostream& operator<< (std::ostream& out, const translate_function_t& tf) {
-    out << "translate[" << *tf.operand << " USING " << tf.translation_name << "]";
+    out << "translate[" << *tf.operand << " USING "
+        << lexeme_text(tf.translation_name, out) << "]";
     return out;
 }
 
@@ -390,7 +392,7 @@ std::ostream& operator<< (std::ostream& out, const character_primary_t& cp) {
 std::ostream& operator<< (std::ostream& out, const character_factor_t& cf) {
     out << *cf.primary;
     if (cf.collation)
-        out << " COLLATE " << cf.collation;
+        out << " COLLATE " << lexeme_text(cf.collation, out);
     return out;
 }
 
@@ -447,7 +449,7 @@ std::ostream& operator<< (std::ostream& out, const datetime_factor_t& factor) {
     if (factor.is_local_tz())
         out << " AT LOCAL";
     else
-        out << " AT TIME ZONE " << factor.tz;
+        out << " AT TIME ZONE " << lexeme_text(factor.tz, out);
     return out;
 }
 
@@ -491,7 +493,7 @@ std::ostream& operator<< (std::ostream& out, const interval_primary_t& primary)
 
 std::ostream& operator<< (std::ostream& out, const interval_factor_t& factor) {
     if (factor.sign != 0)
-        out << factor.sign << ' ';
+        out << (factor.sign < 0 ? '-' : '+') << ' ';
     out << *factor.primary;
     return out;
 }
@@ -0,0 +1,112 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOASTER_EMIT_H
+#define SQLTOASTER_EMIT_H
+
+#include <sqltoast/sqltoast.h>
+
+#include "emitter.h"
+
+namespace sqltoaster {
+
+// Writes the statements of a parse result as a mapping holding a sequence
+// of statements, the same document printer_t writes from a tree of nodes
+void emit(emitter_t& out, const sqltoast::parse_result_t& res);
+
+// Each of these writes the entries of the mapping that the fill() for the
+// same AST element fills in, straight to the emitter
+void emit(emitter_t& out, const sqltoast::alter_table_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::between_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::boolean_factor_t& bf);
+void emit(emitter_t& out, const sqltoast::boolean_primary_t& bp);
+void emit(emitter_t& out, const sqltoast::boolean_term_t& bt);
+void emit(emitter_t& out, const sqltoast::case_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::character_factor_t& factor);
+void emit(emitter_t& out, const sqltoast::character_primary_t& cp);
+void emit(emitter_t& out, const sqltoast::character_value_expression_t& cve);
+void emit(emitter_t& out, const sqltoast::coalesce_function_t& func);
+void emit(emitter_t& out, const sqltoast::comp_op_t& op);
+void emit(emitter_t& out, const sqltoast::comp_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::convert_function_t& func);
+void emit(emitter_t& out, const sqltoast::create_schema_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::create_table_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::create_view_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::datetime_factor_t& factor);
+void emit(emitter_t& out, const sqltoast::datetime_field_t& field);
+void emit(emitter_t& out, const sqltoast::datetime_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::datetime_term_t& term);
+void emit(emitter_t& out, const sqltoast::datetime_value_t& value);
+void emit(emitter_t& out, const sqltoast::datetime_value_expression_t& de);
+void emit(emitter_t& out, const sqltoast::delete_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::derived_column_t& dc);
+void emit(emitter_t& out, const sqltoast::derived_table_t& t);
+void emit(emitter_t& out, const sqltoast::drop_schema_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::drop_table_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::drop_view_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::exists_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::extract_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::grant_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::in_subquery_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::in_values_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::insert_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::interval_factor_t& factor);
+void emit(emitter_t& out, const sqltoast::interval_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::interval_qualifier_t& qualifier);
+void emit(emitter_t& out, const sqltoast::interval_term_t& term);
+void emit(emitter_t& out, const sqltoast::interval_value_expression_t& ie);
+void emit(emitter_t& out, const sqltoast::join_specification_t& spec);
+void emit(emitter_t& out, const sqltoast::joined_table_query_expression_t& qe);
+void emit(emitter_t& out, const sqltoast::join_target_t& jt);
+void emit(emitter_t& out, const sqltoast::length_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::like_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::match_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::non_join_query_expression_t& qe);
+void emit(emitter_t& out, const sqltoast::non_join_query_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::non_join_query_term_t& term);
+void emit(emitter_t& out, const sqltoast::nullif_function_t& func);
+void emit(emitter_t& out, const sqltoast::null_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::numeric_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::numeric_factor_t& factor);
+void emit(emitter_t& out, const sqltoast::numeric_function_t& func);
+void emit(emitter_t& out, const sqltoast::numeric_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::numeric_term_t& term);
+void emit(emitter_t& out, const sqltoast::numeric_value_t& value);
+void emit(emitter_t& out, const sqltoast::overlaps_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::parenthesized_value_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::position_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::quantified_comparison_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::query_expression_t& qe);
+void emit(emitter_t& out, const sqltoast::query_specification_non_join_query_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::query_specification_t& query);
+void emit(emitter_t& out, const sqltoast::row_value_constructor_element_t& rvce);
+void emit(emitter_t& out, const sqltoast::row_value_constructor_t& rvc);
+void emit(emitter_t& out, const sqltoast::row_value_expression_t& rve);
+void emit(emitter_t& out, const sqltoast::scalar_subquery_t& subq);
+void emit(emitter_t& out, const sqltoast::search_condition_t& sc);
+void emit(emitter_t& out, const sqltoast::searched_case_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::select_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::set_function_t& func);
+void emit(emitter_t& out, const sqltoast::simple_case_expression_t& expr);
+void emit(emitter_t& out, const sqltoast::statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::string_function_t& func);
+void emit(emitter_t& out, const sqltoast::substring_function_t& func);
+void emit(emitter_t& out, const sqltoast::table_t& t);
+void emit(emitter_t& out, const sqltoast::table_expression_t& table_exp);
+void emit(emitter_t& out, const sqltoast::table_reference_t& tr);
+void emit(emitter_t& out, const sqltoast::table_value_constructor_t& table_value);
+void emit(emitter_t& out, const sqltoast::table_value_constructor_non_join_query_primary_t& primary);
+void emit(emitter_t& out, const sqltoast::translate_function_t& func);
+void emit(emitter_t& out, const sqltoast::trim_function_t& func);
+void emit(emitter_t& out, const sqltoast::unique_predicate_t& pred);
+void emit(emitter_t& out, const sqltoast::update_statement_t& stmt);
+void emit(emitter_t& out, const sqltoast::value_expression_t& ve);
+void emit(emitter_t& out, const sqltoast::value_expression_primary_t& primary);
+
+} // namespace sqltoaster
+
+#endif /* SQLTOASTER_EMIT_H */
@@ -0,0 +1,1626 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <sqltoast/print.h>
+
+#include "../emit.h"
+
+namespace sqltoaster {
+
+void emit(emitter_t& out, const sqltoast::parse_result_t& res) {
+    // The tree of nodes isn't printed at all when there are no statements
+    if (res.statements.empty() && out.format == EMIT_FORMAT_YAML)
+        return;
+    out.start_document();
+    out.start_seq("statements");
+    for (const std::unique_ptr<sqltoast::statement_t>& stmt : res.statements) {
+        out.start_item_map();
+        emit(out, *stmt);
+        out.end_item_map();
+    }
+    out.end_seq();
+    out.end_document();
+}
+
+void emit(emitter_t& out, const sqltoast::statement_t& stmt) {
+    switch (stmt.type) {
+        case sqltoast::STATEMENT_TYPE_CREATE_SCHEMA:
+            out.attr("type", "CREATE_SCHEMA");
+            {
+                const sqltoast::create_schema_statement_t& sub =
+                    static_cast<const sqltoast::create_schema_statement_t&>(stmt);
+                out.start_map("create_schema_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_DROP_SCHEMA:
+            out.attr("type", "DROP_SCHEMA");
+            {
+                const sqltoast::drop_schema_statement_t& sub =
+                    static_cast<const sqltoast::drop_schema_statement_t&>(stmt);
+                out.start_map("drop_schema_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_CREATE_TABLE:
+            out.attr("type", "CREATE_TABLE");
+            {
+                const sqltoast::create_table_statement_t& sub =
+                    static_cast<const sqltoast::create_table_statement_t&>(stmt);
+                out.start_map("create_table_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_DROP_TABLE:
+            out.attr("type", "DROP_TABLE");
+            {
+                const sqltoast::drop_table_statement_t& sub =
+                    static_cast<const sqltoast::drop_table_statement_t&>(stmt);
+                out.start_map("drop_table_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_ALTER_TABLE:
+            out.attr("type", "ALTER_TABLE");
+            {
+                const sqltoast::alter_table_statement_t& sub =
+                    static_cast<const sqltoast::alter_table_statement_t&>(stmt);
+                out.start_map("alter_table_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_CREATE_VIEW:
+            out.attr("type", "CREATE_VIEW");
+            {
+                const sqltoast::create_view_statement_t& sub =
+                    static_cast<const sqltoast::create_view_statement_t&>(stmt);
+                out.start_map("create_view_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_DROP_VIEW:
+            out.attr("type", "DROP_VIEW");
+            {
+                const sqltoast::drop_view_statement_t& sub =
+                    static_cast<const sqltoast::drop_view_statement_t&>(stmt);
+                out.start_map("drop_view_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_SELECT:
+            out.attr("type", "SELECT");
+            {
+                const sqltoast::select_statement_t& sub =
+                    static_cast<const sqltoast::select_statement_t&>(stmt);
+                out.start_map("select_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_INSERT:
+            out.attr("type", "INSERT");
+            {
+                const sqltoast::insert_statement_t& sub =
+                    static_cast<const sqltoast::insert_statement_t&>(stmt);
+                out.start_map("insert_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_DELETE:
+            out.attr("type", "DELETE");
+            {
+                const sqltoast::delete_statement_t& sub =
+                    static_cast<const sqltoast::delete_statement_t&>(stmt);
+                out.start_map("delete_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_UPDATE:
+            out.attr("type", "UPDATE");
+            {
+                const sqltoast::update_statement_t& sub =
+                    static_cast<const sqltoast::update_statement_t&>(stmt);
+                out.start_map("update_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STATEMENT_TYPE_COMMIT:
+            out.attr("type", "COMMIT");
+            break;
+        case sqltoast::STATEMENT_TYPE_ROLLBACK:
+            out.attr("type", "ROLLBACK");
+            break;
+        case sqltoast::STATEMENT_TYPE_GRANT:
+            out.attr("type", "GRANT");
+            {
+                const sqltoast::grant_statement_t& sub =
+                    static_cast<const sqltoast::grant_statement_t&>(stmt);
+                out.start_map("grant_statement");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::create_schema_statement_t& stmt) {
+    out.attr("schema_name", stmt.schema_name);
+    if (stmt.authorization_identifier)
+        out.attr("authorization_identifier", stmt.authorization_identifier);
+    if (stmt.default_charset)
+        out.attr("default_charset", stmt.default_charset);
+}
+
+void emit(emitter_t& out, const sqltoast::drop_schema_statement_t& stmt) {
+    out.attr("schema_name", stmt.schema_name);
+    if (stmt.drop_behaviour == sqltoast::DROP_BEHAVIOUR_CASCADE)
+        out.attr("drop_behaviour", "CASCADE");
+    else
+        out.attr("drop_behaviour", "RESTRICT");
+}
+
+void emit(emitter_t& out, const sqltoast::create_table_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    if (stmt.table_type != sqltoast::TABLE_TYPE_NORMAL) {
+        if (stmt.table_type == sqltoast::TABLE_TYPE_TEMPORARY_GLOBAL)
+            out.attr("temporary", "GLOBAL");
+        else
+            out.attr("temporary", "LOCAL");
+    }
+    out.start_map("column_definitions");
+    for (auto cdef_it = stmt.column_definitions.cbegin();
+            cdef_it != stmt.column_definitions.cend();
+            cdef_it++) {
+        const sqltoast::column_definition_t& cdef = *(*cdef_it);
+        std::ostream& val = out.start_value(cdef.name);
+        if (cdef.data_type.get()) {
+            val << *cdef.data_type;
+        } else {
+            val << " UNKNOWN";
+        }
+        if (cdef.default_descriptor.get()) {
+            val << " " << *cdef.default_descriptor;
+        }
+        for (const std::unique_ptr<sqltoast::constraint_t>& c: cdef.constraints)
+            val << *c;
+        if (cdef.collate) {
+            val << " COLLATE "
+                << sqltoast::lexeme_text(cdef.collate, out.input);
+        }
+        out.end_value();
+    }
+    out.end_map();
+    if (stmt.constraints.size() > 0) {
+        out.start_seq("constraints");
+        for (auto constraint_it = stmt.constraints.begin();
+             constraint_it != stmt.constraints.end();
+             constraint_it++) {
+            out.start_item_value() << *(*constraint_it);
+            out.end_value();
+        }
+        out.end_seq();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::drop_table_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    if (stmt.drop_behaviour == sqltoast::DROP_BEHAVIOUR_CASCADE)
+        out.attr("drop_behaviour", "CASCADE");
+    else
+        out.attr("drop_behaviour", "RESTRICT");
+}
+
+void emit(emitter_t& out, const sqltoast::alter_table_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    out.start_value("action") << *stmt.action;
+    out.end_value();
+}
+
+void emit(emitter_t& out, const sqltoast::create_view_statement_t& stmt) {
+    out.attr("view_name", stmt.table_name);
+    if (! stmt.columns.empty()) {
+        out.start_seq("columns");
+        for (const auto& column : stmt.columns)
+            out.append(column);
+        out.end_seq();
+    }
+    if (stmt.check_option != sqltoast::CHECK_OPTION_NONE) {
+        if (stmt.check_option == sqltoast::CHECK_OPTION_LOCAL)
+            out.attr("check_option", "LOCAL");
+        else
+            out.attr("check_option", "CASCADED");
+    }
+    out.start_map("query");
+    emit(out, *stmt.query);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::query_specification_t& query) {
+    if (query.distinct)
+        out.attr("distinct", "true");
+    out.start_seq("selected_columns");
+    for (const sqltoast::derived_column_t& dc : query.selected_columns) {
+        out.start_item_map();
+        emit(out, dc);
+        out.end_item_map();
+    }
+    out.end_seq();
+    emit(out, *query.table_expression);
+}
+
+void emit(emitter_t& out, const sqltoast::derived_column_t& dc) {
+    if (dc.value) {
+        emit(out, *dc.value);
+        if (dc.alias)
+            out.attr("alias", dc.alias);
+    }
+    else
+        // NOTE(jaypipes): the * cannot be aliased in a production
+        out.attr("asterisk", "true");
+}
+
+void emit(emitter_t& out, const sqltoast::table_expression_t& table_exp) {
+    out.start_seq("referenced_tables");
+    for (const std::unique_ptr<sqltoast::table_reference_t>& tr : table_exp.referenced_tables) {
+        out.start_item_map();
+        emit(out, *tr);
+        out.end_item_map();
+    }
+    out.end_seq();
+    if (table_exp.where_condition) {
+        out.start_map("where");
+        emit(out, *table_exp.where_condition);
+        out.end_map();
+    }
+    if (! table_exp.group_by_columns.empty()) {
+        out.start_seq("group_by");
+        for (const sqltoast::grouping_column_reference_t& gcr : table_exp.group_by_columns) {
+            out.start_item_value() << gcr;
+            out.end_value();
+        }
+        out.end_seq();
+    }
+    if (table_exp.having_condition) {
+        out.start_map("having");
+        emit(out, *table_exp.having_condition);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::query_expression_t& qe) {
+    switch (qe.query_expression_type) {
+        case sqltoast::QUERY_EXPRESSION_TYPE_NON_JOIN_QUERY_EXPRESSION:
+            {
+                const sqltoast::non_join_query_expression_t& sub =
+                    static_cast<const sqltoast::non_join_query_expression_t&>(qe);
+                emit(out, sub);
+            }
+            break;
+        case sqltoast::QUERY_EXPRESSION_TYPE_JOINED_TABLE:
+            {
+                const sqltoast::joined_table_query_expression_t& sub =
+                    static_cast<const sqltoast::joined_table_query_expression_t&>(qe);
+                emit(out, sub);
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::non_join_query_expression_t& qe) {
+    emit(out, *qe.term);
+}
+
+void emit(emitter_t& out, const sqltoast::non_join_query_term_t& term) {
+    emit(out, *term.primary);
+}
+
+void emit(emitter_t& out, const sqltoast::non_join_query_primary_t& primary) {
+    switch (primary.primary_type) {
+        case sqltoast::NON_JOIN_QUERY_PRIMARY_TYPE_QUERY_SPECIFICATION:
+            {
+                const sqltoast::query_specification_non_join_query_primary_t& sub =
+                    static_cast<const sqltoast::query_specification_non_join_query_primary_t&>(primary);
+                emit(out, sub);
+            }
+            break;
+        case sqltoast::NON_JOIN_QUERY_PRIMARY_TYPE_TABLE_VALUE_CONSTRUCTOR:
+            {
+                const sqltoast::table_value_constructor_non_join_query_primary_t& sub =
+                    static_cast<const sqltoast::table_value_constructor_non_join_query_primary_t&>(primary);
+                emit(out, sub);
+            }
+            break;
+        case sqltoast::NON_JOIN_QUERY_PRIMARY_TYPE_EXPLICIT_TABLE:
+        case sqltoast::NON_JOIN_QUERY_PRIMARY_TYPE_SUBEXPRESSION:
+            // TODO
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::query_specification_non_join_query_primary_t& primary) {
+    emit(out, *primary.query_spec);
+}
+
+void emit(emitter_t& out, const sqltoast::table_value_constructor_non_join_query_primary_t& primary) {
+    emit(out, *primary.table_value);
+}
+
+void emit(emitter_t& out, const sqltoast::table_value_constructor_t& table_value) {
+    out.start_seq("values");
+    for (const std::unique_ptr<sqltoast::row_value_constructor_t>& value : table_value.values) {
+        out.start_item_map();
+        emit(out, *value);
+        out.end_item_map();
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::joined_table_query_expression_t& qe) {
+    emit(out, *qe.joined_table);
+}
+
+void emit(emitter_t& out, const sqltoast::table_reference_t& tr) {
+    switch (tr.type) {
+        case sqltoast::TABLE_REFERENCE_TYPE_TABLE:
+            out.attr("type", "TABLE");
+            {
+                const sqltoast::table_t& sub =
+                    static_cast<const sqltoast::table_t&>(tr);
+                out.start_map("table");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::TABLE_REFERENCE_TYPE_DERIVED_TABLE:
+            out.attr("type", "DERIVED_TABLE");
+            {
+                const sqltoast::derived_table_t& sub =
+                    static_cast<const sqltoast::derived_table_t&>(tr);
+                out.start_map("derived_table");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+    if (tr.joined) {
+        out.start_map("joined");
+        emit(out, *tr.joined);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::table_t& t) {
+    out.attr("name", t.table_name);
+    if (t.has_alias())
+        out.attr("alias", t.correlation_spec->alias);
+}
+
+void emit(emitter_t& out, const sqltoast::derived_table_t& t) {
+    // NOTE(jaypipes): derived tables always have a <correlation spec> which
+    // contains an alias attribute
+    out.attr("name", t.correlation_spec.alias);
+    out.start_map("query");
+    emit(out, *t.query);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::join_target_t& jt) {
+    switch (jt.join_type) {
+        case sqltoast::JOIN_TYPE_INNER:
+            out.attr("type", "INNER_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_LEFT:
+            out.attr("type", "LEFT_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_RIGHT:
+            out.attr("type", "RIGHT_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_FULL:
+            out.attr("type", "FULL_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_CROSS:
+            out.attr("type", "CROSS_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_NATURAL:
+            out.attr("type", "NATURAL_JOIN");
+            break;
+        case sqltoast::JOIN_TYPE_UNION:
+            out.attr("type", "UNION_JOIN");
+            break;
+        default:
+            break;
+    }
+    out.start_map("table_reference");
+    emit(out, *jt.table_ref);
+    out.end_map();
+    if (jt.join_spec) {
+        out.start_map("specification");
+        emit(out, *jt.join_spec);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::join_specification_t& spec) {
+    if (spec.condition) {
+        out.start_map("on");
+        emit(out, *spec.condition);
+        out.end_map();
+    } else if (! spec.named_columns.empty()) {
+        out.start_seq("using");
+        for (const sqltoast::lexeme_t& col : spec.named_columns)
+            out.append(col);
+        out.end_seq();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::drop_view_statement_t& stmt) {
+    out.attr("view_name", stmt.table_name);
+    if (stmt.drop_behaviour == sqltoast::DROP_BEHAVIOUR_CASCADE)
+        out.attr("drop_behaviour", "CASCADE");
+    else
+        out.attr("drop_behaviour", "RESTRICT");
+}
+
+void emit(emitter_t& out, const sqltoast::select_statement_t& stmt) {
+    out.start_map("query");
+    emit(out, *stmt.query);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::insert_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    if (! stmt.insert_columns.empty()) {
+        out.start_seq("columns");
+        for (const sqltoast::lexeme_t& col : stmt.insert_columns)
+            out.append(col);
+        out.end_seq();
+    }
+    if (stmt.query) {
+        out.start_map("query");
+        emit(out, *stmt.query);
+        out.end_map();
+    } else {
+        out.attr("default_values", "true");
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::delete_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    if (stmt.where_condition) {
+        out.start_map("where");
+        emit(out, *stmt.where_condition);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::update_statement_t& stmt) {
+    out.attr("table_name", stmt.table_name);
+    out.start_map("set_columns");
+    for (const sqltoast::set_column_t& set_col : stmt.set_columns) {
+        if (set_col.type == sqltoast::SET_COLUMN_TYPE_NULL)
+            out.attr(set_col.column_name, "NULL");
+        else if (set_col.type == sqltoast::SET_COLUMN_TYPE_DEFAULT)
+            out.attr(set_col.column_name, "DEFAULT");
+        else {
+            out.start_value(set_col.column_name) << *set_col.value;
+            out.end_value();
+        }
+    }
+    out.end_map();
+
+    if (stmt.where_condition) {
+        out.start_map("where");
+        emit(out, *stmt.where_condition);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::grant_statement_t& stmt) {
+    std::ostream& val = out.start_value("on");
+    switch (stmt.object_type) {
+        case sqltoast::GRANT_OBJECT_TYPE_TABLE:
+            break;
+        case sqltoast::GRANT_OBJECT_TYPE_DOMAIN:
+            val << "DOMAIN ";
+            break;
+        case sqltoast::GRANT_OBJECT_TYPE_COLLATION:
+            val << "COLLATION ";
+            break;
+        case sqltoast::GRANT_OBJECT_TYPE_CHARACTER_SET:
+            val << "CHARACTER SET ";
+            break;
+        case sqltoast::GRANT_OBJECT_TYPE_TRANSLATION:
+            val << "TRANSLATION ";
+            break;
+    }
+    val << sqltoast::lexeme_text(stmt.on, out.input);
+    out.end_value();
+    if (stmt.to_public())
+        out.attr("to", "PUBLIC");
+    else
+        out.attr("to", stmt.to);
+    if (stmt.with_grant_option)
+        out.attr("with_grant_option", "YES");
+    out.start_seq("privileges");
+    if (stmt.all_privileges())
+        out.append("ALL");
+    else {
+        for (const std::unique_ptr<sqltoast::grant_action_t>& action : stmt.privileges) {
+            out.start_item_value() << *action;
+            out.end_value();
+        }
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::search_condition_t& sc) {
+    // OR'd operands are on the same "level" as each other for evaluation
+    // purposes, which is why we don't attempt to indent here and just
+    // output the terms in a list
+    out.start_seq("terms");
+    for (const std::unique_ptr<sqltoast::boolean_term_t>& or_term_p : sc.terms) {
+        out.start_item_map();
+        emit(out, *or_term_p);
+        out.end_item_map();
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::predicate_t& pred) {
+    switch (pred.predicate_type) {
+        case sqltoast::PREDICATE_TYPE_COMPARISON:
+            out.attr("type", "COMPARISON");
+            {
+                const sqltoast::comp_predicate_t& sub =
+                    static_cast<const sqltoast::comp_predicate_t&>(pred);
+                out.start_map("comparison_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_BETWEEN:
+            out.attr("type", "BETWEEN");
+            {
+                const sqltoast::between_predicate_t& sub =
+                    static_cast<const sqltoast::between_predicate_t&>(pred);
+                out.start_map("between_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_LIKE:
+            out.attr("type", "LIKE");
+            {
+                const sqltoast::like_predicate_t& sub =
+                    static_cast<const sqltoast::like_predicate_t&>(pred);
+                out.start_map("like_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_NULL:
+            out.attr("type", "NULL");
+            {
+                const sqltoast::null_predicate_t& sub =
+                    static_cast<const sqltoast::null_predicate_t&>(pred);
+                out.start_map("null_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_IN_VALUES:
+            out.attr("type", "IN_VALUES");
+            {
+                const sqltoast::in_values_predicate_t& sub =
+                    static_cast<const sqltoast::in_values_predicate_t&>(pred);
+                out.start_map("in_values_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_IN_SUBQUERY:
+            out.attr("type", "IN_SUBQUERY");
+            {
+                const sqltoast::in_subquery_predicate_t& sub =
+                    static_cast<const sqltoast::in_subquery_predicate_t&>(pred);
+                out.start_map("in_subquery_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_QUANTIFIED_COMPARISON:
+            out.attr("type", "QUANTIFIED_COMPARISON");
+            {
+                const sqltoast::quantified_comparison_predicate_t& sub =
+                    static_cast<const sqltoast::quantified_comparison_predicate_t&>(pred);
+                out.start_map("quantified_comparison_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_EXISTS:
+            out.attr("type", "EXISTS");
+            {
+                const sqltoast::exists_predicate_t& sub =
+                    static_cast<const sqltoast::exists_predicate_t&>(pred);
+                out.start_map("exists_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_UNIQUE:
+            out.attr("type", "UNIQUE");
+            {
+                const sqltoast::unique_predicate_t& sub =
+                    static_cast<const sqltoast::unique_predicate_t&>(pred);
+                out.start_map("unique_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_MATCH:
+            out.attr("type", "MATCH");
+            {
+                const sqltoast::match_predicate_t& sub =
+                    static_cast<const sqltoast::match_predicate_t&>(pred);
+                out.start_map("match_predicate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::PREDICATE_TYPE_OVERLAPS:
+            {
+                const sqltoast::overlaps_predicate_t& sub =
+                    static_cast<const sqltoast::overlaps_predicate_t&>(pred);
+                // NOTE: the tree of nodes has the type inside the predicate's
+                // own mapping, so it is emitted there too
+                out.start_map("overlaps_predicate");
+                out.attr("type", "OVERLAPS");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::comp_op_t& op) {
+    switch (op) {
+        case sqltoast::COMP_OP_EQUAL:
+            out.attr("op", "EQUAL");
+            break;
+        case sqltoast::COMP_OP_NOT_EQUAL:
+            out.attr("op", "NOT_EQUAL");
+            break;
+        case sqltoast::COMP_OP_LESS:
+            out.attr("op", "LESS_THAN");
+            break;
+        case sqltoast::COMP_OP_GREATER:
+            out.attr("op", "GREATER_THAN");
+            break;
+        case sqltoast::COMP_OP_LESS_EQUAL:
+            out.attr("op", "LESS_THAN_OR_EQUAL");
+            break;
+        case sqltoast::COMP_OP_GREATER_EQUAL:
+            out.attr("op", "GREATER_THAN_OR_EQUAL");
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::comp_predicate_t& pred) {
+    emit(out, pred.op);
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    out.start_map("right");
+    emit(out, *pred.right);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::between_predicate_t& pred) {
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    out.start_map("comp_left");
+    emit(out, *pred.comp_left);
+    out.end_map();
+    out.start_map("comp_right");
+    emit(out, *pred.comp_right);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::like_predicate_t& pred) {
+    out.start_map("match");
+    emit(out, *pred.match);
+    out.end_map();
+    if (pred.reverse_op)
+        out.attr("negate", "true");
+    const sqltoast::character_value_expression_t& pattern_val =
+        static_cast<const sqltoast::character_value_expression_t&>(*pred.pattern);
+    out.start_map("pattern");
+    emit(out, pattern_val);
+    out.end_map();
+    if (pred.escape_char) {
+        const sqltoast::character_value_expression_t& escape_char_val =
+            static_cast<const sqltoast::character_value_expression_t&>(*pred.escape_char);
+        out.start_map("escape_char");
+        emit(out, escape_char_val);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::null_predicate_t& pred) {
+    if (pred.reverse_op)
+        out.attr("negate", "true");
+}
+
+void emit(emitter_t& out, const sqltoast::in_values_predicate_t& pred) {
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    if (pred.reverse_op)
+        out.attr("negate", "true");
+    out.start_seq("values");
+    for (auto& ve : pred.values) {
+        out.start_item_map();
+        emit(out, *ve);
+        out.end_item_map();
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::in_subquery_predicate_t& pred) {
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    out.start_map("query");
+    emit(out, *pred.subquery);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::quantified_comparison_predicate_t& pred) {
+    emit(out, pred.op);
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    if (pred.quantifier == sqltoast::QUANTIFIER_ALL)
+        out.attr("quantifier", "ALL");
+    else
+        out.attr("quantifier", "ANY");
+    out.start_map("query");
+    emit(out, *pred.subquery);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::exists_predicate_t& pred) {
+    out.start_map("query");
+    emit(out, *pred.subquery);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::unique_predicate_t& pred) {
+    out.start_map("query");
+    emit(out, *pred.subquery);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::match_predicate_t& pred) {
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    if (pred.match_unique)
+        out.attr("unique", "true");
+    if (pred.match_partial)
+        out.attr("partial", "true");
+    out.start_map("query");
+    emit(out, *pred.subquery);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::overlaps_predicate_t& pred) {
+    out.start_map("left");
+    emit(out, *pred.left);
+    out.end_map();
+    out.start_map("right");
+    emit(out, *pred.right);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::boolean_primary_t& bp) {
+    if (bp.predicate) {
+        out.start_map("predicate");
+        emit(out, *bp.predicate);
+        out.end_map();
+    }
+    else {
+        out.start_map("search_condition");
+        emit(out, *bp.search_condition);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::boolean_factor_t& bf) {
+    emit(out, *bf.primary);
+    if (bf.reverse_op)
+        out.attr("negate", "true");
+}
+
+void emit(emitter_t& out, const sqltoast::boolean_term_t& bt) {
+    out.start_map("factor");
+    emit(out, *bt.factor);
+    if (bt.and_operand) {
+        out.start_map("and");
+        emit(out, *bt.and_operand);
+        out.end_map();
+    }
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::row_value_constructor_t& rvc) {
+    switch (rvc.rvc_type) {
+        case sqltoast::RVC_TYPE_ELEMENT:
+            out.attr("type", "ELEMENT");
+            {
+                const sqltoast::row_value_constructor_element_t& sub =
+                    static_cast<const sqltoast::row_value_constructor_element_t&>(rvc);
+                out.start_map("element");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::RVC_TYPE_LIST:
+            out.attr("type", "LIST");
+            {
+                const sqltoast::row_value_constructor_list_t& sub =
+                    static_cast<const sqltoast::row_value_constructor_list_t&>(rvc);
+                out.start_seq("elements");
+                for (const auto& rvc_el : sub.elements) {
+                    const sqltoast::row_value_constructor_element_t& el =
+                        static_cast<const sqltoast::row_value_constructor_element_t&>(*rvc_el);
+                    out.start_item_map();
+                    emit(out, el);
+                    out.end_item_map();
+                }
+                out.end_seq();
+            }
+            break;
+        case sqltoast::RVC_TYPE_SUBQUERY:
+            // TODO
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::row_value_constructor_element_t& rvce) {
+    switch (rvce.rvc_element_type) {
+        case sqltoast::RVC_ELEMENT_TYPE_DEFAULT:
+            out.attr("type", "DEFAULT");
+            break;
+        case sqltoast::RVC_ELEMENT_TYPE_NULL:
+            out.attr("type", "NULL");
+            break;
+        case sqltoast::RVC_ELEMENT_TYPE_VALUE_EXPRESSION:
+            out.attr("type", "VALUE_EXPRESSION");
+            {
+                const sqltoast::row_value_expression_t& val =
+                    static_cast<const sqltoast::row_value_expression_t&>(rvce);
+                out.start_map("value_expression");
+                emit(out, val);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::row_value_expression_t& rve) {
+    // row_value_expressions only have a single attribute -- the value, so just
+    // pass through to that and condense the output accordingly
+    emit(out, *rve.value);
+}
+
+void emit(emitter_t& out, const sqltoast::value_expression_t& ve) {
+    switch (ve.type) {
+        case sqltoast::VALUE_EXPRESSION_TYPE_NUMERIC_EXPRESSION:
+            out.attr("type", "NUMERIC_EXPRESSION");
+            {
+                const sqltoast::numeric_expression_t& sub =
+                    static_cast<const sqltoast::numeric_expression_t&>(ve);
+                out.start_map("numeric_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VALUE_EXPRESSION_TYPE_STRING_EXPRESSION:
+            out.attr("type", "STRING_EXPRESSION");
+            {
+                const sqltoast::character_value_expression_t& sub =
+                    static_cast<const sqltoast::character_value_expression_t&>(ve);
+                out.start_map("string_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VALUE_EXPRESSION_TYPE_DATETIME_EXPRESSION:
+            out.attr("type", "DATETIME_EXPRESSION");
+            {
+                const sqltoast::datetime_value_expression_t& sub =
+                    static_cast<const sqltoast::datetime_value_expression_t&>(ve);
+                out.start_map("datetime_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION:
+            out.attr("type", "INTERVAL_EXPRESSION");
+            {
+                const sqltoast::interval_value_expression_t& sub =
+                    static_cast<const sqltoast::interval_value_expression_t&>(ve);
+                out.start_map("interval_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_expression_t& ne) {
+    out.start_map("left");
+    emit(out, *ne.left);
+    out.end_map();
+    if (ne.right) {
+        if (ne.op == sqltoast::NUMERIC_OP_ADD)
+            out.attr("op", "ADD");
+        else
+            out.attr("op", "SUBTRACT");
+        out.start_map("right");
+        emit(out, *ne.right);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_term_t& term) {
+    out.start_map("left");
+    emit(out, *term.left);
+    out.end_map();
+    if (term.right) {
+        if (term.op == sqltoast::NUMERIC_OP_MULTIPLY)
+            out.attr("op", "MULTIPLY");
+        else
+            out.attr("op", "DIVIDE");
+        out.start_map("right");
+        emit(out, *term.right);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_factor_t& factor) {
+    if (factor.sign != 0) {
+        out.start_value("sign") << (factor.sign < 0 ? '-' : '+');
+        out.end_value();
+    }
+    out.start_map("primary");
+    emit(out, *factor.primary);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_primary_t& primary) {
+    switch (primary.type) {
+        case sqltoast::NUMERIC_PRIMARY_TYPE_VALUE:
+            out.attr("type", "VALUE");
+            {
+                const sqltoast::numeric_value_t& sub =
+                    static_cast<const sqltoast::numeric_value_t&>(primary);
+                out.start_map("value");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::NUMERIC_PRIMARY_TYPE_FUNCTION:
+            out.attr("type", "FUNCTION");
+            {
+                const sqltoast::numeric_function_t& sub =
+                    static_cast<const sqltoast::numeric_function_t&>(primary);
+                out.start_map("function");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_value_t& value) {
+    out.start_map("primary");
+    emit(out, *value.primary);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::value_expression_primary_t& primary) {
+    switch (primary.vep_type) {
+        case sqltoast::VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION:
+            out.attr("type", "UNSIGNED_VALUE_SPECIFICATION");
+            {
+                const sqltoast::unsigned_value_specification_t& sub =
+                    static_cast<const sqltoast::unsigned_value_specification_t&>(primary);
+                out.start_value("unsigned_value_specification") << sub;
+                out.end_value();
+            }
+            break;
+        case sqltoast::VEP_TYPE_COLUMN_REFERENCE:
+            out.attr("type", "COLUMN_REFERENCE");
+            out.attr("column_reference", primary.lexeme);
+            break;
+        case sqltoast::VEP_TYPE_SET_FUNCTION_SPECIFICATION:
+            out.attr("type", "SET_FUNCTION_SPECIFICATION");
+            {
+                const sqltoast::set_function_t& sub =
+                    static_cast<const sqltoast::set_function_t&>(primary);
+                out.start_map("set_function_specification");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VEP_TYPE_PARENTHESIZED_VALUE_EXPRESSION:
+            out.attr("type", "PARENTHESIZED_VALUE_EXPRESSION");
+            {
+                const sqltoast::parenthesized_value_expression_t& sub =
+                    static_cast<const sqltoast::parenthesized_value_expression_t&>(primary);
+                out.start_map("parenthesized_value_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VEP_TYPE_CASE_EXPRESSION:
+            out.attr("type", "CASE_EXPRESSION");
+            {
+                const sqltoast::case_expression_t& sub =
+                    static_cast<const sqltoast::case_expression_t&>(primary);
+                out.start_map("case_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::VEP_TYPE_SCALAR_SUBQUERY:
+            out.attr("type", "SCALAR_SUBQUERY");
+            {
+                const sqltoast::scalar_subquery_t& sub =
+                    static_cast<const sqltoast::scalar_subquery_t&>(primary);
+                out.start_map("scalar_subquery");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::set_function_t& func) {
+    switch (func.func_type) {
+        case sqltoast::SET_FUNCTION_TYPE_COUNT:
+            out.attr("type", "COUNT");
+            break;
+        case sqltoast::SET_FUNCTION_TYPE_AVG:
+            out.attr("type", "AVG");
+            break;
+        case sqltoast::SET_FUNCTION_TYPE_MIN:
+            out.attr("type", "MIN");
+            break;
+        case sqltoast::SET_FUNCTION_TYPE_MAX:
+            out.attr("type", "MAX");
+            break;
+        case sqltoast::SET_FUNCTION_TYPE_SUM:
+            out.attr("type", "SUM");
+            break;
+    }
+    if (func.star)
+        out.attr("star", "true");
+    if (func.distinct)
+        out.attr("distinct", "true");
+    if (func.value) {
+        out.start_map("value");
+        emit(out, *func.value);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::parenthesized_value_expression_t& expr) {
+    out.start_map("value");
+    emit(out, *expr.value);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::case_expression_t& expr) {
+    switch (expr.case_type) {
+        case sqltoast::CASE_EXPRESSION_TYPE_COALESCE_FUNCTION:
+            out.attr("type", "COALESCE_FUNCTION");
+            {
+                const sqltoast::coalesce_function_t& sub =
+                    static_cast<const sqltoast::coalesce_function_t&>(expr);
+                out.start_map("coalesce_function");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::CASE_EXPRESSION_TYPE_NULLIF_FUNCTION:
+            out.attr("type", "NULLIF_FUNCTION");
+            {
+                const sqltoast::nullif_function_t& sub =
+                    static_cast<const sqltoast::nullif_function_t&>(expr);
+                out.start_map("nullif_function");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::CASE_EXPRESSION_TYPE_SIMPLE_CASE:
+            out.attr("type", "SIMPLE_CASE_EXPRESSION");
+            {
+                const sqltoast::simple_case_expression_t& sub =
+                    static_cast<const sqltoast::simple_case_expression_t&>(expr);
+                out.start_map("simple_case_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::CASE_EXPRESSION_TYPE_SEARCHED_CASE:
+            out.attr("type", "SEARCHED_CASE_EXPRESSION");
+            {
+                const sqltoast::searched_case_expression_t& sub =
+                    static_cast<const sqltoast::searched_case_expression_t&>(expr);
+                out.start_map("searched_case_expression");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::coalesce_function_t& func) {
+    out.start_seq("values");
+    for (const auto& val : func.values) {
+        out.start_item_map();
+        emit(out, *val);
+        out.end_item_map();
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::nullif_function_t& func) {
+    out.start_map("left");
+    emit(out, *func.left);
+    out.end_map();
+    out.start_map("right");
+    emit(out, *func.right);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::simple_case_expression_t& expr) {
+    out.start_map("operand");
+    emit(out, *expr.operand);
+    out.end_map();
+    out.start_seq("when_clauses");
+    for (const auto& when_clause : expr.when_clauses) {
+        out.start_item_map();
+        out.start_map("operand");
+        emit(out, *when_clause.operand);
+        out.end_map();
+        out.start_map("result");
+        emit(out, *when_clause.result);
+        out.end_map();
+        out.end_item_map();
+    }
+    out.end_seq();
+    if (expr.else_value) {
+        out.start_map("else");
+        emit(out, *expr.else_value);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::searched_case_expression_t& expr) {
+    out.start_seq("when_clauses");
+    for (const auto& when_clause : expr.when_clauses) {
+        out.start_item_map();
+        out.start_map("condition");
+        emit(out, *when_clause.condition);
+        out.end_map();
+        out.start_map("result");
+        emit(out, *when_clause.result);
+        out.end_map();
+        out.end_item_map();
+    }
+    out.end_seq();
+    if (expr.else_value) {
+        out.start_map("else");
+        emit(out, *expr.else_value);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::scalar_subquery_t& subq) {
+    out.start_map("query");
+    emit(out, *subq.query);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::numeric_function_t& func) {
+    switch (func.type) {
+        case sqltoast::NUMERIC_FUNCTION_TYPE_POSITION:
+            out.attr("type", "POSITION");
+            {
+                const sqltoast::position_expression_t& sub =
+                    static_cast<const sqltoast::position_expression_t&>(func);
+                out.start_map("char_position");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::NUMERIC_FUNCTION_TYPE_EXTRACT:
+            out.attr("type", "EXTRACT");
+            {
+                const sqltoast::extract_expression_t& sub =
+                    static_cast<const sqltoast::extract_expression_t&>(func);
+                out.start_map("extract");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::NUMERIC_FUNCTION_TYPE_CHAR_LENGTH:
+            out.attr("type", "CHAR_LENGTH");
+            {
+                const sqltoast::length_expression_t& sub =
+                    static_cast<const sqltoast::length_expression_t&>(func);
+                out.start_map("char_length");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::NUMERIC_FUNCTION_TYPE_BIT_LENGTH:
+            out.attr("type", "BIT_LENGTH");
+            {
+                const sqltoast::length_expression_t& sub =
+                    static_cast<const sqltoast::length_expression_t&>(func);
+                out.start_map("bit_length");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::NUMERIC_FUNCTION_TYPE_OCTET_LENGTH:
+            out.attr("type", "OCTET_LENGTH");
+            {
+                const sqltoast::length_expression_t& sub =
+                    static_cast<const sqltoast::length_expression_t&>(func);
+                out.start_map("octet_length");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::length_expression_t& expr) {
+    out.start_map("operand");
+    emit(out, *expr.operand);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::position_expression_t& expr) {
+    out.start_map("find");
+    emit(out, *expr.to_find);
+    out.end_map();
+    out.start_map("in");
+    emit(out, *expr.subject);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::extract_expression_t& expr) {
+    out.start_value("field") << expr.extract_field;
+    out.end_value();
+    out.start_map("source");
+    emit(out, *expr.extract_source);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::character_value_expression_t& cve) {
+    out.start_seq("factors");
+    for (const std::unique_ptr<sqltoast::character_factor_t>& factor : cve.values) {
+        out.start_item_map();
+        emit(out, *factor);
+        out.end_item_map();
+    }
+    out.end_seq();
+}
+
+void emit(emitter_t& out, const sqltoast::character_factor_t& factor) {
+    out.start_map("primary");
+    emit(out, *factor.primary);
+    out.end_map();
+    if (factor.collation)
+        out.attr("collation", factor.collation);
+}
+
+void emit(emitter_t& out, const sqltoast::character_primary_t& primary) {
+    if (primary.value) {
+        out.start_map("value");
+        emit(out, *primary.value);
+        out.end_map();
+    }
+    else {
+        out.start_map("function");
+        emit(out, *primary.string_function);
+        out.end_map();
+    }
+}
+
+// Emits the type and operand shared by every string function
+static void emit_string_function(
+        emitter_t& out,
+        const char* type,
+        const sqltoast::string_function_t& func) {
+    const sqltoast::character_value_expression_t& operand =
+        static_cast<const sqltoast::character_value_expression_t&>(*func.operand);
+    out.attr("type", type);
+    out.start_map("operand");
+    emit(out, operand);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::string_function_t& func) {
+    switch (func.type) {
+        case sqltoast::STRING_FUNCTION_TYPE_SUBSTRING:
+            emit_string_function(out, "SUBSTRING", func);
+            {
+                const sqltoast::substring_function_t& sub =
+                    static_cast<const sqltoast::substring_function_t&>(func);
+                out.start_map("substring");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STRING_FUNCTION_TYPE_UPPER:
+            emit_string_function(out, "UPPER", func);
+            break;
+        case sqltoast::STRING_FUNCTION_TYPE_LOWER:
+            emit_string_function(out, "LOWER", func);
+            break;
+        case sqltoast::STRING_FUNCTION_TYPE_CONVERT:
+            emit_string_function(out, "CONVERT", func);
+            {
+                const sqltoast::convert_function_t& sub =
+                    static_cast<const sqltoast::convert_function_t&>(func);
+                out.start_map("convert");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STRING_FUNCTION_TYPE_TRANSLATE:
+            emit_string_function(out, "TRANSLATE", func);
+            {
+                const sqltoast::translate_function_t& sub =
+                    static_cast<const sqltoast::translate_function_t&>(func);
+                out.start_map("translate");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::STRING_FUNCTION_TYPE_TRIM:
+            emit_string_function(out, "TRIM", func);
+            {
+                const sqltoast::trim_function_t& sub =
+                    static_cast<const sqltoast::trim_function_t&>(func);
+                out.start_map("trim");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        default:
+            // TODO
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::substring_function_t& func) {
+    const sqltoast::numeric_expression_t& start_pos_val =
+        static_cast<sqltoast::numeric_expression_t&>(*func.start_position_value);
+    out.start_map("start_position");
+    emit(out, start_pos_val);
+    out.end_map();
+    if (func.for_length_value) {
+        const sqltoast::numeric_expression_t& for_length_val =
+            static_cast<sqltoast::numeric_expression_t&>(*func.for_length_value);
+        out.start_map("for_length");
+        emit(out, for_length_val);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::convert_function_t& func) {
+    out.attr("using", func.conversion_name);
+}
+
+void emit(emitter_t& out, const sqltoast::translate_function_t& func) {
+    out.attr("using", func.translation_name);
+}
+
+void emit(emitter_t& out, const sqltoast::trim_function_t& func) {
+    switch (func.specification) {
+        case sqltoast::TRIM_SPECIFICATION_LEADING:
+            out.attr("specification", "LEADING");
+            break;
+        case sqltoast::TRIM_SPECIFICATION_TRAILING:
+            out.attr("specification", "TRAILING");
+            break;
+        default:
+            out.attr("specification", "BOTH");
+            break;
+    }
+    if (func.trim_character) {
+        const sqltoast::character_value_expression_t& trim_char_val =
+            static_cast<sqltoast::character_value_expression_t&>(*func.trim_character);
+        out.start_map("trim_character");
+        emit(out, trim_char_val);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_value_expression_t& de) {
+    out.start_map("left");
+    emit(out, *de.left);
+    out.end_map();
+    if (de.right) {
+        if (de.op == sqltoast::NUMERIC_OP_ADD)
+            out.attr("op", "ADD");
+        else
+            out.attr("op", "SUBTRACT");
+        out.start_map("right");
+        emit(out, *de.right);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_term_t& term) {
+    out.start_map("factor");
+    emit(out, *term.value); // TODO this should be term.factor...
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_factor_t& factor) {
+    if (factor.is_local_tz())
+        out.attr("time_zone", "LOCAL");
+    else
+        out.attr("time_zone", factor.tz);
+    out.start_map("primary");
+    emit(out, *factor.primary);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_primary_t& primary) {
+    switch (primary.type) {
+        case sqltoast::DATETIME_PRIMARY_TYPE_VALUE:
+            out.attr("type", "VALUE");
+            {
+                const sqltoast::datetime_value_t& sub =
+                    static_cast<const sqltoast::datetime_value_t&>(primary);
+                out.start_map("value");
+                emit(out, sub);
+                out.end_map();
+            }
+            break;
+        case sqltoast::DATETIME_PRIMARY_TYPE_FUNCTION:
+            out.attr("type", "FUNCTION");
+            {
+                const sqltoast::current_datetime_function_t& sub =
+                    static_cast<const sqltoast::current_datetime_function_t&>(primary);
+                out.start_value("function") << sub;
+                out.end_value();
+            }
+            break;
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_value_t& value) {
+    out.start_map("primary");
+    emit(out, *value.primary);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::datetime_field_t& field) {
+    out.start_value("interval") << field.interval;
+    out.end_value();
+    if (field.interval != sqltoast::INTERVAL_UNIT_SECOND) {
+        if (field.precision > 0) {
+            out.start_value("leading_precision") << field.precision;
+            out.end_value();
+        }
+    } else {
+        // We can have 0 leading precision and non-zero fractional precision
+        // for second intervals...
+        if (field.precision > 0 ||
+                (field.precision == 0 && field.fractional_precision > 0)) {
+            out.start_value("leading_precision") << field.precision;
+            out.end_value();
+            if (field.fractional_precision > 0) {
+                out.start_value("fractional_precision") << field.fractional_precision;
+                out.end_value();
+            }
+        }
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::interval_value_expression_t& expr) {
+    out.start_map("left");
+    emit(out, *expr.left);
+    out.end_map();
+    if (expr.right) {
+        if (expr.op == sqltoast::NUMERIC_OP_ADD)
+            out.attr("op", "ADD");
+        else
+            out.attr("op", "SUBTRACT");
+        out.start_map("right");
+        emit(out, *expr.right);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::interval_term_t& term) {
+    out.start_map("left");
+    emit(out, *term.left);
+    out.end_map();
+    if (term.right) {
+        if (term.op == sqltoast::NUMERIC_OP_MULTIPLY)
+            out.attr("op", "MULTIPLY");
+        else
+            out.attr("op", "DIVIDE");
+        // NOTE: the tree of nodes repeats the left operand here rather than
+        // giving the right one, and the two outputs are kept the same
+        out.start_map("left");
+        emit(out, *term.left);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::interval_factor_t& factor) {
+    if (factor.sign != 0) {
+        out.start_value("sign") << (factor.sign < 0 ? '-' : '+');
+        out.end_value();
+    }
+    out.start_map("primary");
+    emit(out, *factor.primary);
+    out.end_map();
+}
+
+void emit(emitter_t& out, const sqltoast::interval_primary_t& primary) {
+    out.start_map("value");
+    emit(out, *primary.value);
+    out.end_map();
+    if (primary.qualifier) {
+        out.start_map("qualifier");
+        emit(out, *primary.qualifier);
+        out.end_map();
+    }
+}
+
+void emit(emitter_t& out, const sqltoast::interval_qualifier_t& qualifier) {
+    out.start_map("start");
+    emit(out, qualifier.start);
+    out.end_map();
+    if (qualifier.end) {
+        out.start_map("end");
+        emit(out, *qualifier.end);
+        out.end_map();
+    }
+}
+
+} // namespace sqltoaster
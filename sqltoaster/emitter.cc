@@ -0,0 +1,71 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "emitter.h"
+
+namespace sqltoaster {
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+void emitter_t::put_text(const char* s, size_t len) {
+    if (format != EMIT_FORMAT_JSON) {
+        put(s, len);
+        return;
+    }
+    // Copy runs of characters that need no escaping in one go
+    const char* run = s;
+    const char* end = s + len;
+    for (; s != end; s++) {
+        unsigned char c = *s;
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        put(run, s - run);
+        run = s + 1;
+        put('\\');
+        switch (c) {
+            case '"':
+            case '\\':
+                put(c);
+                break;
+            case '\n':
+                put('n');
+                break;
+            case '\r':
+                put('r');
+                break;
+            case '\t':
+                put('t');
+                break;
+            default:
+                put("u00", 3);
+                put(HEX_DIGITS[c >> 4]);
+                put(HEX_DIGITS[c & 0xF]);
+                break;
+        }
+    }
+    put(run, end - run);
+}
+
+int value_buf_t::overflow(int c) {
+    if (c != EOF) {
+        char ch = c;
+        if (em.escape_values)
+            em.put_text(&ch, 1);
+        else
+            em.put(ch);
+    }
+    return c;
+}
+
+std::streamsize value_buf_t::xsputn(const char* s, std::streamsize n) {
+    if (em.escape_values)
+        em.put_text(s, n);
+    else
+        em.put(s, n);
+    return n;
+}
+
+} // namespace sqltoaster
@@ -0,0 +1,272 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOASTER_EMITTER_H
+#define SQLTOASTER_EMITTER_H
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <sqltoast/sqltoast.h>
+
+namespace sqltoaster {
+
+typedef enum emit_format {
+    EMIT_FORMAT_YAML,
+    EMIT_FORMAT_JSON
+} emit_format_t;
+
+// Bytes of output collected before they're written to the output stream
+const size_t EMIT_BUFFER_SIZE = 64 * 1024;
+
+struct emitter;
+
+// Feeds anything written to an emitter's value stream into the emitter, so
+// AST pieces printed with operator<< go straight into its buffer
+typedef struct value_buf : std::streambuf {
+    struct emitter& em;
+    value_buf(struct emitter& em) : em(em)
+    {}
+    int overflow(int c);
+    std::streamsize xsputn(const char* s, std::streamsize n);
+} value_buf_t;
+
+// Writes mappings, sequences and scalars as YAML or JSON as they're emitted,
+// without building any tree of nodes first. Output collects in a fixed
+// buffer that is written to the output stream whenever it fills up and when
+// the emitter is flushed or destroyed.
+//
+// The YAML is laid out the same as print_map() lays out a tree of nodes.
+// The JSON is compact, with every scalar a string.
+typedef struct emitter {
+    std::ostream& out;
+    emit_format_t format;
+    sqltoast::parse_position_t input;
+    char buf[EMIT_BUFFER_SIZE];
+    size_t buf_used;
+    // YAML: the indentation level of the mapping being emitted, and whether
+    // the next key is the first of a mapping that is an item of a sequence
+    size_t indent_level;
+    bool list_item;
+    // JSON: whether something has been emitted at the current level that the
+    // next key or item must be separated from
+    bool need_comma;
+    // Scalars printed with operator<< are written to value_out, which
+    // escapes them for JSON when escape_values is set
+    bool escape_values;
+    value_buf_t value_sbuf;
+    std::ostream value_out;
+    emitter(std::ostream& out, emit_format_t format, sqltoast::parse_position_t input) :
+        out(out),
+        format(format),
+        input(input),
+        buf_used(0),
+        indent_level(0),
+        list_item(false),
+        need_comma(false),
+        escape_values(false),
+        value_sbuf(*this),
+        value_out(&value_sbuf)
+    {
+        value_out << sqltoast::lexeme_input(input);
+    }
+    ~emitter() {
+        flush();
+    }
+    inline void flush() {
+        out.write(buf, buf_used);
+        buf_used = 0;
+    }
+    inline void put(char c) {
+        if (buf_used == EMIT_BUFFER_SIZE)
+            flush();
+        buf[buf_used++] = c;
+    }
+    inline void put(const char* s, size_t len) {
+        while (len > 0) {
+            if (buf_used == EMIT_BUFFER_SIZE)
+                flush();
+            size_t n = std::min(len, EMIT_BUFFER_SIZE - buf_used);
+            std::memcpy(buf + buf_used, s, n);
+            buf_used += n;
+            s += n;
+            len -= n;
+        }
+    }
+    inline void put(const char* s) {
+        put(s, std::strlen(s));
+    }
+    inline void put_spaces(size_t n) {
+        while (n-- > 0)
+            put(' ');
+    }
+    // Writes the characters of a key or scalar, escaped if they're part of
+    // a JSON string
+    void put_text(const char* s, size_t len);
+    inline void put_text(const char* s) {
+        put_text(s, std::strlen(s));
+    }
+    inline void put_text(const sqltoast::lexeme_t& lex) {
+        put_text(lex.start(input), lex.size());
+    }
+
+    // Starts an entry of the current mapping, up to where its value goes
+    template<typename K>
+    void key(const K& k) {
+        if (format == EMIT_FORMAT_JSON) {
+            if (need_comma)
+                put(',');
+            put('"');
+            put_text(k);
+            put("\":", 2);
+            return;
+        }
+        if (! list_item) {
+            if (indent_level > 0)
+                put('\n');
+            put_spaces(indent_level * 2);
+        } else {
+            put('\n');
+            put_spaces((indent_level - 1) * 2);
+            put("- ", 2);
+            list_item = false;
+        }
+        put_text(k);
+        put(':');
+    }
+    // Starts an item of the current sequence that is a scalar
+    inline void item() {
+        if (format == EMIT_FORMAT_JSON) {
+            if (need_comma)
+                put(',');
+            return;
+        }
+        put('\n');
+        put_spaces((indent_level + 1) * 2);
+        put("- ", 2);
+    }
+    inline void scalar_start() {
+        if (format == EMIT_FORMAT_JSON)
+            put('"');
+        else
+            put(' ');
+    }
+    inline void scalar_end() {
+        if (format == EMIT_FORMAT_JSON)
+            put('"');
+        need_comma = true;
+    }
+    // In YAML, scalar items of a sequence follow "- " with no extra space
+    inline void item_scalar_start() {
+        if (format == EMIT_FORMAT_JSON)
+            put('"');
+    }
+
+    // Emits a key and scalar value into the current mapping
+    template<typename K, typename V>
+    void attr(const K& k, const V& v) {
+        key(k);
+        scalar_start();
+        put_text(v);
+        scalar_end();
+    }
+    // Emits a key into the current mapping and returns the stream to print
+    // its scalar value to. end_value() must be called once it's printed.
+    template<typename K>
+    std::ostream& start_value(const K& k) {
+        key(k);
+        scalar_start();
+        escape_values = (format == EMIT_FORMAT_JSON);
+        return value_out;
+    }
+    inline void end_value() {
+        escape_values = false;
+        scalar_end();
+    }
+    template<typename K>
+    void start_map(const K& k) {
+        key(k);
+        if (format == EMIT_FORMAT_JSON) {
+            put('{');
+            need_comma = false;
+        } else {
+            indent_level++;
+        }
+    }
+    inline void end_map() {
+        if (format == EMIT_FORMAT_JSON) {
+            put('}');
+            need_comma = true;
+        } else {
+            indent_level--;
+        }
+    }
+    template<typename K>
+    void start_seq(const K& k) {
+        key(k);
+        if (format == EMIT_FORMAT_JSON) {
+            put('[');
+            need_comma = false;
+        }
+    }
+    inline void end_seq() {
+        if (format == EMIT_FORMAT_JSON) {
+            put(']');
+            need_comma = true;
+        }
+    }
+    // Starts an item of the current sequence that is a mapping
+    inline void start_item_map() {
+        if (format == EMIT_FORMAT_JSON) {
+            if (need_comma)
+                put(',');
+            put('{');
+            need_comma = false;
+        } else {
+            indent_level += 2;
+            list_item = true;
+        }
+    }
+    inline void end_item_map() {
+        if (format == EMIT_FORMAT_JSON) {
+            put('}');
+            need_comma = true;
+        } else {
+            indent_level -= 2;
+            list_item = false;
+        }
+    }
+    // Emits a scalar item into the current sequence
+    template<typename V>
+    void append(const V& v) {
+        item();
+        item_scalar_start();
+        put_text(v);
+        scalar_end();
+    }
+    // Starts a scalar item of the current sequence and returns the stream to
+    // print it to. end_value() must be called once it's printed.
+    inline std::ostream& start_item_value() {
+        item();
+        item_scalar_start();
+        escape_values = (format == EMIT_FORMAT_JSON);
+        return value_out;
+    }
+    // The whole output is a mapping, which in YAML has no delimiters
+    inline void start_document() {
+        if (format == EMIT_FORMAT_JSON)
+            put('{');
+    }
+    inline void end_document() {
+        if (format == EMIT_FORMAT_JSON)
+            put('}');
+    }
+} emitter_t;
+
+} // namespace sqltoaster
+
+#endif /* SQLTOASTER_EMITTER_H */
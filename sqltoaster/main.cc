@@ -4,10 +4,18 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include <iomanip>
 #include <iostream>
 
+#include <sqltoast/print.h>
 #include <sqltoast/sqltoast.h>
 
 #include "measure.h"
@@ -15,30 +23,148 @@
 
 struct parser {
     sqltoast::parse_options_t opts;
-    sqltoast::parse_input_t subject;
+    const char* subject;
+    size_t len;
+    // The subject is statements encoded by sqltoast::serialize() rather than
+    // SQL
+    bool serialized;
     sqltoast::parse_result_t res;
-    parser(sqltoast::parse_options_t& opts, const std::string &input) :
+    parser(
+            sqltoast::parse_options_t& opts,
+            const char* subject,
+            size_t len,
+            bool serialized) :
         opts(opts),
-        subject(input.cbegin(), input.cend())
+        subject(subject),
+        len(len),
+        serialized(serialized)
     {}
     void operator()() {
-        res = sqltoast::parse(subject, opts);
+        if (serialized)
+            res = sqltoast::deserialize(subject, len, opts);
+        else
+            res = sqltoast::parse(subject, len, opts);
     }
 };
 
+// A read-only memory mapping of an entire file. The parser reads SQL
+// straight out of the mapping, so even very large files are never copied
+// into the process' heap.
+struct mapped_file {
+    const char* data;
+    size_t len;
+    mapped_file() : data(nullptr), len(0)
+    {}
+    ~mapped_file() {
+        if (data != nullptr)
+            munmap(const_cast<char*>(data), len);
+    }
+    bool open(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd == -1) {
+            std::cerr << "Failed to open " << path << ": "
+                      << strerror(errno) << std::endl;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == -1) {
+            std::cerr << "Failed to stat " << path << ": "
+                      << strerror(errno) << std::endl;
+            close(fd);
+            return false;
+        }
+        len = st.st_size;
+        if (len == 0) {
+            // mmap() refuses zero-length mappings. There's nothing to map
+            // anyway, and the parser reports empty input itself.
+            close(fd);
+            return true;
+        }
+        void* addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            std::cerr << "Failed to map " << path << ": "
+                      << strerror(errno) << std::endl;
+            return false;
+        }
+        // The parser reads the file front to back, so let the kernel read
+        // ahead aggressively and drop pages behind us
+        madvise(addr, len, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(addr);
+        return true;
+    }
+};
+
+// Serialized statements are written and read as hex, so that they can be
+// given on the command line and kept in the grammar tests. Whitespace in
+// the hex is skipped.
+void write_hex(std::ostream& out, const std::string& data) {
+    const char* digits = "0123456789abcdef";
+    for (unsigned char c : data)
+        out << digits[c >> 4] << digits[c & 0xf];
+}
+
+int hex_digit(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+bool read_hex(const char* hex, size_t len, std::string& out) {
+    int high = -1;
+    for (size_t x = 0; x < len; x++) {
+        if (isspace(hex[x]))
+            continue;
+        int digit = hex_digit(hex[x]);
+        if (digit == -1)
+            return false;
+        if (high == -1) {
+            high = digit;
+            continue;
+        }
+        out.push_back(char(high << 4 | digit));
+        high = -1;
+    }
+    return high == -1;
+}
+
 void usage(const char* prg_name) {
     std::cout << "Usage: " << prg_name <<
-        " [--disable-timer] [--yaml] <SQL>" << std::endl;
+        " [--disable-timer] [--yaml | --json] [--pretokenize] [--arena] [--memoize] [--flat] [--sql] [--serialize | --deserialize] <SQL | --file PATH>" << std::endl;
     std::cout << " using libsqltoast version " <<
         SQLTOAST_VERSION_MAJOR << '.' <<
         SQLTOAST_VERSION_MINOR << std::endl;
 }
 
+// Prints how long parsing took along with parser throughput and the peak
+// memory used by the process
+void print_timing(std::ostream& out, uint64_t ns, size_t bytes, size_t statements) {
+    double secs = ns / 1e9;
+    out << std::fixed << std::setprecision(3)
+        << "(took " << ns / 1e6 << " ms, "
+        << std::setprecision(2) << (bytes / (1024.0 * 1024.0)) / secs << " MB/s, "
+        << std::setprecision(0) << statements / secs << " statements/s, "
+        << "peak RSS " << peak_rss_kb() << " KB)" << std::endl;
+}
+
 int main (int argc, char *argv[])
 {
     std::string input;
+    const char* file_path = nullptr;
     bool disable_timer = false;
     bool use_yaml = false;
+    bool use_json = false;
+    bool pretokenize = false;
+    bool use_arena = false;
+    bool memoize = false;
+    bool flat = false;
+    bool write_sql = false;
+    bool write_serialized = false;
+    bool read_serialized = false;
 
     for (int x = 1; x < argc; x++) {
         if (strcmp(argv[x], "--disable-timer") == 0) {
@@ -49,22 +175,99 @@ int main (int argc, char *argv[])
             use_yaml = true;
             continue;
         }
+        if (strcmp(argv[x], "--json") == 0) {
+            use_json = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--pretokenize") == 0) {
+            pretokenize = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--arena") == 0) {
+            use_arena = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--memoize") == 0) {
+            memoize = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--flat") == 0) {
+            flat = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--sql") == 0) {
+            write_sql = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--serialize") == 0) {
+            write_serialized = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--deserialize") == 0) {
+            read_serialized = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--file") == 0) {
+            if (++x == argc)
+                break;
+            file_path = argv[x];
+            break;
+        }
         input.assign(argv[x]);
         break;
     }
-    if (input.empty()) {
+    if (input.empty() && file_path == nullptr) {
         usage(argv[0]);
         return 1;
     }
 
-    sqltoast::parse_options_t opts = {sqltoast::SQL_DIALECT_ANSI_1992, false};
-    parser p(opts, input);
+    mapped_file mf;
+    const char* subject = input.data();
+    size_t len = input.size();
+    if (file_path != nullptr) {
+        if (! mf.open(file_path))
+            return 1;
+        subject = mf.data;
+        len = mf.len;
+    }
+    std::string serialized;
+    if (read_serialized) {
+        if (! read_hex(subject, len, serialized)) {
+            std::cerr << "Serialized statements must be given as hex." << std::endl;
+            return 1;
+        }
+        subject = serialized.data();
+        len = serialized.size();
+    }
+
+    sqltoast::parse_options_t opts = {
+        sqltoast::SQL_DIALECT_ANSI_1992,
+        false,
+        pretokenize,
+        use_arena,
+        memoize,
+        flat
+    };
+    parser p(opts, subject, len, read_serialized);
 
     auto dur = measure<std::chrono::nanoseconds>::execution(p);
     sqltoaster::printer ptr(p.res, std::cout);
     if (use_yaml)
         ptr.output_format = sqltoaster::OUTPUT_FORMAT_YAML;
-    if (p.res.code == sqltoast::PARSE_OK)
+    if (use_json)
+        ptr.output_format = sqltoaster::OUTPUT_FORMAT_JSON;
+    if (p.res.code == sqltoast::PARSE_OK && write_serialized) {
+        std::string out;
+        sqltoast::serialize(p.res, out);
+        write_hex(std::cout, out);
+        std::cout << std::endl;
+    } else if (p.res.code == sqltoast::PARSE_OK && write_sql) {
+        std::string out;
+        sqltoast::to_sql(p.res, out);
+        std::cout << out << std::endl;
+    } else if (p.res.code == sqltoast::PARSE_OK && flat)
+        std::cout << p.res.flat;
+    else if (p.res.code == sqltoast::PARSE_OK)
         std::cout << ptr << std::endl;
     else if (p.res.code == sqltoast::PARSE_INPUT_ERROR)
         std::cout << "Input error: " << p.res.error << std::endl;
@@ -73,6 +276,7 @@ int main (int argc, char *argv[])
         std::cout << p.res.error << std::endl;
     }
     if (! disable_timer)
-        std::cout << "(took " << dur << " nanoseconds)" << std::endl;
+        print_timing(std::cout, dur, len,
+                     p.res.statements.size() + p.res.flat.statements.size());
     return 0;
 }
@@ -8,6 +8,8 @@
 #ifndef SQLTOASTER_MEASURE_H
 #define SQLTOASTER_MEASURE_H
 
+#include <sys/resource.h>
+
 #include <chrono>
 
 template<typename TimeT = std::chrono::milliseconds>
@@ -24,4 +26,12 @@ struct measure
     }
 };
 
+// Returns the peak resident set size of the process so far, in kilobytes
+inline long peak_rss_kb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return usage.ru_maxrss;
+}
+
 #endif /* SQLTOASTER_MEASURE_H */
@@ -11,6 +11,8 @@
 
 namespace sqltoaster {
 
+sqltoast::parse_position_t fill_input = nullptr;
+
 void print_map(std::ostream& out, const mapping_t& mapping, size_t indent_level, bool is_list_item) {
     for (const std::unique_ptr<const mapping_value_t>& el : mapping.elements) {
         if (! is_list_item) {
@@ -8,6 +8,7 @@
 #define SQLTOASTER_NODE_H
 
 #include <string>
+#include <sstream>
 #include <vector>
 #include <map>
 #include <memory>
@@ -16,6 +17,17 @@
 
 namespace sqltoaster {
 
+// The input that the lexemes of the statements being filled into nodes are
+// offsets into. Set by the printer before it fills any nodes.
+extern sqltoast::parse_position_t fill_input;
+
+// A string stream that writes lexemes from the input being filled
+typedef struct value_stream : std::stringstream {
+    value_stream() {
+        *this << sqltoast::lexeme_input(fill_input);
+    }
+} value_stream_t;
+
 typedef enum node_type {
     SCALAR,
     SEQUENCE,
@@ -45,7 +57,7 @@ typedef struct scalar : node_t {
     {}
     scalar(const sqltoast::lexeme_t& val) :
         node_t(SCALAR),
-        value(std::string(val.start, val.end))
+        value(val.str(fill_input))
     {}
     inline void assign(const char *val) {
         value.assign(std::string(val));
@@ -100,13 +112,13 @@ typedef struct mapping : node_t {
         setattr(key, val);
     }
     inline void setattr(const char *key, const sqltoast::lexeme_t& value) {
-        setattr(key, std::string(value.start, value.end).c_str());
+        setattr(key, value.str(fill_input).c_str());
     }
     inline void setattr(const char *key, const std::string& value) {
         setattr(key, value.c_str());
     }
     inline void setattr(const sqltoast::lexeme_t& key, const std::string& value) {
-        setattr(std::string(key.start, key.end).c_str(), value);
+        setattr(key.str(fill_input).c_str(), value);
     }
 } mapping_t;
 
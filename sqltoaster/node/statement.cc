@@ -166,7 +166,7 @@ void fill(mapping_t& node, const sqltoast::create_table_statement_t& stmt) {
             cdef_it != stmt.column_definitions.cend();
             cdef_it++) {
         const sqltoast::column_definition_t& cdef = *(*cdef_it);
-        std::stringstream val;
+        value_stream_t val;
         if (cdef.data_type.get()) {
             val << *cdef.data_type;
         } else {
@@ -178,9 +178,10 @@ void fill(mapping_t& node, const sqltoast::create_table_statement_t& stmt) {
         for (const std::unique_ptr<sqltoast::constraint_t>& c: cdef.constraints)
             val << *c;
         if (cdef.collate) {
-            val << " COLLATE " << cdef.collate;
+            val << " COLLATE "
+                << sqltoast::lexeme_text(cdef.collate, fill_input);
         }
-        cdefs_map.setattr(std::string(cdef.name.start, cdef.name.end).c_str(), val.str());
+        cdefs_map.setattr(cdef.name.str(fill_input).c_str(), val.str());
     }
     node.setattr("column_definitions", cdefs_node);
     if (stmt.constraints.size() > 0) {
@@ -189,7 +190,7 @@ void fill(mapping_t& node, const sqltoast::create_table_statement_t& stmt) {
         for (auto constraint_it = stmt.constraints.begin();
              constraint_it != stmt.constraints.end();
              constraint_it++) {
-            std::stringstream val;
+            value_stream_t val;
             val << *(*constraint_it);
             constrs_seq.append(val.str());
         }
@@ -207,7 +208,7 @@ void fill(mapping_t& node, const sqltoast::drop_table_statement_t& stmt) {
 
 void fill(mapping_t& node, const sqltoast::alter_table_statement_t& stmt) {
     node.setattr("table_name", stmt.table_name);
-    std::stringstream val;
+    value_stream_t val;
     val << *stmt.action;
     node.setattr("action", val.str());
 }
@@ -279,7 +280,7 @@ void fill(mapping_t& node, const sqltoast::table_expression_t& table_exp) {
         std::unique_ptr<node_t> gcr_node = std::make_unique<sequence_t>();
         sequence_t& gcr_seq = static_cast<sequence_t&>(*gcr_node);
         for (const sqltoast::grouping_column_reference_t& gcr : table_exp.group_by_columns) {
-            std::stringstream val;
+            value_stream_t val;
             val << gcr;
             gcr_seq.append(val.str());
         }
@@ -521,7 +522,7 @@ void fill(mapping_t& node, const sqltoast::update_statement_t& stmt) {
         else if (set_col.type == sqltoast::SET_COLUMN_TYPE_DEFAULT)
             cols_map.setattr(set_col.column_name, "DEFAULT");
         else {
-            std::stringstream val;
+            value_stream_t val;
             val << *set_col.value;
             cols_map.setattr(set_col.column_name, val.str());
         }
@@ -537,7 +538,7 @@ void fill(mapping_t& node, const sqltoast::update_statement_t& stmt) {
 }
 
 void fill(mapping_t& node, const sqltoast::grant_statement_t& stmt) {
-    std::stringstream val;
+    value_stream_t val;
     switch (stmt.object_type) {
         case sqltoast::GRANT_OBJECT_TYPE_TABLE:
             break;
@@ -554,7 +555,7 @@ void fill(mapping_t& node, const sqltoast::grant_statement_t& stmt) {
             val << "TRANSLATION ";
             break;
     }
-    val << stmt.on;
+    val << sqltoast::lexeme_text(stmt.on, fill_input);
     node.setattr("on", val.str());
     if (stmt.to_public())
         node.setattr("to", "PUBLIC");
@@ -1042,8 +1043,8 @@ void fill(mapping_t& node, const sqltoast::numeric_term_t& term) {
 
 void fill(mapping_t& node, const sqltoast::numeric_factor_t& factor) {
     if (factor.sign != 0) {
-        std::stringstream val;
-        val << factor.sign;
+        value_stream_t val;
+        val << (factor.sign < 0 ? '-' : '+');
         node.setattr("sign", val.str());
     }
     std::unique_ptr<node_t> primary_node = std::make_unique<mapping_t>();
@@ -1061,7 +1062,7 @@ void fill(mapping_t& node, const sqltoast::numeric_primary_t& primary) {
                 mapping_t& value_map = static_cast<mapping_t&>(*value_node);
                 const sqltoast::numeric_value_t& sub =
                     static_cast<const sqltoast::numeric_value_t&>(primary);
-                std::stringstream val;
+                value_stream_t val;
                 fill(value_map, sub);
                 node.setattr("value", value_node);
             }
@@ -1088,7 +1089,7 @@ void fill(mapping_t& node, const sqltoast::numeric_value_t& value) {
 }
 
 void fill(mapping_t& node, const sqltoast::value_expression_primary_t& primary) {
-    std::stringstream val;
+    value_stream_t val;
     switch (primary.vep_type) {
         case sqltoast::VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION:
             node.setattr("type", "UNSIGNED_VALUE_SPECIFICATION");
@@ -1101,7 +1102,7 @@ void fill(mapping_t& node, const sqltoast::value_expression_primary_t& primary)
             break;
         case sqltoast::VEP_TYPE_COLUMN_REFERENCE:
             node.setattr("type", "COLUMN_REFERENCE");
-            val << primary.lexeme;
+            val << sqltoast::lexeme_text(primary.lexeme, fill_input);
             node.setattr("column_reference", val.str());
             break;
         case sqltoast::VEP_TYPE_SET_FUNCTION_SPECIFICATION:
@@ -1191,7 +1192,7 @@ void fill(mapping_t& node, const sqltoast::parenthesized_value_expression_t& exp
 }
 
 void fill(mapping_t& node, const sqltoast::case_expression_t& expr) {
-    std::stringstream val;
+    value_stream_t val;
     switch (expr.case_type) {
         case sqltoast::CASE_EXPRESSION_TYPE_COALESCE_FUNCTION:
             node.setattr("type", "COALESCE_FUNCTION");
@@ -1403,7 +1404,7 @@ void fill(mapping_t& node, const sqltoast::position_expression_t& expr) {
 }
 
 void fill(mapping_t& node, const sqltoast::extract_expression_t& expr) {
-    std::stringstream val;
+    value_stream_t val;
     val << expr.extract_field;
     node.setattr("field", val.str());
     std::unique_ptr<node_t> source_node = std::make_unique<mapping_t>();
@@ -1600,7 +1601,7 @@ void fill(mapping_t& node, const sqltoast::datetime_factor_t& factor) {
 }
 
 void fill(mapping_t& node, const sqltoast::datetime_primary_t& primary) {
-    std::stringstream val;
+    value_stream_t val;
     switch (primary.type) {
         case sqltoast::DATETIME_PRIMARY_TYPE_VALUE:
             node.setattr("type", "VALUE");
@@ -1633,7 +1634,7 @@ void fill(mapping_t& node, const sqltoast::datetime_value_t& value) {
 }
 
 void fill(mapping_t& node, const sqltoast::datetime_field_t& field) {
-    std::stringstream val;
+    value_stream_t val;
     val << field.interval;
     node.setattr("interval", val.str());
     if (field.interval != sqltoast::INTERVAL_UNIT_SECOND) {
@@ -1695,8 +1696,8 @@ void fill(mapping_t& node, const sqltoast::interval_term_t& term) {
 
 void fill(mapping_t& node, const sqltoast::interval_factor_t& factor) {
     if (factor.sign != 0) {
-        std::stringstream val;
-        val << factor.sign;
+        value_stream_t val;
+        val << (factor.sign < 0 ? '-' : '+');
         node.setattr("sign", val.str());
     }
     std::unique_ptr<node_t> primary_node = std::make_unique<mapping_t>();
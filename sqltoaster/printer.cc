@@ -6,6 +6,8 @@
 
 #include <sqltoast/print.h>
 
+#include "emit.h"
+#include "emitter.h"
 #include "node.h"
 #include "fill.h"
 #include "printer.h"
@@ -14,6 +16,7 @@ namespace sqltoaster {
 
 std::ostream& operator<< (std::ostream& out, printer_t& ptr) {
     if (ptr.output_format == OUTPUT_FORMAT_DEFAULT) {
+        out << sqltoast::lexeme_input(ptr.res.input);
         unsigned int x = 0;
         for (auto stmt_ptr_it = ptr.res.statements.cbegin();
                 stmt_ptr_it != ptr.res.statements.cend();
@@ -22,17 +25,17 @@ std::ostream& operator<< (std::ostream& out, printer_t& ptr) {
             out << "  " << *(*stmt_ptr_it);
         }
     } else {
-        ptr.process_statements();
-        if (ptr.statement_node_count()) {
-            mapping_t statements;
-            statements.setattr("statements", ptr.statements);
-            print_map(out, statements, 0, false);
-        }
+        emit_format_t format = EMIT_FORMAT_YAML;
+        if (ptr.output_format == OUTPUT_FORMAT_JSON)
+            format = EMIT_FORMAT_JSON;
+        emitter_t em(out, format, ptr.res.input);
+        emit(em, ptr.res);
     }
     return out;
 }
 
 void printer_t::process_statements() {
+    fill_input = res.input;
     std::unique_ptr<node_t> statement_node;
     for (std::unique_ptr<sqltoast::statement_t>& stmt : res.statements) {
         std::unique_ptr<node_t> statement_node = std::make_unique<mapping_t>();
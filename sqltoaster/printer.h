@@ -17,7 +17,8 @@ namespace sqltoaster {
 
 typedef enum output_format {
     OUTPUT_FORMAT_DEFAULT,
-    OUTPUT_FORMAT_YAML
+    OUTPUT_FORMAT_YAML,
+    OUTPUT_FORMAT_JSON
 } output_format_t;
 
 typedef struct printer {
@@ -65,6 +66,8 @@ typedef struct printer {
         sequence_t& stmt_seq = static_cast<sequence_t&>(*statements);
         return stmt_seq.elements.size();
     }
+    // Fills the tree of nodes for the statements. YAML and JSON are written
+    // without one by the emitter, so this is only used to compare the two.
     void process_statements();
 } printer_t;
 
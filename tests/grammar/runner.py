@@ -13,6 +13,7 @@ RESULT_TEST_ERROR = 1
 RESULT_TEST_FAILURE = 1
 SQLTOASTER_BINARY = os.path.join(TEST_DIR, '..', '..', '_build', 'sqltoaster',
                                  'sqltoaster')
+HEX_RE = re.compile(r'^[0-9a-f]+$')
 
 
 def parse_options():
@@ -67,25 +68,77 @@ def get_test_names(args):
     return sorted(test_names)
 
 
+def run_sqltoaster(args, subject):
+    cmd_args = [SQLTOASTER_BINARY, '--disable-timer']
+    cmd_args += args
+    cmd_args.append(subject)
+    return subprocess.check_output(cmd_args).splitlines()
+
+
+def round_trip(args, input_sql):
+    """Returns the output for the supplied SQL once its statements have been
+    serialized and loaded again, or None if the SQL doesn't parse. Raises
+    ValueError if parsing straight into a flat AST gives a different
+    encoding."""
+    encoded = run_sqltoaster(args + ['--serialize'], input_sql)
+    if len(encoded) != 1 or not HEX_RE.match(encoded[0]):
+        return None
+    if '--flat' not in args:
+        flat_encoded = run_sqltoaster(args + ['--flat', '--serialize'],
+                                      input_sql)
+        if flat_encoded != encoded:
+            raise ValueError("serializing a flat AST gives a different "
+                             "encoding")
+    return run_sqltoaster(args + ['--deserialize'], encoded[0])
+
+
+def failure_message(testno, input_sql, expected, actual, what=None):
+    msg = "Test #%d" % testno
+    if what:
+        msg += " (%s)" % what
+    msg += "\n---------------------------------------------\n"
+    msg += "Input SQL:\n"
+    msg += input_sql
+    msg += "\n---------------------------------------------\n"
+    msg += "expected != actual\n"
+    diffs = difflib.ndiff(expected, actual)
+    diffs = [d.strip("\n") for d in diffs]
+    msg += "\n".join(diffs)
+    return msg
+
+
 def run_test(test_name):
     test_path = os.path.join(TEST_DIR, test_name + ".test")
     input_blocks = []
+    input_args = []
     output_blocks = []
     input_block = []
     output_block = []
+    # A "#!" line gives the sqltoaster output options used for the tests that
+    # follow it in the file, in place of --yaml
+    args = ['--yaml']
     with open(test_path, 'rb') as tfile:
-        line = tfile.readline().rstrip("\n")
+        # Only the end of the file ends the tests, so that expected output
+        # may contain blank lines
+        line = tfile.readline()
         while True:
             if not line:
                 break;
+            line = line.rstrip("\n")
+            if line.startswith("#!"):
+                args = line[2:].split()
+                line = tfile.readline()
+                continue
             if line.startswith("#"):
-                line = tfile.readline().rstrip("\n")
+                line = tfile.readline()
                 continue
             if line.startswith('>'):
                 # Clear out previous output block...
                 if output_block:
                     output_blocks.append(output_block)
                     output_block = []
+                if not input_block:
+                    input_args.append(args)
                 input_block.append(line[1:])
             else:
                 # Clear out previous input block...
@@ -93,7 +146,7 @@ def run_test(test_name):
                     input_blocks.append(input_block)
                     input_block = []
                 output_block.append(line)
-            line = tfile.readline().rstrip("\n")
+            line = tfile.readline()
     if output_block:
         output_blocks.append(output_block)
 
@@ -105,26 +158,55 @@ def run_test(test_name):
     for testno, iblock in enumerate(input_blocks):
         expected = output_blocks[testno]
         input_sql = "\n".join(iblock)
-        cmd_args = [SQLTOASTER_BINARY, '--disable-timer', '--yaml', input_sql]
+        args = input_args[testno]
         try:
-            actual = subprocess.check_output(cmd_args)
+            actual = run_sqltoaster(args, input_sql)
         except subprocess.CalledProcessError as err:
             msg = ("Failed to execute test number %d inside %s. Got: %s")
             msg = msg % (testno, test_name, err)
             return RESULT_TEST_ERROR, msg
 
-        actual = actual.splitlines()
+        if actual != expected:
+            msg = failure_message(testno, input_sql, expected, actual)
+            return RESULT_TEST_FAILURE, msg
 
+        # Statements loaded from their serialized form must print the same
+        # as the parsed ones
+        if '--serialize' in args or '--deserialize' in args:
+            continue
+        try:
+            actual = round_trip(args, input_sql)
+        except subprocess.CalledProcessError as err:
+            msg = ("Failed to execute round trip of test number %d inside "
+                   "%s. Got: %s")
+            msg = msg % (testno, test_name, err)
+            return RESULT_TEST_ERROR, msg
+        except ValueError as err:
+            msg = "Test #%d (round trip through serialize()): %s"
+            msg = msg % (testno, err)
+            return RESULT_TEST_FAILURE, msg
+        if actual is None:
+            continue
+        if actual != expected:
+            msg = failure_message(testno, input_sql, expected, actual,
+                                  "round trip through serialize()")
+            return RESULT_TEST_FAILURE, msg
+
+        # As must the statements parsed from the SQL to_sql() writes for
+        # them. The flat AST isn't written out as SQL.
+        if '--flat' in args:
+            continue
+        try:
+            sql = "\n".join(run_sqltoaster(['--sql'], input_sql))
+            actual = run_sqltoaster(args, sql)
+        except subprocess.CalledProcessError as err:
+            msg = ("Failed to execute SQL round trip of test number %d "
+                   "inside %s. Got: %s")
+            msg = msg % (testno, test_name, err)
+            return RESULT_TEST_ERROR, msg
         if actual != expected:
-            msg = "Test #%d\n" % testno
-            msg += "---------------------------------------------\n"
-            msg += "Input SQL:\n"
-            msg += input_sql
-            msg += "\n---------------------------------------------\n"
-            msg += "expected != actual\n"
-            diffs = difflib.ndiff(expected, actual)
-            diffs = [d.strip("\n") for d in diffs]
-            msg += "\n".join(diffs)
+            msg = failure_message(testno, sql, expected, actual,
+                                  "round trip through to_sql()")
             return RESULT_TEST_FAILURE, msg
 
     return RESULT_OK, None